@@ -0,0 +1,57 @@
+#pragma once
+
+#include "benchmark/benchmark.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace BenchmarkTypes
+{
+	// A trivially copyable element of the given size, standing in for user structs.
+	template<size_t Bytes>
+	struct Payload {
+		std::array<unsigned char, Bytes> bytes{};
+	};
+
+	using Bytes16 = Payload<16>;
+	using Bytes64 = Payload<64>;
+	using Bytes256 = Payload<256>;
+
+	template<typename T>
+	T make_value(const int64_t i)
+	{
+		if constexpr (std::is_arithmetic_v<T>)
+		{
+			return static_cast<T>(i);
+		}
+		else
+		{
+			T value;
+			value.bytes[0] = static_cast<unsigned char>(i);
+			return value;
+		}
+	}
+
+	// Reads one byte worth of each element, so iterating benchmarks cannot be optimized away.
+	template<typename T>
+	int64_t touch(const T& value)
+	{
+		if constexpr (std::is_arithmetic_v<T>)
+			return static_cast<int64_t>(value);
+		else
+			return value.bytes[0];
+	}
+
+	// Element counts from 8 to 10^7. Larger types stop early so that one container stays below 256 MiB.
+	template<typename T>
+	void element_counts(benchmark::internal::Benchmark* b)
+	{
+		constexpr int64_t max_bytes = int64_t{ 256 } << 20;
+
+		for (const int64_t n : { 8, 64, 512, 4096, 32768, 262144, 2097152, 10000000 })
+			if (n * static_cast<int64_t>(sizeof(T)) <= max_bytes)
+				b->Arg(n);
+	}
+}// namespace BenchmarkTypes
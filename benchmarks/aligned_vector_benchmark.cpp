@@ -0,0 +1,61 @@
+#include "../src/AlignedAllocator.h"
+#include "../src/Vector.h"
+#include "BenchmarkTypes.h"
+
+#include <numeric>
+
+namespace AlignedVectorBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	// Sums a vector of floats; the aligned vector starts on a cache line, so vector loads never split one.
+	template<typename Vector>
+	void BM_sum(benchmark::State& state)
+	{
+		Vector vec;
+		vec.resize(static_cast<size_t>(state.range(0)), 1.0f);
+
+		for (auto _ : state)
+		{
+			float sum = 0;
+			for (const auto value : vec)
+				sum += value;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(float)));
+	}
+
+	// Follows a random cycle through a vector of several hundred MiB, where almost every step is a TLB miss
+	// with 4 KiB pages.
+	template<typename Vector>
+	void BM_random_walk(benchmark::State& state)
+	{
+		const auto n = static_cast<size_t>(state.range(0));
+
+		Vector next;
+		next.resize(n, 0);
+		for (size_t i = 0; i < n; ++i)
+			next[i] = (i * 2654435761u + 12345) % n;
+
+		for (auto _ : state)
+		{
+			uint64_t at = 0;
+			for (size_t i = 0; i < (1 << 20); ++i)
+				at = next[(at + i) % n];
+
+			benchmark::DoNotOptimize(at);
+		}
+
+		state.SetItemsProcessed(state.iterations() * (1 << 20));
+	}
+
+	BENCHMARK(BM_sum<cpp::Vector<float>>)->Arg(1000)->Arg(1 << 16)->Arg(1 << 22);
+	BENCHMARK(BM_sum<cpp::AlignedVector<float>>)->Arg(1000)->Arg(1 << 16)->Arg(1 << 22);
+
+	BENCHMARK(BM_random_walk<cpp::Vector<uint64_t>>)->Arg(1 << 25);
+	BENCHMARK(BM_random_walk<cpp::HugePageVector<uint64_t>>)->Arg(1 << 25);
+}// namespace AlignedVectorBenchmarks
+
+BENCHMARK_MAIN();
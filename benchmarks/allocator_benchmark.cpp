@@ -0,0 +1,89 @@
+#include "../src/String.h"
+#include "../src/Vector.h"
+#include "benchmark/benchmark.h"
+
+#include <cstdlib>
+#include <new>
+
+// Every call of the global operator new is counted, so the benchmarks can report how many
+// heap allocations one simulated request performs on each path.
+static size_t g_allocations = 0;
+
+void* operator new(const size_t size)
+{
+	++g_allocations;
+	if (auto p = std::malloc(size))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace AllocatorBenchmarks
+{
+	constexpr const char* header_value = "a header value long enough to need the heap";
+
+	// Builds the containers of one request: a list of header strings and a list of ids.
+	template<typename StringVector, typename IntVector>
+	void fill_request(StringVector& headers, IntVector& ids, const int64_t count)
+	{
+		for (int64_t i = 0; i < count; ++i)
+		{
+			headers.emplace_back(header_value);
+			ids.push_back(static_cast<int>(i));
+		}
+
+		benchmark::DoNotOptimize(headers.data());
+		benchmark::DoNotOptimize(ids.data());
+	}
+
+	void report_allocations(benchmark::State& state, const size_t allocations)
+	{
+		state.counters["allocs_per_request"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+	}
+
+	void BM_request_global_heap(benchmark::State& state)
+	{
+		const auto allocations = g_allocations;
+
+		for (auto _ : state)
+		{
+			cpp::Vector<cpp::String> headers;
+			cpp::Vector<int> ids;
+			fill_request(headers, ids, state.range(0));
+		}
+
+		report_allocations(state, g_allocations - allocations);
+	}
+	BENCHMARK(BM_request_global_heap)->Arg(8)->Arg(64)->Arg(512);
+
+	void BM_request_monotonic_arena(benchmark::State& state)
+	{
+		// The same buffer backs every request; the arena only asks the heap for more once it is exhausted.
+		static std::byte buffer[64 * 1024];
+		const auto allocations = g_allocations;
+
+		for (auto _ : state)
+		{
+			std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+
+			cpp::pmr::Vector<cpp::pmr::String> headers(&arena);
+			cpp::pmr::Vector<int> ids(&arena);
+			fill_request(headers, ids, state.range(0));
+		}
+
+		report_allocations(state, g_allocations - allocations);
+	}
+	BENCHMARK(BM_request_monotonic_arena)->Arg(8)->Arg(64)->Arg(512);
+}// namespace AllocatorBenchmarks
+
+BENCHMARK_MAIN();
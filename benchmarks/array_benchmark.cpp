@@ -0,0 +1,68 @@
+#include "../src/Array.h"
+#include "BenchmarkTypes.h"
+
+#include <array>
+#include <memory>
+
+namespace ArrayBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	// The arrays are heap-allocated because the large ones do not fit onto the stack.
+	template<typename Container>
+	void BM_fill(benchmark::State& state)
+	{
+		using T = typename Container::value_type;
+		const auto c = std::make_unique<Container>();
+		const auto value = make_value<T>(42);
+
+		for (auto _ : state)
+		{
+			c->fill(value);
+			benchmark::DoNotOptimize(c->data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sizeof(Container)));
+	}
+
+	template<typename Container>
+	void BM_iterate(benchmark::State& state)
+	{
+		using T = typename Container::value_type;
+		const auto c = std::make_unique<Container>();
+		c->fill(make_value<T>(1));
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (const auto& value : *c)
+				sum += touch(value);
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(c->size()));
+	}
+
+// Registers one benchmark for std::array<T, N> and cpp::Array<T, N> next to each other.
+#define ARRAY_BENCHMARK(name, T, N)          \
+	BENCHMARK(name<std::array<T, N>>); \
+	BENCHMARK(name<cpp::Array<T, N>>)
+
+#define ARRAY_BENCHMARKS(T, N)         \
+	ARRAY_BENCHMARK(BM_fill, T, N); \
+	ARRAY_BENCHMARK(BM_iterate, T, N)
+
+	ARRAY_BENCHMARKS(int, 8);
+	ARRAY_BENCHMARKS(int, 4096);
+	ARRAY_BENCHMARKS(int, 262144);
+	ARRAY_BENCHMARKS(int, 10000000);
+	ARRAY_BENCHMARKS(Bytes16, 8);
+	ARRAY_BENCHMARKS(Bytes16, 262144);
+	ARRAY_BENCHMARKS(Bytes64, 8);
+	ARRAY_BENCHMARKS(Bytes64, 262144);
+	ARRAY_BENCHMARKS(Bytes256, 8);
+	ARRAY_BENCHMARKS(Bytes256, 262144);
+}// namespace ArrayBenchmarks
+
+BENCHMARK_MAIN();
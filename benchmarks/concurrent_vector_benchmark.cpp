@@ -0,0 +1,58 @@
+#include "../src/ConcurrentVector.h"
+#include "../src/Vector.h"
+#include "BenchmarkTypes.h"
+
+#include <mutex>
+#include <thread>
+
+namespace ConcurrentVectorBenchmarks
+{
+	// state.range(0) threads append 2^20 elements in total to one shared container.
+	constexpr int64_t element_count = 1 << 20;
+
+	// The container ConcurrentVector replaces: a Vector behind a mutex.
+	class LockedVector
+	{
+	public:
+		void push_back(const int64_t value)
+		{
+			std::lock_guard lock(m_mutex);
+			m_items.push_back(value);
+		}
+
+	private:
+		std::mutex m_mutex;
+		cpp::Vector<int64_t> m_items;
+	};
+
+	template<typename Container>
+	void BM_concurrent_push_back(benchmark::State& state)
+	{
+		const auto threads = state.range(0);
+
+		for (auto _ : state)
+		{
+			Container container;
+			cpp::Vector<std::thread> writers;
+
+			for (int64_t t = 0; t < threads; ++t)
+			{
+				writers.emplace_back([&container, threads, t] {
+					for (int64_t i = t; i < element_count; i += threads)
+						container.push_back(i);
+				});
+			}
+
+			for (auto& writer : writers)
+				writer.join();
+
+			benchmark::DoNotOptimize(&container);
+		}
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_concurrent_push_back<LockedVector>)->Arg(1)->Arg(4)->UseRealTime();
+	BENCHMARK(BM_concurrent_push_back<cpp::ConcurrentVector<int64_t>>)->Arg(1)->Arg(4)->UseRealTime();
+}// namespace ConcurrentVectorBenchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,189 @@
+#include "../src/FlatHashMap.h"
+#include "BenchmarkTypes.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace FlatHashMapBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	using StdStringMap = std::unordered_map<std::string, int>;
+	using FlatStringMap = cpp::FlatHashMap<cpp::String, int>;
+	using StdIntMap = std::unordered_map<int, int>;
+	using FlatIntMap = cpp::FlatHashMap<int, int>;
+
+	// The i-th key: identifiers like "field_1234", short enough for the inline storage of both string types,
+	// or i scrambled for integer keys.
+	template<typename Key>
+	Key make_key(const int64_t i)
+	{
+		if constexpr (std::is_same_v<Key, int>)
+		{
+			return static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+		}
+		else
+		{
+			const auto text = "field_" + std::to_string(i);
+			return Key(text.c_str());
+		}
+	}
+
+	template<typename Map>
+	std::vector<typename Map::key_type> make_keys(const int64_t first, const int64_t n)
+	{
+		std::vector<typename Map::key_type> keys;
+		keys.reserve(static_cast<size_t>(n));
+		for (int64_t i = first; i < first + n; ++i)
+			keys.push_back(make_key<typename Map::key_type>(i));
+
+		return keys;
+	}
+
+	template<typename Map>
+	Map make_map(const std::vector<typename Map::key_type>& keys)
+	{
+		Map map;
+		for (size_t i = 0; i < keys.size(); ++i)
+			map[keys[i]] = static_cast<int>(i);
+
+		return map;
+	}
+
+	template<typename Map>
+	void BM_insert(benchmark::State& state)
+	{
+		const auto keys = make_keys<Map>(0, state.range(0));
+
+		for (auto _ : state)
+		{
+			Map map;
+			for (size_t i = 0; i < keys.size(); ++i)
+				map.try_emplace(keys[i], static_cast<int>(i));
+
+			benchmark::DoNotOptimize(map.size());
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Map>
+	void BM_insert_reserved(benchmark::State& state)
+	{
+		const auto keys = make_keys<Map>(0, state.range(0));
+
+		for (auto _ : state)
+		{
+			Map map;
+			map.reserve(keys.size());
+			for (size_t i = 0; i < keys.size(); ++i)
+				map.try_emplace(keys[i], static_cast<int>(i));
+
+			benchmark::DoNotOptimize(map.size());
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Map>
+	void BM_find_hit(benchmark::State& state)
+	{
+		const auto keys = make_keys<Map>(0, state.range(0));
+		const auto map = make_map<Map>(keys);
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (const auto& key : keys)
+				sum += map.find(key)->second;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Map>
+	void BM_find_miss(benchmark::State& state)
+	{
+		const auto n = state.range(0);
+		const auto map = make_map<Map>(make_keys<Map>(0, n));
+		const auto missing = make_keys<Map>(n, n);
+
+		for (auto _ : state)
+		{
+			int64_t found = 0;
+			for (const auto& key : missing)
+				found += map.find(key) != map.end();
+
+			benchmark::DoNotOptimize(found);
+		}
+
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	// Looks up keys given as C-strings, as when parsing text. std::unordered_map<std::string, ...> has to
+	// build a std::string for each lookup; FlatHashMap hashes and compares the characters in place.
+	template<typename Map>
+	void BM_find_c_string(benchmark::State& state)
+	{
+		const auto text = make_keys<std::unordered_map<std::string, int>>(0, state.range(0));
+		const auto map = make_map<Map>(make_keys<Map>(0, state.range(0)));
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (const auto& key : text)
+				sum += map.find(key.c_str())->second;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Map>
+	void BM_erase_insert(benchmark::State& state)
+	{
+		const auto keys = make_keys<Map>(0, state.range(0));
+		auto map = make_map<Map>(keys);
+
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < keys.size(); i += 2)
+				map.erase(keys[i]);
+
+			for (size_t i = 0; i < keys.size(); i += 2)
+				map.try_emplace(keys[i], static_cast<int>(i));
+
+			benchmark::DoNotOptimize(map.size());
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void key_counts(benchmark::internal::Benchmark* b)
+	{
+		for (const int64_t n : { 64, 4096, 262144, 2097152 })
+			b->Arg(n);
+	}
+
+// Registers one benchmark for a std::unordered_map and a FlatHashMap with the same key type next to each other.
+#define MAP_BENCHMARK(name, StdMap, FlatMap)       \
+	BENCHMARK(name<StdMap>)->Apply(key_counts); \
+	BENCHMARK(name<FlatMap>)->Apply(key_counts)
+
+#define MAP_BENCHMARKS(StdMap, FlatMap)                   \
+	MAP_BENCHMARK(BM_insert, StdMap, FlatMap);            \
+	MAP_BENCHMARK(BM_insert_reserved, StdMap, FlatMap);   \
+	MAP_BENCHMARK(BM_find_hit, StdMap, FlatMap);          \
+	MAP_BENCHMARK(BM_find_miss, StdMap, FlatMap);         \
+	MAP_BENCHMARK(BM_erase_insert, StdMap, FlatMap)
+
+	MAP_BENCHMARKS(StdStringMap, FlatStringMap);
+	MAP_BENCHMARK(BM_find_c_string, StdStringMap, FlatStringMap);
+	MAP_BENCHMARKS(StdIntMap, FlatIntMap);
+}// namespace FlatHashMapBenchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,58 @@
+#include "../src/MallocAllocator.h"
+#include "../src/Vector.h"
+#include "BenchmarkTypes.h"
+
+namespace GrowthPolicyBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	template<typename T>
+	using Doubling = cpp::Vector<T>;
+
+	template<typename T>
+	using OneAndHalf = cpp::Vector<T, std::allocator<T>, cpp::growth::OneAndHalf>;
+
+	// Grows with realloc, since the elements are trivially relocatable.
+	template<typename T>
+	using Realloc = cpp::Vector<T, cpp::MallocAllocator<T>>;
+
+	template<typename T>
+	using ReallocSizeClass = cpp::Vector<T, cpp::MallocAllocator<T>, cpp::growth::SizeClass<>>;
+
+	template<typename T>
+	using ReallocOneAndHalf = cpp::Vector<T, cpp::MallocAllocator<T>, cpp::growth::SizeClass<cpp::growth::OneAndHalf>>;
+
+	// Appends n elements to an empty vector, reporting the capacity it ends with relative to n.
+	template<typename Vector>
+	void BM_push_back(benchmark::State& state)
+	{
+		using T = typename Vector::value_type;
+		size_t capacity = 0;
+
+		for (auto _ : state)
+		{
+			Vector vec;
+			for (int64_t i = 0; i < state.range(0); ++i)
+				vec.push_back(make_value<T>(i));
+
+			capacity = vec.capacity();
+			benchmark::DoNotOptimize(vec.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.counters["capacity/size"] = static_cast<double>(capacity) / static_cast<double>(state.range(0));
+	}
+
+// Registers one benchmark for every growth policy of cpp::Vector<T> next to each other.
+#define GROWTH_POLICY_BENCHMARKS(T)                                             \
+	BENCHMARK(BM_push_back<Doubling<T>>)->Apply(element_counts<T>);         \
+	BENCHMARK(BM_push_back<OneAndHalf<T>>)->Apply(element_counts<T>);       \
+	BENCHMARK(BM_push_back<Realloc<T>>)->Apply(element_counts<T>);          \
+	BENCHMARK(BM_push_back<ReallocSizeClass<T>>)->Apply(element_counts<T>); \
+	BENCHMARK(BM_push_back<ReallocOneAndHalf<T>>)->Apply(element_counts<T>)
+
+	GROWTH_POLICY_BENCHMARKS(int);
+	GROWTH_POLICY_BENCHMARKS(Bytes64);
+}// namespace GrowthPolicyBenchmarks
+
+BENCHMARK_MAIN();
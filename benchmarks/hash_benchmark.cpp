@@ -0,0 +1,116 @@
+#include "../src/FlatHashMap.h"
+#include "../src/HashedString.h"
+#include "BenchmarkTypes.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HashBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	// n pseudo-random lowercase letters.
+	std::string make_text(const int64_t n, uint32_t state = 12345)
+	{
+		std::string text(static_cast<size_t>(n), ' ');
+		for (auto& c : text)
+		{
+			state = state * 1103515245 + 12345;
+			c = static_cast<char>('a' + (state >> 16) % 26);
+		}
+
+		return text;
+	}
+
+	struct StdHash {
+		size_t operator()(const std::string_view sv) const noexcept
+		{
+			return std::hash<std::string_view>()(sv);
+		}
+	};
+
+	struct CppHash {
+		size_t operator()(const std::string_view sv) const noexcept
+		{
+			return cpp::hash<cpp::StringView>()(cpp::StringView(sv.data(), sv.size()));
+		}
+	};
+
+	template<typename Hash>
+	void BM_hash(benchmark::State& state)
+	{
+		const auto text = make_text(state.range(0));
+		const Hash hash;
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(text.data());
+			benchmark::DoNotOptimize(hash(text));
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+
+	// The striped kernels alone, on 64 KiB.
+	template<void (*Accumulate)(uint64_t (&)[8], const unsigned char*, size_t)>
+	void BM_accumulate(benchmark::State& state)
+	{
+		const auto text = make_text(65536);
+		uint64_t acc[8] = {};
+
+		for (auto _ : state)
+		{
+			Accumulate(acc, reinterpret_cast<const unsigned char*>(text.data()), text.size() / 64);
+			benchmark::DoNotOptimize(acc);
+		}
+
+		state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+	}
+
+	// Looks up 4096 keys of state.range(0) characters, with keys of type Key.
+	// HashedString keys carry their hash, so only the characters of matching slots are read.
+	template<typename Key>
+	void BM_lookup(benchmark::State& state)
+	{
+		std::vector<Key> keys;
+		cpp::FlatHashMap<Key, int> map;
+		for (uint32_t i = 0; i < 4096; ++i)
+		{
+			const auto text = make_text(state.range(0), i + 1);
+			keys.emplace_back(cpp::StringView(text.data(), text.size()));
+			map.try_emplace(keys.back(), static_cast<int>(i));
+		}
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (const auto& key : keys)
+				sum += map.find(key)->second;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+	}
+
+	void text_sizes(benchmark::internal::Benchmark* b)
+	{
+		for (const int64_t n : { 8, 16, 32, 64, 256, 1024, 16384, 1048576 })
+			b->Arg(n);
+	}
+
+	BENCHMARK(BM_hash<StdHash>)->Apply(text_sizes);
+	BENCHMARK(BM_hash<CppHash>)->Apply(text_sizes);
+
+	BENCHMARK(BM_accumulate<cpp::hashing::scalar::accumulate>);
+#if CPP_SEARCH_X86
+	BENCHMARK(BM_accumulate<cpp::hashing::sse2::accumulate>);
+	BENCHMARK(BM_accumulate<cpp::hashing::avx2::accumulate>);
+#endif
+
+	BENCHMARK(BM_lookup<cpp::String>)->Arg(16)->Arg(64)->Arg(256);
+	BENCHMARK(BM_lookup<cpp::HashedString>)->Arg(16)->Arg(64)->Arg(256);
+}// namespace HashBenchmarks
+
+BENCHMARK_MAIN();
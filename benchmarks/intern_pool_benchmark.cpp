@@ -0,0 +1,141 @@
+#include "../src/InternPool.h"
+#include "BenchmarkTypes.h"
+
+#include <string>
+#include <vector>
+
+namespace InternPoolBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	// A few thousand tag names of 20 to 40 characters, as a telemetry pipeline sees them.
+	const std::vector<std::string>& tags()
+	{
+		static const auto names = [] {
+			std::vector<std::string> result;
+			for (int i = 0; i < 4096; ++i)
+				result.push_back("service.frontend." + std::to_string(i * 7919 % 100000) + (i % 2 ? ".latency_ms" : ".requests.total"));
+
+			return result;
+		}();
+
+		return names;
+	}
+
+	// The events: indices into tags(), in a fixed pseudo-random order.
+	const std::vector<uint32_t>& events()
+	{
+		static const auto order = [] {
+			std::vector<uint32_t> result(1 << 16);
+			uint32_t state = 12345;
+			for (auto& index : result)
+			{
+				state = state * 1664525u + 1013904223u;
+				index = (state >> 8) % static_cast<uint32_t>(tags().size());
+			}
+
+			return result;
+		}();
+
+		return order;
+	}
+
+	// What the telemetry path does without a pool: a String per tag per event.
+	void BM_string_per_event(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			for (const auto index : events())
+			{
+				const auto& tag = tags()[index];
+				cpp::String copy(tag.data(), tag.size());
+				benchmark::DoNotOptimize(copy.data());
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events().size()));
+	}
+
+	template<typename Pool>
+	void BM_intern_per_event(benchmark::State& state)
+	{
+		Pool pool;
+		for (const auto& tag : tags())
+			(void) pool.intern(cpp::StringView(tag.data(), tag.size()));
+
+		for (auto _ : state)
+		{
+			for (const auto index : events())
+			{
+				const auto& tag = tags()[index];
+				benchmark::DoNotOptimize(pool.intern(cpp::StringView(tag.data(), tag.size())));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events().size()));
+	}
+
+	// Counting events per tag, keyed by String or by Symbol.
+	void BM_count_by_string(benchmark::State& state)
+	{
+		std::vector<cpp::String> keys;
+		for (const auto index : events())
+			keys.emplace_back(tags()[index].c_str());
+
+		for (auto _ : state)
+		{
+			cpp::FlatHashMap<cpp::String, int64_t> counts;
+			for (const auto& key : keys)
+				++counts[key];
+
+			benchmark::DoNotOptimize(counts.size());
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+	}
+
+	void BM_count_by_symbol(benchmark::State& state)
+	{
+		cpp::InternPool pool;
+		std::vector<cpp::Symbol> keys;
+		for (const auto index : events())
+			keys.push_back(pool.intern(tags()[index].c_str()));
+
+		for (auto _ : state)
+		{
+			cpp::FlatHashMap<cpp::Symbol, int64_t> counts;
+			for (const auto key : keys)
+				++counts[key];
+
+			benchmark::DoNotOptimize(counts.size());
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+	}
+
+	// Every thread interns the same tags into one shared pool.
+	void BM_concurrent_intern(benchmark::State& state)
+	{
+		static cpp::ConcurrentInternPool pool;
+
+		for (auto _ : state)
+		{
+			for (const auto index : events())
+			{
+				const auto& tag = tags()[index];
+				benchmark::DoNotOptimize(pool.intern(cpp::StringView(tag.data(), tag.size())));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events().size()));
+	}
+
+	BENCHMARK(BM_string_per_event);
+	BENCHMARK(BM_intern_per_event<cpp::InternPool>);
+	BENCHMARK(BM_intern_per_event<cpp::ConcurrentInternPool>);
+	BENCHMARK(BM_count_by_string);
+	BENCHMARK(BM_count_by_symbol);
+	BENCHMARK(BM_concurrent_intern)->ThreadRange(1, 4)->UseRealTime();
+}// namespace InternPoolBenchmarks
+
+BENCHMARK_MAIN();
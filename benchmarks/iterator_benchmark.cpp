@@ -0,0 +1,93 @@
+#include "../src/Vector.h"
+#include "benchmark/benchmark.h"
+
+#include <numeric>
+#include <vector>
+
+namespace IteratorBenchmarks
+{
+	// Each benchmark runs the same loop over a std::vector and a cpp::Vector of the same contents.
+	template<typename Container>
+	Container make_container(const int64_t n)
+	{
+		Container c;
+		for (int64_t i = 0; i < n; ++i)
+			c.push_back(static_cast<int>((i * 7919) % 1000));
+
+		return c;
+	}
+
+	template<typename Container>
+	void BM_range_for_sum(benchmark::State& state)
+	{
+		const auto c = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (const auto value : c)
+				sum += value;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_range_for_sum<std::vector<int>>)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_range_for_sum<cpp::Vector<int>>)->Range(1 << 10, 1 << 20);
+
+	template<typename Container>
+	void BM_copy(benchmark::State& state)
+	{
+		const auto src = make_container<Container>(state.range(0));
+		auto dst = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			std::copy(src.begin(), src.end(), dst.begin());
+			benchmark::DoNotOptimize(dst.data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+	}
+	BENCHMARK(BM_copy<std::vector<int>>)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_copy<cpp::Vector<int>>)->Range(1 << 10, 1 << 20);
+
+	template<typename Container>
+	void BM_ranges_fill(benchmark::State& state)
+	{
+		auto c = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			std::ranges::fill(c, 42);
+			benchmark::DoNotOptimize(c.data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+	}
+	BENCHMARK(BM_ranges_fill<std::vector<int>>)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_ranges_fill<cpp::Vector<int>>)->Range(1 << 10, 1 << 20);
+
+	template<typename Container>
+	void BM_sort(benchmark::State& state)
+	{
+		const auto original = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			auto c = original;
+			state.ResumeTiming();
+
+			std::sort(c.begin(), c.end());
+			benchmark::DoNotOptimize(c.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_sort<std::vector<int>>)->Range(1 << 10, 1 << 16);
+	BENCHMARK(BM_sort<cpp::Vector<int>>)->Range(1 << 10, 1 << 16);
+}// namespace IteratorBenchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,147 @@
+#include "../src/Parallel.h"
+#include "../src/Vector.h"
+#include "BenchmarkTypes.h"
+
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace ParallelBenchmarks
+{
+	// The same algorithm on one thread (std) and on the default pool (cpp::parallel), over 10^7 elements.
+	// Real time is reported, since CPU time only counts the calling thread.
+	constexpr int64_t element_count = 10000000;
+
+	cpp::Vector<double> make_input()
+	{
+		std::mt19937_64 random(42);
+		std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+		cpp::Vector<double> vec(element_count);
+		for (int64_t i = 0; i < element_count; ++i)
+			vec.push_back(distribution(random));
+
+		return vec;
+	}
+
+	const cpp::Vector<double>& input()
+	{
+		static const auto vec = make_input();
+		return vec;
+	}
+
+	cpp::Vector<double> make_output()
+	{
+		cpp::Vector<double> vec;
+		vec.resize(element_count);
+		return vec;
+	}
+
+	void BM_transform_serial(benchmark::State& state)
+	{
+		auto out = make_output();
+
+		for (auto _ : state)
+		{
+			std::transform(input().begin(), input().end(), out.begin(), [](const double x) { return std::sqrt(x) * std::log1p(x); });
+			benchmark::DoNotOptimize(out.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_transform_serial)->UseRealTime();
+
+	void BM_transform_parallel(benchmark::State& state)
+	{
+		auto out = make_output();
+
+		for (auto _ : state)
+		{
+			cpp::parallel::transform(input(), out, [](const double x) { return std::sqrt(x) * std::log1p(x); });
+			benchmark::DoNotOptimize(out.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_transform_parallel)->UseRealTime();
+
+	void BM_reduce_serial(benchmark::State& state)
+	{
+		for (auto _ : state)
+			benchmark::DoNotOptimize(std::accumulate(input().begin(), input().end(), 0.0));
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_reduce_serial)->UseRealTime();
+
+	void BM_reduce_parallel(benchmark::State& state)
+	{
+		for (auto _ : state)
+			benchmark::DoNotOptimize(cpp::parallel::reduce(input(), 0.0));
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_reduce_parallel)->UseRealTime();
+
+	void BM_inclusive_scan_serial(benchmark::State& state)
+	{
+		auto out = make_output();
+
+		for (auto _ : state)
+		{
+			std::inclusive_scan(input().begin(), input().end(), out.begin());
+			benchmark::DoNotOptimize(out.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_inclusive_scan_serial)->UseRealTime();
+
+	void BM_inclusive_scan_parallel(benchmark::State& state)
+	{
+		auto out = make_output();
+
+		for (auto _ : state)
+		{
+			cpp::parallel::inclusive_scan(input(), out);
+			benchmark::DoNotOptimize(out.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_inclusive_scan_parallel)->UseRealTime();
+
+	void BM_sort_serial(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			auto vec = input();
+			state.ResumeTiming();
+
+			std::sort(vec.begin(), vec.end());
+			benchmark::DoNotOptimize(vec.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_sort_serial)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+	void BM_sort_parallel(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			auto vec = input();
+			state.ResumeTiming();
+
+			cpp::parallel::sort(vec);
+			benchmark::DoNotOptimize(vec.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * element_count);
+	}
+	BENCHMARK(BM_sort_parallel)->UseRealTime()->Unit(benchmark::kMillisecond);
+}// namespace ParallelBenchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+#include "../src/SegmentedVector.h"
+#include "../src/Vector.h"
+#include "BenchmarkTypes.h"
+
+#include <deque>
+
+namespace SegmentedVectorBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	// SegmentedVector next to cpp::Vector, which copies everything on growth, and std::deque, which
+	// uses blocks as well.
+	template<typename Container>
+	Container make_container(const int64_t n)
+	{
+		using T = typename Container::value_type;
+
+		Container c;
+		for (int64_t i = 0; i < n; ++i)
+			c.push_back(make_value<T>(i));
+
+		return c;
+	}
+
+	template<typename Container>
+	void BM_push_back(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			auto c = make_container<Container>(state.range(0));
+			benchmark::DoNotOptimize(&c);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Container>
+	void BM_iterate(benchmark::State& state)
+	{
+		const auto c = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (const auto& value : c)
+				sum += touch(value);
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Container>
+	void BM_random_access(benchmark::State& state)
+	{
+		const auto n = static_cast<size_t>(state.range(0));
+		const auto c = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (size_t i = 0, j = 0; i < n; ++i, j = (j + 7919) % n)
+				sum += touch(c[j]);
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+// Registers one benchmark for cpp::Vector<T>, std::deque<T> and cpp::SegmentedVector<T> next to each other.
+#define SEGMENTED_VECTOR_BENCHMARK(name, T)                                 \
+	BENCHMARK(name<cpp::Vector<T>>)->Apply(element_counts<T>); \
+	BENCHMARK(name<std::deque<T>>)->Apply(element_counts<T>);  \
+	BENCHMARK(name<cpp::SegmentedVector<T>>)->Apply(element_counts<T>)
+
+#define SEGMENTED_VECTOR_BENCHMARKS(T)           \
+	SEGMENTED_VECTOR_BENCHMARK(BM_push_back, T); \
+	SEGMENTED_VECTOR_BENCHMARK(BM_iterate, T);   \
+	SEGMENTED_VECTOR_BENCHMARK(BM_random_access, T)
+
+	SEGMENTED_VECTOR_BENCHMARKS(int);
+	SEGMENTED_VECTOR_BENCHMARKS(Bytes64);
+}// namespace SegmentedVectorBenchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+#include "../src/SoaVector.h"
+#include "../src/Vector.h"
+#include "BenchmarkTypes.h"
+
+namespace SoaVectorBenchmarks
+{
+	// A particle as a struct, for the array-of-structs layout.
+	struct Particle {
+		double x = 0;
+		double y = 0;
+		double z = 0;
+		double mass = 0;
+		int64_t id = 0;
+		int64_t flags = 0;
+	};
+
+	using ParticleColumns = cpp::SoaVector<double, double, double, double, int64_t, int64_t>;
+
+	cpp::Vector<Particle> make_structs(const int64_t n)
+	{
+		cpp::Vector<Particle> particles;
+		for (int64_t i = 0; i < n; ++i)
+			particles.push_back({ double(i), double(i), double(i), 1.0, i, 0 });
+
+		return particles;
+	}
+
+	ParticleColumns make_columns(const int64_t n)
+	{
+		ParticleColumns particles;
+		for (int64_t i = 0; i < n; ++i)
+			particles.push_back(double(i), double(i), double(i), 1.0, i, 0);
+
+		return particles;
+	}
+
+	// Sums one field: the struct layout reads every field of every particle, the column layout reads
+	// only the x column, which the compiler can vectorize.
+	void BM_sum_field_structs(benchmark::State& state)
+	{
+		const auto particles = make_structs(state.range(0));
+
+		for (auto _ : state)
+		{
+			double sum = 0;
+			for (const auto& particle : particles)
+				sum += particle.x;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_sum_field_columns(benchmark::State& state)
+	{
+		const auto particles = make_columns(state.range(0));
+
+		for (auto _ : state)
+		{
+			double sum = 0;
+			for (const auto x : particles.column<0>())
+				sum += x;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// Updates one field from another, the kind of loop a physics step is made of.
+	void BM_update_field_structs(benchmark::State& state)
+	{
+		auto particles = make_structs(state.range(0));
+
+		for (auto _ : state)
+		{
+			for (auto& particle : particles)
+				particle.x += particle.mass * 0.5;
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_update_field_columns(benchmark::State& state)
+	{
+		auto particles = make_columns(state.range(0));
+
+		for (auto _ : state)
+		{
+			const auto xs = particles.column<0>();
+			const auto masses = particles.column<3>();
+			for (size_t i = 0; i < xs.size(); ++i)
+				xs[i] += masses[i] * 0.5;
+
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// Row-wise iteration through the proxy references, for code that still thinks in records.
+	void BM_iterate_rows_columns(benchmark::State& state)
+	{
+		const auto particles = make_columns(state.range(0));
+
+		for (auto _ : state)
+		{
+			double sum = 0;
+			for (const auto [x, y, z, mass, id, flags] : particles)
+				sum += x * mass;
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_push_back_structs(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			auto particles = make_structs(state.range(0));
+			benchmark::DoNotOptimize(&particles);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_push_back_columns(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			auto particles = make_columns(state.range(0));
+			benchmark::DoNotOptimize(&particles);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	BENCHMARK(BM_sum_field_structs)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_sum_field_columns)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_update_field_structs)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_update_field_columns)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_iterate_rows_columns)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_push_back_structs)->Range(1 << 10, 1 << 20);
+	BENCHMARK(BM_push_back_columns)->Range(1 << 10, 1 << 20);
+}// namespace SoaVectorBenchmarks
+
+BENCHMARK_MAIN();
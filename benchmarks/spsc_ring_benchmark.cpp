@@ -0,0 +1,127 @@
+#include "../src/SpscRing.h"
+#include "BenchmarkTypes.h"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace SpscRingBenchmarks
+{
+	// Hands items from a producer thread to the benchmark thread, once through a mutex-guarded deque
+	// and once through the lock-free ring, one element or one batch at a time. A side that finds the
+	// queue full or empty yields, so that the benchmark stays meaningful on machines with few cores.
+	constexpr int64_t items_per_iteration = 1 << 20;
+
+	// The queue the ring replaces.
+	class MutexQueue
+	{
+	public:
+		bool try_push(const int64_t value)
+		{
+			std::lock_guard lock(m_mutex);
+			m_items.push_back(value);
+			return true;
+		}
+
+		bool try_pop(int64_t& out)
+		{
+			std::lock_guard lock(m_mutex);
+			if (m_items.empty())
+				return false;
+
+			out = m_items.front();
+			m_items.pop_front();
+			return true;
+		}
+
+	private:
+		std::mutex m_mutex;
+		std::deque<int64_t> m_items;
+	};
+
+	template<typename Queue>
+	void BM_handoff(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			Queue queue;
+			std::thread producer([&queue] {
+				for (int64_t i = 0; i < items_per_iteration;)
+				{
+					if (queue.try_push(i))
+						++i;
+					else
+						std::this_thread::yield();
+				}
+			});
+
+			int64_t sum = 0;
+			int64_t value = 0;
+			for (int64_t received = 0; received < items_per_iteration;)
+			{
+				if (queue.try_pop(value))
+				{
+					sum += value;
+					++received;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			producer.join();
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * items_per_iteration);
+	}
+	BENCHMARK(BM_handoff<MutexQueue>)->UseRealTime();
+	BENCHMARK(BM_handoff<cpp::SpscRing<int64_t, 4096>>)->UseRealTime();
+
+	void BM_handoff_batched(benchmark::State& state)
+	{
+		constexpr size_t batch_size = 64;
+
+		for (auto _ : state)
+		{
+			cpp::SpscRing<int64_t, 4096> ring;
+			std::thread producer([&ring] {
+				int64_t batch[batch_size];
+				for (int64_t i = 0; i < items_per_iteration;)
+				{
+					for (size_t j = 0; j < batch_size; ++j)
+						batch[j] = i + static_cast<int64_t>(j);
+
+					const auto pushed = ring.try_push_n(batch, batch_size);
+					if (pushed == 0)
+						std::this_thread::yield();
+
+					i += static_cast<int64_t>(pushed);
+				}
+			});
+
+			int64_t sum = 0;
+			int64_t batch[batch_size];
+			for (int64_t received = 0; received < items_per_iteration;)
+			{
+				const auto n = ring.try_pop_n(batch, batch_size);
+				if (n == 0)
+					std::this_thread::yield();
+
+				for (size_t j = 0; j < n; ++j)
+					sum += batch[j];
+
+				received += static_cast<int64_t>(n);
+			}
+
+			producer.join();
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * items_per_iteration);
+	}
+	BENCHMARK(BM_handoff_batched)->UseRealTime();
+}// namespace SpscRingBenchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+#include "../src/String.h"
+#include "BenchmarkTypes.h"
+
+#include <string>
+
+namespace StringBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	// n pseudo-random lowercase letters.
+	std::string make_text(const int64_t n)
+	{
+		std::string text(static_cast<size_t>(n), ' ');
+		uint32_t state = 12345;
+		for (auto& c : text)
+		{
+			state = state * 1103515245 + 12345;
+			c = static_cast<char>('a' + (state >> 16) % 26);
+		}
+
+		return text;
+	}
+
+	template<typename Str>
+	void BM_construct(benchmark::State& state)
+	{
+		const auto text = make_text(state.range(0));
+
+		for (auto _ : state)
+		{
+			Str str(text.data(), text.size());
+			benchmark::DoNotOptimize(str.c_str());
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Str>
+	void BM_append(benchmark::State& state)
+	{
+		constexpr const char piece[] = "01234567";
+		const auto n = state.range(0);
+
+		for (auto _ : state)
+		{
+			Str str;
+			for (int64_t size = 0; size < n; size += 8)
+				str.append(piece, 8);
+
+			benchmark::DoNotOptimize(str.c_str());
+		}
+
+		state.SetBytesProcessed(state.iterations() * n);
+	}
+
+	template<typename Str>
+	void BM_find(benchmark::State& state)
+	{
+		const auto text = make_text(state.range(0));
+		const Str str(text.data(), text.size());
+
+		for (auto _ : state)
+		{
+			// Digits never occur in the text, so the whole string is scanned.
+			auto found = str.find("needle42");
+			benchmark::DoNotOptimize(found);
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Str>
+	void BM_substr(benchmark::State& state)
+	{
+		const auto text = make_text(state.range(0));
+		const Str str(text.data(), text.size());
+		const auto n = static_cast<size_t>(state.range(0));
+
+		for (auto _ : state)
+		{
+			auto sub = str.substr(n / 4, n / 2);
+			benchmark::DoNotOptimize(sub.c_str());
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0) / 2);
+	}
+
+	template<typename Str>
+	void BM_compare(benchmark::State& state)
+	{
+		const auto text = make_text(state.range(0));
+		const Str lhs(text.data(), text.size());
+		const Str rhs(text.data(), text.size());
+
+		for (auto _ : state)
+		{
+			auto equal = lhs == rhs;
+			benchmark::DoNotOptimize(equal);
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+
+// Registers one benchmark for std::string and cpp::String next to each other.
+#define STRING_BENCHMARK(name)                                         \
+	BENCHMARK(name<std::string>)->Apply(element_counts<char>); \
+	BENCHMARK(name<cpp::String>)->Apply(element_counts<char>)
+
+	STRING_BENCHMARK(BM_construct);
+	STRING_BENCHMARK(BM_append);
+	STRING_BENCHMARK(BM_find);
+	STRING_BENCHMARK(BM_substr);
+	STRING_BENCHMARK(BM_compare);
+}// namespace StringBenchmarks
+
+BENCHMARK_MAIN();
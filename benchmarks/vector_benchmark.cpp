@@ -0,0 +1,146 @@
+#include "../src/Vector.h"
+#include "BenchmarkTypes.h"
+
+#include <vector>
+
+namespace VectorBenchmarks
+{
+	using namespace BenchmarkTypes;
+
+	template<typename Container>
+	Container make_container(const int64_t n)
+	{
+		using T = typename Container::value_type;
+
+		Container c;
+		c.reserve(static_cast<size_t>(n));
+		for (int64_t i = 0; i < n; ++i)
+			c.push_back(make_value<T>(i));
+
+		return c;
+	}
+
+	template<typename Container>
+	void BM_push_back(benchmark::State& state)
+	{
+		using T = typename Container::value_type;
+		const auto n = state.range(0);
+
+		for (auto _ : state)
+		{
+			Container c;
+			for (int64_t i = 0; i < n; ++i)
+				c.push_back(make_value<T>(i));
+
+			benchmark::DoNotOptimize(c.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	template<typename Container>
+	void BM_push_back_reserved(benchmark::State& state)
+	{
+		using T = typename Container::value_type;
+		const auto n = state.range(0);
+
+		for (auto _ : state)
+		{
+			Container c;
+			c.reserve(static_cast<size_t>(n));
+			for (int64_t i = 0; i < n; ++i)
+				c.push_back(make_value<T>(i));
+
+			benchmark::DoNotOptimize(c.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	template<typename Container>
+	void BM_copy(benchmark::State& state)
+	{
+		using T = typename Container::value_type;
+		const auto src = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			Container copy(src);
+			benchmark::DoNotOptimize(copy.data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(T)));
+	}
+
+	// Appends a whole range at once: a single allocation and, for trivially copyable T, one memcpy.
+	template<typename Container>
+	void BM_append_range(benchmark::State& state)
+	{
+		using T = typename Container::value_type;
+		const auto src = make_container<std::vector<T>>(state.range(0));
+
+		for (auto _ : state)
+		{
+			Container c;
+			c.insert(c.end(), src.begin(), src.end());
+			benchmark::DoNotOptimize(c.data());
+		}
+
+		state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(T)));
+	}
+
+	// Inserts and erases one element in the middle, which shifts half of the elements up and back down.
+	template<typename Container>
+	void BM_insert_erase_middle(benchmark::State& state)
+	{
+		using T = typename Container::value_type;
+		auto c = make_container<Container>(state.range(0));
+		const auto middle = c.size() / 2;
+
+		for (auto _ : state)
+		{
+			c.insert(c.begin() + middle, make_value<T>(1));
+			c.erase(c.begin() + middle);
+			benchmark::DoNotOptimize(c.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename Container>
+	void BM_iterate(benchmark::State& state)
+	{
+		const auto c = make_container<Container>(state.range(0));
+
+		for (auto _ : state)
+		{
+			int64_t sum = 0;
+			for (const auto& value : c)
+				sum += touch(value);
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+// Registers one benchmark for std::vector<T> and cpp::Vector<T> next to each other.
+#define VECTOR_BENCHMARK(name, T)                                     \
+	BENCHMARK(name<std::vector<T>>)->Apply(element_counts<T>); \
+	BENCHMARK(name<cpp::Vector<T>>)->Apply(element_counts<T>)
+
+#define VECTOR_BENCHMARKS(T)                     \
+	VECTOR_BENCHMARK(BM_push_back, T);           \
+	VECTOR_BENCHMARK(BM_push_back_reserved, T);  \
+	VECTOR_BENCHMARK(BM_copy, T);                \
+	VECTOR_BENCHMARK(BM_append_range, T);        \
+	VECTOR_BENCHMARK(BM_insert_erase_middle, T); \
+	VECTOR_BENCHMARK(BM_iterate, T)
+
+	VECTOR_BENCHMARKS(int);
+	VECTOR_BENCHMARKS(Bytes16);
+	VECTOR_BENCHMARKS(Bytes64);
+	VECTOR_BENCHMARKS(Bytes256);
+}// namespace VectorBenchmarks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "pch.h"
+
+#include "GrowthPolicy.h"
+#include "Memory.h"
+#include "Vector.h"
+#include <bit>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace cpp
+{
+	// The size of a transparent huge page on the targets we care about.
+	inline constexpr size_t huge_page_size = size_t{ 2 } << 20;
+
+	// An allocator whose blocks start at a multiple of Alignment bytes and span a whole number of
+	// Alignment-sized chunks.
+	//
+	// With the default 64 bytes a block starts on a cache line, so full-width AVX-512 loads never
+	// straddle two lines, and a vector loop can process the tail of the block with a full-width load
+	// instead of a scalar epilogue. usable_size() reports the padded size, so a Vector with the
+	// growth::SizeClass policy (see AlignedVector) exposes that padding as capacity.
+	//
+	// With HugePages, blocks of at least huge_page_size bytes are aligned and sized to whole huge pages,
+	// and the kernel is asked to back them with transparent huge pages (madvise(MADV_HUGEPAGE)), which cuts
+	// TLB misses when walking arrays of many megabytes. Smaller blocks are not affected.
+	template<typename T, size_t Alignment = cache_line_size, bool HugePages = false>
+	class AlignedAllocator
+	{
+		static_assert(std::has_single_bit(Alignment), "the alignment must be a power of two");
+		static_assert(Alignment >= alignof(T), "the alignment must not be weaker than that of T");
+
+	public:
+		using value_type = T;
+
+		static constexpr size_t alignment = Alignment;
+
+		template<typename U>
+		struct rebind {
+			using other = AlignedAllocator<U, std::max(Alignment, alignof(U)), HugePages>;
+		};
+
+		constexpr AlignedAllocator() noexcept = default;
+
+		template<typename U, size_t OtherAlignment>
+		constexpr AlignedAllocator(const AlignedAllocator<U, OtherAlignment, HugePages>&) noexcept
+		{
+		}
+
+		// Returns a block of at least n elements. Throws bad_alloc if there is no memory.
+		[[nodiscard]] T* allocate(const size_t n)
+		{
+			if (n > (std::numeric_limits<size_t>::max() - huge_page_size) / sizeof(T))
+				throw std::bad_array_new_length();
+
+			const auto bytes = block_bytes(n);
+			auto p = ::operator new(bytes, std::align_val_t{ block_alignment(bytes) });
+
+#ifdef MADV_HUGEPAGE
+			// Only a hint: kernels without transparent huge pages fall back to normal pages.
+			if constexpr (HugePages)
+			{
+				if (bytes >= huge_page_size)
+					::madvise(p, bytes, MADV_HUGEPAGE);
+			}
+#endif
+
+			return static_cast<T*>(p);
+		}
+
+		// Releases a block of n elements, where n is anything from the count asked for to its usable_size().
+		void deallocate(T* p, const size_t n) noexcept
+		{
+			const auto bytes = block_bytes(n);
+			::operator delete(p, bytes, std::align_val_t{ block_alignment(bytes) });
+		}
+
+		// Returns the number of elements that fit in a block allocated for n of them.
+		[[nodiscard]] size_t usable_size(T*, const size_t n) const noexcept
+		{
+			return block_bytes(n) / sizeof(T);
+		}
+
+		template<typename U, size_t OtherAlignment>
+		constexpr bool operator==(const AlignedAllocator<U, OtherAlignment, HugePages>&) const noexcept
+		{
+			return true;
+		}
+
+	private:
+		static constexpr size_t round_up(const size_t bytes, const size_t multiple) noexcept
+		{
+			return (bytes + multiple - 1) / multiple * multiple;
+		}
+
+		// Returns the size of the block for n elements. A count and its usable_size() map to the same
+		// size, since rounding a size up that is already rounded up changes nothing.
+		static constexpr size_t block_bytes(const size_t n) noexcept
+		{
+			const auto bytes = round_up(std::max<size_t>(n * sizeof(T), 1), Alignment);
+
+			if constexpr (HugePages)
+			{
+				if (bytes >= huge_page_size)
+					return round_up(bytes, huge_page_size);
+			}
+
+			return bytes;
+		}
+
+		// Returns the alignment of a block of the given size, as returned by block_bytes().
+		static constexpr size_t block_alignment(const size_t bytes) noexcept
+		{
+			if constexpr (HugePages)
+			{
+				if (bytes >= huge_page_size)
+					return std::max(Alignment, huge_page_size);
+			}
+
+			return Alignment;
+		}
+	};
+
+	// A Vector whose elements start at a multiple of Alignment bytes and whose capacity is padded to
+	// whole Alignment-sized chunks, so that kernels can use aligned full-width loads up to capacity().
+	template<typename T, size_t Alignment = cache_line_size, bool HugePages = false, typename GrowthBase = growth::Doubling>
+	using AlignedVector = Vector<T, AlignedAllocator<T, Alignment, HugePages>, growth::SizeClass<GrowthBase>>;
+
+	// An AlignedVector whose large blocks are backed by transparent huge pages.
+	template<typename T, size_t Alignment = cache_line_size>
+	using HugePageVector = AlignedVector<T, Alignment, true>;
+}// namespace cpp
@@ -0,0 +1,386 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// Define CPP_ALLOCATION_STATS to 1 (the ENABLE_ALLOCATION_STATS CMake option does so) to have Vector and
+// String count what they allocate and move. Otherwise every hook below is an empty inline function and
+// the containers compile to exactly the same code as without them.
+#ifndef CPP_ALLOCATION_STATS
+#define CPP_ALLOCATION_STATS 0
+#endif
+
+// Allocation and relocation statistics per container type.
+//
+// The containers report every buffer they allocate and free, every time they move their elements to
+// another buffer and every time they are copied. The counts are kept per instantiated container type
+// (cpp::Vector<int> and cpp::Vector<String> are counted apart) in counters owned by the recording
+// thread, so recording never contends; snapshot() adds up the counters of all threads when asked.
+namespace cpp::stats
+{
+	inline constexpr bool enabled = CPP_ALLOCATION_STATS != 0;
+
+	struct Counters {
+		// Buffers obtained from and returned to the allocator.
+		uint64_t allocations = 0;
+		uint64_t deallocations = 0;
+		uint64_t bytes_allocated = 0;
+
+		// The largest single buffer, in bytes.
+		uint64_t peak_capacity_bytes = 0;
+
+		// Bytes of capacity that growth reserved beyond what the container needed at that time.
+		uint64_t slack_bytes = 0;
+
+		// Times the elements were moved to another buffer, and how many elements and bytes that moved.
+		uint64_t reallocations = 0;
+		uint64_t elements_moved = 0;
+		uint64_t bytes_moved = 0;
+
+		// Elements and bytes copied when a whole container was copied.
+		uint64_t elements_copied = 0;
+		uint64_t bytes_copied = 0;
+
+		Counters& operator+=(const Counters& other) noexcept
+		{
+			allocations += other.allocations;
+			deallocations += other.deallocations;
+			bytes_allocated += other.bytes_allocated;
+			peak_capacity_bytes = std::max(peak_capacity_bytes, other.peak_capacity_bytes);
+			slack_bytes += other.slack_bytes;
+			reallocations += other.reallocations;
+			elements_moved += other.elements_moved;
+			bytes_moved += other.bytes_moved;
+			elements_copied += other.elements_copied;
+			bytes_copied += other.bytes_copied;
+			return *this;
+		}
+
+		friend bool operator==(const Counters&, const Counters&) = default;
+	};
+
+	// The counters of one container type, named the way the compiler spells it.
+	struct TypeStats {
+		std::string_view type;
+		Counters counters;
+	};
+
+	namespace detail
+	{
+		// Types beyond the first max_types - 1 share the last slot.
+		inline constexpr size_t max_types = 128;
+
+		enum Field : size_t {
+			allocations,
+			deallocations,
+			bytes_allocated,
+			peak_capacity_bytes,
+			slack_bytes,
+			reallocations,
+			elements_moved,
+			bytes_moved,
+			elements_copied,
+			bytes_copied,
+			field_count,
+		};
+
+		// Only the owning thread writes its counters; other threads read them for a snapshot, hence the
+		// atomics. Relaxed loads and stores compile to plain moves, without a locked instruction.
+		using Slot = std::array<std::atomic<uint64_t>, field_count>;
+
+		struct ThreadCounters {
+			std::array<Slot, max_types> slots{};
+		};
+
+		inline Counters to_counters(const std::array<uint64_t, field_count>& values) noexcept
+		{
+			return { values[allocations], values[deallocations], values[bytes_allocated], values[peak_capacity_bytes], values[slack_bytes],
+					 values[reallocations], values[elements_moved], values[bytes_moved], values[elements_copied], values[bytes_copied] };
+		}
+
+		class Registry
+		{
+		public:
+			// Never destroyed, so that threads that exit during static destruction can still retire their counters.
+			static Registry& instance()
+			{
+				static auto registry = new Registry;
+				return *registry;
+			}
+
+			size_t add_type(const std::string_view name)
+			{
+				std::lock_guard lock(m_mutex);
+				if (m_names.size() == max_types - 1)
+					m_names.emplace_back("(other types)");
+				if (m_names.size() == max_types)
+					return max_types - 1;
+
+				m_names.push_back(name);
+				return m_names.size() - 1;
+			}
+
+			void add_thread(ThreadCounters* counters)
+			{
+				std::lock_guard lock(m_mutex);
+				m_threads.push_back(counters);
+			}
+
+			// Folds the counters of an exiting thread into the totals of the exited threads.
+			void retire_thread(ThreadCounters* counters)
+			{
+				std::lock_guard lock(m_mutex);
+				for (size_t type = 0; type < max_types; ++type)
+					accumulate(m_retired[type], counters->slots[type]);
+
+				std::erase(m_threads, counters);
+			}
+
+			std::vector<TypeStats> snapshot()
+			{
+				std::lock_guard lock(m_mutex);
+				std::vector<TypeStats> result;
+				result.reserve(m_names.size());
+
+				for (size_t type = 0; type < m_names.size(); ++type)
+				{
+					auto values = m_retired[type];
+					for (const auto thread : m_threads)
+						accumulate(values, thread->slots[type]);
+
+					result.push_back({ m_names[type], to_counters(values) });
+				}
+
+				return result;
+			}
+
+			void reset()
+			{
+				std::lock_guard lock(m_mutex);
+				m_retired = {};
+
+				for (const auto thread : m_threads)
+				{
+					for (auto& slot : thread->slots)
+					{
+						for (auto& value : slot)
+							value.store(0, std::memory_order_relaxed);
+					}
+				}
+			}
+
+		private:
+			static void accumulate(std::array<uint64_t, field_count>& values, const Slot& slot) noexcept
+			{
+				for (size_t field = 0; field < field_count; ++field)
+				{
+					const auto value = slot[field].load(std::memory_order_relaxed);
+					values[field] = field == peak_capacity_bytes ? std::max(values[field], value) : values[field] + value;
+				}
+			}
+
+			std::mutex m_mutex;
+			std::vector<std::string_view> m_names;
+			std::vector<ThreadCounters*> m_threads;
+			std::array<std::array<uint64_t, field_count>, max_types> m_retired{};
+		};
+
+		// Owns the counters of the calling thread, which are created on its first record.
+		class ThreadOwner
+		{
+		public:
+			~ThreadOwner()
+			{
+				if (m_counters)
+					Registry::instance().retire_thread(m_counters.get());
+			}
+
+			ThreadCounters& counters()
+			{
+				if (!m_counters)
+				{
+					m_counters = std::make_unique<ThreadCounters>();
+					Registry::instance().add_thread(m_counters.get());
+				}
+
+				return *m_counters;
+			}
+
+		private:
+			std::unique_ptr<ThreadCounters> m_counters;
+		};
+
+		// Returns the name of T as spelled by the compiler.
+		template<typename T>
+		constexpr std::string_view type_name() noexcept
+		{
+#if defined(__clang__) || defined(__GNUC__)
+			const std::string_view function = __PRETTY_FUNCTION__;
+			const auto first = function.find("T = ") + 4;
+			return function.substr(first, function.find_first_of(";]", first) - first);
+#elif defined(_MSC_VER)
+			const std::string_view function = __FUNCSIG__;
+			const auto first = function.find("type_name<") + 10;
+			return function.substr(first, function.rfind(">(void)") - first);
+#else
+			return "(unnamed type)";
+#endif
+		}
+
+		template<typename Container>
+		size_t type_index()
+		{
+			static const size_t index = Registry::instance().add_type(type_name<Container>());
+			return index;
+		}
+
+		inline ThreadCounters& thread_counters()
+		{
+			static thread_local ThreadOwner owner;
+			return owner.counters();
+		}
+
+		template<typename Container>
+		Slot& slot()
+		{
+			return thread_counters().slots[type_index<Container>()];
+		}
+
+		inline void add(Slot& slot, const Field field, const uint64_t value) noexcept
+		{
+			slot[field].store(slot[field].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		inline void raise(Slot& slot, const Field field, const uint64_t value) noexcept
+		{
+			if (value > slot[field].load(std::memory_order_relaxed))
+				slot[field].store(value, std::memory_order_relaxed);
+		}
+	}// namespace detail
+
+	// Hooks called by the containers. They do nothing during constant evaluation or when statistics are disabled.
+
+	// A buffer of bytes bytes was allocated.
+	template<typename Container>
+	constexpr void on_allocate([[maybe_unused]] const size_t bytes)
+	{
+#if CPP_ALLOCATION_STATS
+		if (std::is_constant_evaluated())
+			return;
+
+		auto& slot = detail::slot<Container>();
+		detail::add(slot, detail::allocations, 1);
+		detail::add(slot, detail::bytes_allocated, bytes);
+		detail::raise(slot, detail::peak_capacity_bytes, bytes);
+#endif
+	}
+
+	// A buffer of bytes bytes was freed.
+	template<typename Container>
+	constexpr void on_deallocate([[maybe_unused]] const size_t bytes)
+	{
+#if CPP_ALLOCATION_STATS
+		if (!std::is_constant_evaluated())
+			detail::add(detail::slot<Container>(), detail::deallocations, 1);
+#endif
+	}
+
+	// The container grew to capacity_bytes while it needed needed_bytes.
+	template<typename Container>
+	constexpr void on_grow([[maybe_unused]] const size_t needed_bytes, [[maybe_unused]] const size_t capacity_bytes)
+	{
+#if CPP_ALLOCATION_STATS
+		if (!std::is_constant_evaluated())
+			detail::add(detail::slot<Container>(), detail::slack_bytes, capacity_bytes - needed_bytes);
+#endif
+	}
+
+	// The container moved elements elements, of bytes bytes in all, to a new buffer. Moving no element
+	// into a first buffer is not counted as a reallocation.
+	template<typename Container>
+	constexpr void on_relocate([[maybe_unused]] const size_t elements, [[maybe_unused]] const size_t bytes)
+	{
+#if CPP_ALLOCATION_STATS
+		if (std::is_constant_evaluated() || elements == 0)
+			return;
+
+		auto& slot = detail::slot<Container>();
+		detail::add(slot, detail::reallocations, 1);
+		detail::add(slot, detail::elements_moved, elements);
+		detail::add(slot, detail::bytes_moved, bytes);
+#endif
+	}
+
+	// The container copied elements elements, of bytes bytes in all, from another container.
+	template<typename Container>
+	constexpr void on_copy([[maybe_unused]] const size_t elements, [[maybe_unused]] const size_t bytes)
+	{
+#if CPP_ALLOCATION_STATS
+		if (std::is_constant_evaluated())
+			return;
+
+		auto& slot = detail::slot<Container>();
+		detail::add(slot, detail::elements_copied, elements);
+		detail::add(slot, detail::bytes_copied, bytes);
+#endif
+	}
+
+	// Returns the counters of every container type that recorded anything, summed over all threads,
+	// or nothing if statistics are disabled. Counters that threads update meanwhile may or may not be included.
+	inline std::vector<TypeStats> snapshot()
+	{
+		if constexpr (enabled)
+			return detail::Registry::instance().snapshot();
+		else
+			return {};
+	}
+
+	// Returns the counters of Container, summed over all threads.
+	template<typename Container>
+	Counters snapshot_of()
+	{
+		if constexpr (enabled)
+		{
+			for (const auto& stats : snapshot())
+			{
+				if (stats.type == detail::type_name<Container>())
+					return stats.counters;
+			}
+		}
+
+		return {};
+	}
+
+	// Sets all counters to zero. Records that threads make meanwhile may survive the reset.
+	inline void reset()
+	{
+		if constexpr (enabled)
+			detail::Registry::instance().reset();
+	}
+
+	// Writes a table of the counters of every container type to os.
+	inline void dump(std::ostream& os)
+	{
+		if constexpr (!enabled)
+		{
+			os << "allocation statistics are disabled (define CPP_ALLOCATION_STATS=1)\n";
+			return;
+		}
+
+		for (const auto& [type, c] : snapshot())
+		{
+			os << type << '\n'
+			   << "  allocations " << c.allocations << ", deallocations " << c.deallocations << ", bytes allocated " << c.bytes_allocated
+			   << ", peak capacity " << c.peak_capacity_bytes << " bytes, growth slack " << c.slack_bytes << " bytes\n"
+			   << "  reallocations " << c.reallocations << ", moved " << c.elements_moved << " elements (" << c.bytes_moved << " bytes)"
+			   << ", copied " << c.elements_copied << " elements (" << c.bytes_copied << " bytes)\n";
+		}
+	}
+}// namespace cpp::stats
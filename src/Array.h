@@ -10,6 +10,8 @@ namespace cpp
 	class Array
 	{
 	public:
+		using value_type = T;
+
 		// initializes the array
 		constexpr Array() = default;
 		// destroys the array
@@ -129,15 +131,26 @@ namespace cpp
 		}
 
 		using it = Iterator<Array, T>;
+		using const_it = Iterator<Array, const T>;
+
+		constexpr it begin() noexcept
+		{
+			return it(m_data);
+		}
+
+		constexpr const_it begin() const noexcept
+		{
+			return const_it(m_data);
+		}
 
-		constexpr it begin()
+		constexpr it end() noexcept
 		{
-			return it::begin(*this);
+			return it(m_data + N);
 		}
 
-		constexpr it end()
+		constexpr const_it end() const noexcept
 		{
-			return it::end(*this);
+			return const_it(m_data + N);
 		}
 
 	private:
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Memory.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <new>
+
+namespace cpp
+{
+	// An append-only vector that many threads may grow and read at the same time.
+	//
+	// The elements live in segments whose sizes double: the first one holds first_segment_size elements,
+	// the next one twice as many, and so on. A segment is never moved or freed while the vector lives, so
+	// an element keeps its address once it is constructed. Appending claims indices with a single atomic
+	// add and installs missing segments with a compare-and-swap, without locks; indexed access is two loads.
+	//
+	// Every segment carries one bit per element that is set once the element is fully constructed.
+	// size() counts claimed indices, some of which may still be under construction (or never be
+	// constructed, if their constructor threw); ready(index) tells whether an element may be read.
+	template<typename T>
+	class ConcurrentVector
+	{
+		using ReadyWord = std::atomic<uint64_t>;
+
+	public:
+		using value_type = T;
+
+		// The number of elements in the first segment; the k-th segment holds first_segment_size << k.
+		static constexpr size_t first_segment_size = 32;
+
+		ConcurrentVector() = default;
+		ConcurrentVector(const ConcurrentVector&) = delete;
+		ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+		// Destroys the constructed elements and frees the segments. No other thread may use the vector any more.
+		~ConcurrentVector()
+		{
+			clear();
+
+			for (auto& segment : m_segments)
+			{
+				if (auto block = segment.load(std::memory_order_relaxed))
+					free_segment(block);
+			}
+		}
+
+		// Copies value to a new element at the end. Returns the index of the new element.
+		size_t push_back(const T& value)
+		{
+			return emplace_back(value);
+		}
+
+		// Moves value to a new element at the end. Returns the index of the new element.
+		size_t push_back(T&& value)
+		{
+			return emplace_back(std::move(value));
+		}
+
+		// Constructs a new element at the end from args. Returns the index of the new element.
+		template<typename... Args>
+		size_t emplace_back(Args&&... args)
+		{
+			const auto index = m_size.fetch_add(1, std::memory_order_relaxed);
+			construct(index, std::forward<Args>(args)...);
+			return index;
+		}
+
+		// Appends n default-constructed elements. Returns the index of the first one.
+		size_t grow_by(const size_t n)
+		{
+			const auto first = m_size.fetch_add(n, std::memory_order_relaxed);
+			for (size_t i = 0; i < n; ++i)
+				construct(first + i);
+
+			return first;
+		}
+
+		// Appends n copies of value. Returns the index of the first one.
+		size_t grow_by(const size_t n, const T& value)
+		{
+			const auto first = m_size.fetch_add(n, std::memory_order_relaxed);
+			for (size_t i = 0; i < n; ++i)
+				construct(first + i, value);
+
+			return first;
+		}
+
+		// Allocates the segments needed to hold n elements, so that appends up to n never allocate.
+		void reserve(const size_t n)
+		{
+			if (n == 0)
+				return;
+
+			for (size_t k = 0; k <= segment_of(n - 1); ++k)
+				segment(k);
+		}
+
+		// Returns a reference to the element at position index. Wait-free.
+		// The element must be ready, either because ready(index) returned true or because the reader
+		// synchronized with the thread that appended it.
+		T& operator[](const size_t index) noexcept
+		{
+			return items(index)[offset_of(index)];
+		}
+
+		// Returns a reference to the element at position index. Wait-free.
+		const T& operator[](const size_t index) const noexcept
+		{
+			return items(index)[offset_of(index)];
+		}
+
+		// Returns a reference to the element at position index,
+		// throwing an out_of_range exception if that element is not ready.
+		T& at(const size_t index)
+		{
+			if (!ready(index))
+				throw std::out_of_range("ConcurrentVector element is not ready");
+
+			return (*this)[index];
+		}
+
+		// Returns a reference to the element at position index,
+		// throwing an out_of_range exception if that element is not ready.
+		const T& at(const size_t index) const
+		{
+			if (!ready(index))
+				throw std::out_of_range("ConcurrentVector element is not ready");
+
+			return (*this)[index];
+		}
+
+		// Returns whether the element at position index is fully constructed. Wait-free.
+		// A true result also makes the writes of its constructor visible to the calling thread.
+		[[nodiscard]] bool ready(const size_t index) const noexcept
+		{
+			if (index >= size())
+				return false;
+
+			const auto block = m_segments[segment_of(index)].load(std::memory_order_acquire);
+			if (!block)
+				return false;
+
+			const auto offset = offset_of(index);
+			const auto word = ready_words(block, segment_of(index))[offset / 64].load(std::memory_order_acquire);
+			return (word >> (offset % 64)) & 1;
+		}
+
+		// Returns the number of elements appended so far, including those still under construction.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_size.load(std::memory_order_acquire);
+		}
+
+		// Returns whether no element has been appended.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		// Destroys all elements, keeping the segments. No other thread may use the vector meanwhile.
+		void clear()
+		{
+			const auto sz = m_size.load(std::memory_order_relaxed);
+
+			for (size_t k = 0; k < max_segments && segment_base(k) < sz; ++k)
+			{
+				const auto block = m_segments[k].load(std::memory_order_relaxed);
+				if (!block)
+					continue;
+
+				const auto count = std::min(segment_size(k), sz - segment_base(k));
+				const auto words = ready_words(block, k);
+
+				for (size_t j = 0; j < count; ++j)
+				{
+					if ((words[j / 64].load(std::memory_order_relaxed) >> (j % 64)) & 1)
+						std::destroy_at(reinterpret_cast<T*>(block) + j);
+				}
+
+				for (size_t w = 0; w < word_count(k); ++w)
+					words[w].store(0, std::memory_order_relaxed);
+			}
+
+			m_size.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		static constexpr size_t first_segment_shift = std::countr_zero(first_segment_size);
+		static constexpr size_t max_segments = 64 - first_segment_shift;
+		static constexpr size_t alignment = std::max(alignof(T), cache_line_size);
+
+		static_assert(std::has_single_bit(first_segment_size));
+
+		// Segment k holds the indices [first_segment_size * (2^k - 1), first_segment_size * (2^(k+1) - 1)).
+		static size_t segment_of(const size_t index) noexcept
+		{
+			return std::bit_width((index >> first_segment_shift) + 1) - 1;
+		}
+
+		static size_t segment_base(const size_t k) noexcept
+		{
+			return first_segment_size * ((size_t{ 1 } << k) - 1);
+		}
+
+		static size_t segment_size(const size_t k) noexcept
+		{
+			return first_segment_size << k;
+		}
+
+		static size_t offset_of(const size_t index) noexcept
+		{
+			return index - segment_base(segment_of(index));
+		}
+
+		static size_t word_count(const size_t k) noexcept
+		{
+			return (segment_size(k) + 63) / 64;
+		}
+
+		// The ready bits follow the elements in the same block.
+		static size_t items_bytes(const size_t k) noexcept
+		{
+			return (segment_size(k) * sizeof(T) + alignof(ReadyWord) - 1) / alignof(ReadyWord) * alignof(ReadyWord);
+		}
+
+		static ReadyWord* ready_words(std::byte* block, const size_t k) noexcept
+		{
+			return reinterpret_cast<ReadyWord*>(block + items_bytes(k));
+		}
+
+		T* items(const size_t index) const noexcept
+		{
+			return reinterpret_cast<T*>(m_segments[segment_of(index)].load(std::memory_order_acquire));
+		}
+
+		// Returns segment k, installing it if no thread has done so yet.
+		std::byte* segment(const size_t k)
+		{
+			auto block = m_segments[k].load(std::memory_order_acquire);
+			if (block)
+				return block;
+
+			auto fresh = static_cast<std::byte*>(::operator new(items_bytes(k) + word_count(k) * sizeof(ReadyWord), std::align_val_t{ alignment }));
+			for (size_t w = 0; w < word_count(k); ++w)
+				std::construct_at(ready_words(fresh, k) + w, 0);
+
+			// Another thread may have installed the segment meanwhile; then its block wins and ours is freed.
+			if (m_segments[k].compare_exchange_strong(block, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+				return fresh;
+
+			::operator delete(fresh, std::align_val_t{ alignment });
+			return block;
+		}
+
+		static void free_segment(std::byte* block) noexcept
+		{
+			::operator delete(block, std::align_val_t{ alignment });
+		}
+
+		// Constructs the element of a claimed index and marks it ready. If the constructor throws the
+		// index stays unready and the exception propagates.
+		template<typename... Args>
+		void construct(const size_t index, Args&&... args)
+		{
+			const auto k = segment_of(index);
+			const auto offset = index - segment_base(k);
+			const auto block = segment(k);
+
+			std::construct_at(reinterpret_cast<T*>(block) + offset, std::forward<Args>(args)...);
+			ready_words(block, k)[offset / 64].fetch_or(uint64_t{ 1 } << (offset % 64), std::memory_order_release);
+		}
+
+		std::atomic<std::byte*> m_segments[max_segments] = {};
+		alignas(cache_line_size) std::atomic<size_t> m_size = 0;
+	};
+}// namespace cpp
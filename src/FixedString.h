@@ -0,0 +1,161 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Iterator.h"
+#include "StringView.h"
+#include <compare>
+#include <string>
+
+namespace cpp
+{
+	// A string of exactly N chars stored inside the object, usable in constant expressions and as a
+	// non-type template parameter:
+	//     template<FixedString Name> struct Field { static constexpr StringView name = Name; };
+	//     Field<"id"> id;
+	//
+	// The length is part of the type, so there is no length field and nothing is ever allocated.
+	// The characters are a public member because the language requires that of a template parameter.
+	template<size_t N>
+	struct FixedString
+	{
+		using value_type = char;
+
+		// The characters, followed by a null-character.
+		char chars[N + 1] = {};
+
+		// Constructs a string of N null-characters.
+		constexpr FixedString() noexcept = default;
+
+		// Copies the characters of the string literal s.
+		constexpr FixedString(const char (&s)[N + 1]) noexcept
+		{
+			std::char_traits<char>::copy(chars, s, N + 1);
+		}
+
+		// Copies the characters of the view sv, throwing a length_error exception if it does not hold exactly N.
+		constexpr explicit FixedString(const StringView sv)
+		{
+			if (sv.size() != N)
+				throw std::length_error("FixedString length mismatch");
+
+			std::char_traits<char>::copy(chars, sv.data(), N);
+		}
+
+		// Returns the number of characters, N.
+		[[nodiscard]] static constexpr size_t size() noexcept
+		{
+			return N;
+		}
+
+		// Returns the number of characters, N.
+		[[nodiscard]] static constexpr size_t length() noexcept
+		{
+			return N;
+		}
+
+		// Returns whether the string is empty (i.e. whether N is 0).
+		[[nodiscard]] static constexpr bool empty() noexcept
+		{
+			return N == 0;
+		}
+
+		// Returns a pointer to the characters, which are followed by a null-character.
+		[[nodiscard]] constexpr const char* data() const noexcept
+		{
+			return chars;
+		}
+
+		// Returns a pointer to the characters, which are followed by a null-character.
+		[[nodiscard]] constexpr char* data() noexcept
+		{
+			return chars;
+		}
+
+		// Returns a pointer to the null-terminated characters.
+		[[nodiscard]] constexpr const char* c_str() const noexcept
+		{
+			return chars;
+		}
+
+		// Returns a reference to the character at position index.
+		constexpr const char& operator[](const size_t index) const noexcept
+		{
+			return chars[index];
+		}
+
+		// Returns a reference to the character at position index.
+		constexpr char& operator[](const size_t index) noexcept
+		{
+			return chars[index];
+		}
+
+		// Returns a view of all the characters.
+		[[nodiscard]] constexpr StringView view() const noexcept
+		{
+			return { chars, N };
+		}
+
+		// Returns a view of all the characters, see view().
+		constexpr operator StringView() const noexcept
+		{
+			return view();
+		}
+
+		// Returns the concatenation of the characters of this string followed by those of rhs.
+		template<size_t M>
+		constexpr FixedString<N + M> operator+(const FixedString<M>& rhs) const noexcept
+		{
+			FixedString<N + M> result;
+			std::char_traits<char>::copy(result.chars, chars, N);
+			std::char_traits<char>::copy(result.chars + N, rhs.chars, M);
+			return result;
+		}
+
+		// Returns whether both strings hold the same characters.
+		template<size_t M>
+		friend constexpr bool operator==(const FixedString& lhs, const FixedString<M>& rhs) noexcept
+		{
+			return lhs.view() == rhs.view();
+		}
+
+		// Returns whether the string holds the same characters as the view.
+		friend constexpr bool operator==(const FixedString& lhs, const StringView rhs) noexcept
+		{
+			return lhs.view() == rhs;
+		}
+
+		// Compares the characters of the string with those of the view, see StringView::compare().
+		friend constexpr std::strong_ordering operator<=>(const FixedString& lhs, const StringView rhs) noexcept
+		{
+			return lhs.view() <=> rhs;
+		}
+
+		using It = Iterator<FixedString, char>;
+		using ConstIt = Iterator<FixedString, const char>;
+
+		constexpr It begin() noexcept
+		{
+			return It(chars);
+		}
+
+		constexpr It end() noexcept
+		{
+			return It(chars + N);
+		}
+
+		[[nodiscard]] constexpr ConstIt begin() const noexcept
+		{
+			return ConstIt(chars);
+		}
+
+		[[nodiscard]] constexpr ConstIt end() const noexcept
+		{
+			return ConstIt(chars + N);
+		}
+	};
+
+	// A string literal of M chars, including its terminator, makes a FixedString of M - 1 characters.
+	template<size_t M>
+	FixedString(const char (&)[M]) -> FixedString<M - 1>;
+}// namespace cpp
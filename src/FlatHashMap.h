@@ -0,0 +1,927 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Hash.h"
+#include "Memory.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <tuple>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPP_FLAT_HASH_MAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define CPP_FLAT_HASH_MAP_SSE2 0
+#endif
+
+namespace cpp
+{
+	namespace detail
+	{
+		// The control byte of a slot: the low 7 bits of the hash of its key when the slot is full, one of
+		// the negative markers below otherwise, so the sign bit alone tells free slots from full ones.
+		using ctrl_t = int8_t;
+
+		inline constexpr ctrl_t ctrl_empty = -128;
+		inline constexpr ctrl_t ctrl_deleted = -2;
+
+		// The number of slots whose control bytes are matched at once, the width of an SSE2 register.
+		inline constexpr size_t group_width = 16;
+
+		// The control bytes of a group of slots, each compared against a value with one instruction.
+		// Every match returns a mask with bit i set for slot i of the group.
+		class SwissGroup
+		{
+		public:
+			explicit SwissGroup(const ctrl_t* ctrl) noexcept
+			{
+#if CPP_FLAT_HASH_MAP_SSE2
+				m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+				std::memcpy(m_ctrl, ctrl, group_width);
+#endif
+			}
+
+			// Returns the full slots whose control byte is h2.
+			[[nodiscard]] uint32_t match(const ctrl_t h2) const noexcept
+			{
+#if CPP_FLAT_HASH_MAP_SSE2
+				return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+#else
+				return match_if([h2](const ctrl_t c) { return c == h2; });
+#endif
+			}
+
+			// Returns the empty slots.
+			[[nodiscard]] uint32_t match_empty() const noexcept
+			{
+				return match(ctrl_empty);
+			}
+
+			// Returns the slots that are empty or deleted, where an entry may be inserted.
+			[[nodiscard]] uint32_t match_free() const noexcept
+			{
+#if CPP_FLAT_HASH_MAP_SSE2
+				return static_cast<uint32_t>(_mm_movemask_epi8(m_ctrl));
+#else
+				return match_if([](const ctrl_t c) { return c < 0; });
+#endif
+			}
+
+		private:
+#if CPP_FLAT_HASH_MAP_SSE2
+			__m128i m_ctrl;
+#else
+			template<typename Predicate>
+			[[nodiscard]] uint32_t match_if(Predicate predicate) const noexcept
+			{
+				uint32_t mask = 0;
+				for (size_t i = 0; i < group_width; ++i)
+					mask |= static_cast<uint32_t>(predicate(m_ctrl[i])) << i;
+
+				return mask;
+			}
+
+			ctrl_t m_ctrl[group_width];
+#endif
+		};
+
+		// Spreads the entropy of a hash over all of its bits. std::hash of an integer is the integer itself,
+		// whose high bits would otherwise pick the same group and whose low bits the same control byte.
+		inline size_t mix_hash(const size_t hash) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			const auto product = static_cast<unsigned __int128>(hash) * 0x9E3779B97F4A7C15ull;
+			return static_cast<size_t>(product) ^ static_cast<size_t>(product >> 64);
+#else
+			auto h = static_cast<uint64_t>(hash);
+			h ^= h >> 32;
+			h *= 0x9E3779B97F4A7C15ull;
+			h ^= h >> 29;
+			return static_cast<size_t>(h);
+#endif
+		}
+	}// namespace detail
+
+	// An unordered map that stores its entries in one flat array of slots with open addressing (a Swiss table).
+	//
+	// Next to the slots sits an array of control bytes, one per slot, holding 7 bits of the hash of the key
+	// in the slot or marking the slot as free. A lookup hashes the key once, then compares those 7 bits
+	// against the control bytes of a group of 16 slots at a time with SSE2, and only compares keys in the
+	// slots that match; a group with an empty slot ends the search. There is no node per entry, so a
+	// successful lookup usually touches one cache line of control bytes and one slot. The table grows
+	// before it is more than 7/8 full.
+	//
+	// With the default cpp::hash and std::equal_to<>, a map with String keys can be searched for a StringView
+	// or a C-string without building a String. Entries move when the table grows, so unlike with
+	// std::unordered_map, an insertion that grows the table invalidates references and iterators;
+	// reserve() ahead of time avoids that.
+	template<typename K, typename V, typename Hash = hash<K>, typename KeyEqual = std::equal_to<>, typename Allocator = std::allocator<std::pair<const K, V>>>
+	class FlatHashMap
+	{
+		using AllocTraits = std::allocator_traits<Allocator>;
+		using CtrlAllocator = typename AllocTraits::template rebind_alloc<detail::ctrl_t>;
+		using CtrlTraits = std::allocator_traits<CtrlAllocator>;
+
+		// Whether keys of other types than K can be looked up without converting them to K.
+		static constexpr bool transparent = requires {
+			typename Hash::is_transparent;
+			typename KeyEqual::is_transparent;
+		};
+
+		// Whether the hashes are already avalanching, so that the table can use them without mixing.
+		static constexpr bool avalanching = requires { typename Hash::is_avalanching; };
+
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		// Returned by a probe() visitor to move on to the next group.
+		static constexpr size_t probe_next = npos - 1;
+
+		template<bool Const>
+		class MapIterator;
+
+	public:
+		using key_type = K;
+		using mapped_type = V;
+		using value_type = std::pair<const K, V>;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using allocator_type = Allocator;
+		using iterator = MapIterator<false>;
+		using const_iterator = MapIterator<true>;
+
+		// The greatest ratio of entries to slots before the table grows.
+		static constexpr float max_load_factor = 0.875f;
+
+		// Constructs an empty map, which allocates nothing.
+		FlatHashMap() = default;
+
+		// Constructs an empty map with room for count entries.
+		explicit FlatHashMap(const size_t count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+			: m_hash(hash), m_equal(equal), m_alloc(alloc)
+		{
+			reserve(count);
+		}
+
+		// Constructs a map with the entries of list. Of entries with equal keys, the first one is kept.
+		FlatHashMap(const std::initializer_list<value_type> list, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+			: FlatHashMap(list.size(), hash, equal, alloc)
+		{
+			for (const auto& entry : list)
+				insert(entry);
+		}
+
+		// Constructs a map with a copy of each of the entries of other.
+		FlatHashMap(const FlatHashMap& other)
+			: m_hash(other.m_hash), m_equal(other.m_equal), m_alloc(AllocTraits::select_on_container_copy_construction(other.m_alloc))
+		{
+			reserve(other.m_size);
+
+			// The keys of other are known to be distinct, so they are placed without comparing any.
+			// The destructor does not run when a constructor throws, so the copies made so far are freed here.
+			try
+			{
+				for (const auto& entry : other)
+					insert_new(hash_of(entry.first), entry);
+			}
+			catch (...)
+			{
+				destroy_entries();
+				deallocate_table(m_ctrl, m_slots, m_capacity);
+				throw;
+			}
+		}
+
+		// Constructs a map that acquires the entries of other, which is left empty.
+		FlatHashMap(FlatHashMap&& other) noexcept
+			: m_hash(std::move(other.m_hash)), m_equal(std::move(other.m_equal)), m_alloc(std::move(other.m_alloc)),
+			  m_ctrl(std::exchange(other.m_ctrl, nullptr)), m_slots(std::exchange(other.m_slots, nullptr)),
+			  m_capacity(std::exchange(other.m_capacity, 0)), m_size(std::exchange(other.m_size, 0)), m_growth_left(std::exchange(other.m_growth_left, 0))
+		{
+		}
+
+		// Destroys the entries and frees the table.
+		~FlatHashMap()
+		{
+			destroy_entries();
+			deallocate_table(m_ctrl, m_slots, m_capacity);
+		}
+
+		// Replaces the entries with copies of those of other.
+		FlatHashMap& operator=(const FlatHashMap& other)
+		{
+			if (this != &other)
+				FlatHashMap(other).swap(*this);
+
+			return *this;
+		}
+
+		// Replaces the entries with those of other, which is left empty.
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept
+		{
+			if (this != &other)
+				FlatHashMap(std::move(other)).swap(*this);
+
+			return *this;
+		}
+
+		// Returns a copy of the allocator object associated with the map.
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return m_alloc;
+		}
+
+		// Returns the function that hashes the keys.
+		[[nodiscard]] hasher hash_function() const
+		{
+			return m_hash;
+		}
+
+		// Returns the function that compares the keys.
+		[[nodiscard]] key_equal key_eq() const
+		{
+			return m_equal;
+		}
+
+		// Returns the number of entries.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		// Returns whether the map holds no entries.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		// Returns the number of slots in the table, a power of two of at least 16, or 0 before the first insertion.
+		[[nodiscard]] size_t capacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		// Returns the ratio of entries to slots.
+		[[nodiscard]] float load_factor() const noexcept
+		{
+			return m_capacity == 0 ? 0.0f : static_cast<float>(m_size) / static_cast<float>(m_capacity);
+		}
+
+		// Requests that count entries fit without the table growing.
+		void reserve(const size_t count)
+		{
+			if (count > m_size + m_growth_left)
+				resize(capacity_for(count));
+		}
+
+		// Rebuilds the table with room for at least count slots and for the current entries, which also
+		// drops the slots of erased entries. rehash(0) shrinks the table to fit, and frees it if the map is empty.
+		void rehash(const size_t count)
+		{
+			const auto new_capacity = std::max(capacity_for(m_size), count == 0 ? 0 : std::bit_ceil(std::max(count, detail::group_width)));
+
+			if (new_capacity != m_capacity || m_size + m_growth_left < max_load(m_capacity))
+				resize(new_capacity);
+		}
+
+		// Removes all entries, leaving the capacity unchanged.
+		void clear() noexcept
+		{
+			destroy_entries();
+			reset_ctrl();
+			m_size = 0;
+		}
+
+		// Returns an iterator to the entry with the given key, or end() if there is none.
+		[[nodiscard]] iterator find(const K& key)
+		{
+			return iterator_at(find_index(key));
+		}
+
+		// Returns an iterator to the entry with the given key, or end() if there is none.
+		[[nodiscard]] const_iterator find(const K& key) const
+		{
+			return iterator_at(find_index(key));
+		}
+
+		// Returns an iterator to the entry whose key equals key, or end() if there is none,
+		// without converting key to K.
+		template<typename Q>
+		requires transparent
+		[[nodiscard]] iterator find(const Q& key)
+		{
+			return iterator_at(find_index(key));
+		}
+
+		// Returns an iterator to the entry whose key equals key, or end() if there is none,
+		// without converting key to K.
+		template<typename Q>
+		requires transparent
+		[[nodiscard]] const_iterator find(const Q& key) const
+		{
+			return iterator_at(find_index(key));
+		}
+
+		// Returns whether there is an entry with the given key.
+		[[nodiscard]] bool contains(const K& key) const
+		{
+			return find_index(key) != npos;
+		}
+
+		// Returns whether there is an entry whose key equals key, without converting key to K.
+		template<typename Q>
+		requires transparent
+		[[nodiscard]] bool contains(const Q& key) const
+		{
+			return find_index(key) != npos;
+		}
+
+		// Returns the number of entries with the given key: 0 or 1.
+		[[nodiscard]] size_t count(const K& key) const
+		{
+			return contains(key) ? 1 : 0;
+		}
+
+		// Returns the number of entries whose key equals key: 0 or 1.
+		template<typename Q>
+		requires transparent
+		[[nodiscard]] size_t count(const Q& key) const
+		{
+			return contains(key) ? 1 : 0;
+		}
+
+		// Returns the value of the entry with the given key,
+		// throwing an out_of_range exception if there is none.
+		V& at(const K& key)
+		{
+			return m_slots[checked_index(key)].second;
+		}
+
+		// Returns the value of the entry with the given key,
+		// throwing an out_of_range exception if there is none.
+		const V& at(const K& key) const
+		{
+			return m_slots[checked_index(key)].second;
+		}
+
+		// Returns the value of the entry whose key equals key, without converting key to K,
+		// throwing an out_of_range exception if there is none.
+		template<typename Q>
+		requires transparent
+		V& at(const Q& key)
+		{
+			return m_slots[checked_index(key)].second;
+		}
+
+		// Returns the value of the entry whose key equals key, without converting key to K,
+		// throwing an out_of_range exception if there is none.
+		template<typename Q>
+		requires transparent
+		const V& at(const Q& key) const
+		{
+			return m_slots[checked_index(key)].second;
+		}
+
+		// Returns the value of the entry with the given key, inserting one with a value-initialized value if there is none.
+		V& operator[](const K& key)
+		{
+			const auto index = try_emplace_index(key).first;
+			return m_slots[index].second;
+		}
+
+		// Returns the value of the entry with the given key, inserting one with a value-initialized value if there is none.
+		V& operator[](K&& key)
+		{
+			const auto index = try_emplace_index(std::move(key)).first;
+			return m_slots[index].second;
+		}
+
+		// Returns the value of the entry whose key equals key, inserting one with a key made from key and a
+		// value-initialized value if there is none. A K is only built when an entry is inserted.
+		template<typename Q>
+		requires transparent && std::constructible_from<K, Q> && (!std::is_same_v<std::remove_cvref_t<Q>, K>)
+		V& operator[](Q&& key)
+		{
+			const auto index = try_emplace_index(std::forward<Q>(key)).first;
+			return m_slots[index].second;
+		}
+
+		// Inserts an entry with the given key and a value constructed from args, if there is no entry with that
+		// key yet. Returns an iterator to the entry with the key, and whether it was inserted.
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			const auto [index, inserted] = try_emplace_index(key, std::forward<Args>(args)...);
+			return { iterator_at(index), inserted };
+		}
+
+		// Inserts an entry with the given key and a value constructed from args, if there is no entry with that
+		// key yet. Returns an iterator to the entry with the key, and whether it was inserted.
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+		{
+			const auto [index, inserted] = try_emplace_index(std::move(key), std::forward<Args>(args)...);
+			return { iterator_at(index), inserted };
+		}
+
+		// Inserts a copy of entry if there is no entry with its key yet.
+		// Returns an iterator to the entry with the key, and whether it was inserted.
+		std::pair<iterator, bool> insert(const value_type& entry)
+		{
+			return try_emplace(entry.first, entry.second);
+		}
+
+		// Inserts entry if there is no entry with its key yet.
+		// Returns an iterator to the entry with the key, and whether it was inserted.
+		std::pair<iterator, bool> insert(value_type&& entry)
+		{
+			return try_emplace(entry.first, std::move(entry.second));
+		}
+
+		// Inserts an entry constructed from args if there is no entry with its key yet.
+		// Returns an iterator to the entry with the key, and whether it was inserted.
+		template<typename... Args>
+		std::pair<iterator, bool> emplace(Args&&... args)
+		{
+			value_type entry(std::forward<Args>(args)...);
+
+			const auto hash = hash_of(entry.first);
+			if (const auto index = find_index(entry.first, hash); index != npos)
+				return { iterator_at(index), false };
+
+			return { iterator_at(insert_new(hash, std::move(entry))), true };
+		}
+
+		// Assigns value to the entry with the given key, or inserts an entry if there is none.
+		// Returns an iterator to the entry with the key, and whether it was inserted.
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(const K& key, M&& value)
+		{
+			const auto [index, inserted] = try_emplace_index(key, std::forward<M>(value));
+			if (!inserted)
+				m_slots[index].second = std::forward<M>(value);
+
+			return { iterator_at(index), inserted };
+		}
+
+		// Assigns value to the entry with the given key, or inserts an entry if there is none.
+		// Returns an iterator to the entry with the key, and whether it was inserted.
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(K&& key, M&& value)
+		{
+			const auto [index, inserted] = try_emplace_index(std::move(key), std::forward<M>(value));
+			if (!inserted)
+				m_slots[index].second = std::forward<M>(value);
+
+			return { iterator_at(index), inserted };
+		}
+
+		// Removes the entry with the given key, if any. Returns the number of entries removed: 0 or 1.
+		size_t erase(const K& key)
+		{
+			return erase_key(key);
+		}
+
+		// Removes the entry whose key equals key, if any, without converting key to K.
+		// Returns the number of entries removed: 0 or 1.
+		template<typename Q>
+		requires transparent && (!std::is_convertible_v<const Q&, const_iterator>)
+		size_t erase(const Q& key)
+		{
+			return erase_key(key);
+		}
+
+		// Removes the entry at pos and returns an iterator to the entry that followed it. No other entry moves.
+		iterator erase(const const_iterator pos)
+		{
+			const auto index = static_cast<size_t>(pos.m_ctrl - m_ctrl);
+			erase_index(index);
+
+			return iterator(m_ctrl + index, m_slots + index, m_ctrl + m_capacity).skip_free();
+		}
+
+		// Removes the entry at pos and returns an iterator to the entry that followed it. No other entry moves.
+		iterator erase(const iterator pos)
+		{
+			return erase(const_iterator(pos));
+		}
+
+		// Exchanges the entries of the two maps.
+		// The allocators are exchanged only if the allocator type propagates on swap.
+		void swap(FlatHashMap& other) noexcept
+		{
+			using std::swap;
+
+			if constexpr (AllocTraits::propagate_on_container_swap::value)
+				swap(m_alloc, other.m_alloc);
+
+			swap(m_hash, other.m_hash);
+			swap(m_equal, other.m_equal);
+			swap(m_ctrl, other.m_ctrl);
+			swap(m_slots, other.m_slots);
+			swap(m_capacity, other.m_capacity);
+			swap(m_size, other.m_size);
+			swap(m_growth_left, other.m_growth_left);
+		}
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator(m_ctrl, m_slots, m_ctrl + m_capacity).skip_free();
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator_at(npos);
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator(m_ctrl, m_slots, m_ctrl + m_capacity).skip_free();
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return iterator_at(npos);
+		}
+
+	private:
+		// A forward iterator over the full slots, in table order.
+		template<bool Const>
+		class MapIterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = FlatHashMap::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+			using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+			MapIterator() = default;
+
+			// Converts an iterator into a const iterator to the same entry.
+			template<bool OtherConst>
+			requires(Const && !OtherConst)
+			MapIterator(const MapIterator<OtherConst>& other) noexcept
+				: m_ctrl(other.m_ctrl), m_slot(other.m_slot), m_end(other.m_end)
+			{
+			}
+
+			reference operator*() const noexcept
+			{
+				return *m_slot;
+			}
+
+			pointer operator->() const noexcept
+			{
+				return m_slot;
+			}
+
+			MapIterator& operator++() noexcept
+			{
+				++m_ctrl;
+				++m_slot;
+				return skip_free();
+			}
+
+			MapIterator operator++(int) noexcept
+			{
+				auto copy = *this;
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const MapIterator& lhs, const MapIterator& rhs) noexcept
+			{
+				return lhs.m_ctrl == rhs.m_ctrl;
+			}
+
+		private:
+			friend class FlatHashMap;
+			friend class MapIterator<true>;
+
+			MapIterator(const detail::ctrl_t* ctrl, pointer slot, const detail::ctrl_t* end) noexcept
+				: m_ctrl(ctrl), m_slot(slot), m_end(end)
+			{
+			}
+
+			// Moves forward to the first full slot at or after the current one, or to the end.
+			MapIterator& skip_free() noexcept
+			{
+				while (m_ctrl != m_end && *m_ctrl < 0)
+				{
+					++m_ctrl;
+					++m_slot;
+				}
+
+				return *this;
+			}
+
+			const detail::ctrl_t* m_ctrl = nullptr;
+			pointer m_slot = nullptr;
+			const detail::ctrl_t* m_end = nullptr;
+		};
+
+		// Returns the greatest number of entries and deleted slots a table of capacity slots may hold.
+		static constexpr size_t max_load(const size_t capacity) noexcept
+		{
+			return capacity - capacity / 8;
+		}
+
+		// Returns the smallest capacity whose table holds count entries.
+		static constexpr size_t capacity_for(const size_t count) noexcept
+		{
+			if (count == 0)
+				return 0;
+
+			return std::bit_ceil(std::max(detail::group_width, (count * 8 + 6) / 7));
+		}
+
+		template<typename Q>
+		[[nodiscard]] size_t hash_of(const Q& key) const
+		{
+			if constexpr (avalanching)
+				return m_hash(key);
+			else
+				return detail::mix_hash(m_hash(key));
+		}
+
+		template<typename It>
+		[[nodiscard]] It iterator_at(const size_t index) const noexcept
+		{
+			const auto i = index == npos ? m_capacity : index;
+			return It(m_ctrl + i, m_slots + i, m_ctrl + m_capacity);
+		}
+
+		[[nodiscard]] iterator iterator_at(const size_t index) noexcept
+		{
+			return iterator_at<iterator>(index);
+		}
+
+		[[nodiscard]] const_iterator iterator_at(const size_t index) const noexcept
+		{
+			return iterator_at<const_iterator>(index);
+		}
+
+		// Calls visit(first slot of group, group) for the groups on the probe sequence of hash until it returns
+		// something other than probe_next, and returns that. The high bits of the hash pick the first group,
+		// then triangular steps over the power-of-two count of groups visit every group once, so a group
+		// with a free slot is always reached.
+		template<typename Visit>
+		size_t probe(const size_t hash, Visit&& visit) const
+		{
+			const auto mask = m_capacity / detail::group_width - 1;
+			auto group = (hash >> 7) & mask;
+
+			for (size_t step = 1;; ++step)
+			{
+				const auto first = group * detail::group_width;
+				if (const auto index = visit(first, detail::SwissGroup(m_ctrl + first)); index != probe_next)
+					return index;
+
+				group = (group + step) & mask;
+			}
+		}
+
+		// Returns the index of the slot holding key, or npos.
+		template<typename Q>
+		[[nodiscard]] size_t find_index(const Q& key, const size_t hash) const
+		{
+			if (m_capacity == 0)
+				return npos;
+
+			const auto h2 = static_cast<detail::ctrl_t>(hash & 0x7F);
+
+			return probe(hash, [&](const size_t first, const detail::SwissGroup group) {
+				for (auto matches = group.match(h2); matches != 0; matches &= matches - 1)
+				{
+					const auto index = first + std::countr_zero(matches);
+					if (m_equal(m_slots[index].first, key))
+						return index;
+				}
+
+				// A key is never placed past a group with an empty slot.
+				return group.match_empty() != 0 ? npos : probe_next;
+			});
+		}
+
+		template<typename Q>
+		[[nodiscard]] size_t find_index(const Q& key) const
+		{
+			return find_index(key, hash_of(key));
+		}
+
+		template<typename Q>
+		[[nodiscard]] size_t checked_index(const Q& key) const
+		{
+			const auto index = find_index(key);
+			if (index == npos)
+				throw std::out_of_range("FlatHashMap key not found");
+
+			return index;
+		}
+
+		// Returns the first free slot on the probe sequence of hash. The table must have one.
+		[[nodiscard]] size_t find_free_slot(const size_t hash) const
+		{
+			return probe(hash, [](const size_t first, const detail::SwissGroup group) {
+				const auto free = group.match_free();
+				return free != 0 ? first + std::countr_zero(free) : probe_next;
+			});
+		}
+
+		template<typename Q, typename... Args>
+		std::pair<size_t, bool> try_emplace_index(Q&& key, Args&&... args)
+		{
+			const auto hash = hash_of(key);
+			if (const auto index = find_index(key, hash); index != npos)
+				return { index, false };
+
+			return { insert_new(hash, std::piecewise_construct, std::forward_as_tuple(std::forward<Q>(key)), std::forward_as_tuple(std::forward<Args>(args)...)), true };
+		}
+
+		// Inserts an entry constructed from args, whose key has the given hash and is not in the map yet,
+		// and returns its slot. An empty slot is only taken while the table has growth left, so that
+		// probes always end; a deleted slot can always be reused.
+		template<typename... Args>
+		size_t insert_new(const size_t hash, Args&&... args)
+		{
+			auto index = m_capacity == 0 ? npos : find_free_slot(hash);
+
+			if (index == npos || (m_growth_left == 0 && m_ctrl[index] != detail::ctrl_deleted))
+			{
+				// args may refer to entries of this map, which move when it grows, so the entry is built first.
+				value_type entry(std::forward<Args>(args)...);
+				grow();
+
+				index = find_free_slot(hash);
+				AllocTraits::construct(m_alloc, m_slots + index, std::move(entry));
+			}
+			else
+			{
+				AllocTraits::construct(m_alloc, m_slots + index, std::forward<Args>(args)...);
+			}
+
+			if (m_ctrl[index] == detail::ctrl_empty)
+				--m_growth_left;
+
+			m_ctrl[index] = static_cast<detail::ctrl_t>(hash & 0x7F);
+			++m_size;
+			return index;
+		}
+
+		template<typename Q>
+		size_t erase_key(const Q& key)
+		{
+			const auto index = find_index(key);
+			if (index == npos)
+				return 0;
+
+			erase_index(index);
+			return 1;
+		}
+
+		// Destroys the entry in the slot at index. A probe never goes past a group with an empty slot, so when
+		// the group of the slot has one, no key depends on this slot being taken and it becomes empty again;
+		// otherwise it is marked deleted, and only a rehash gets it back for empty-slot accounting.
+		void erase_index(const size_t index)
+		{
+			AllocTraits::destroy(m_alloc, m_slots + index);
+			--m_size;
+
+			if (detail::SwissGroup(m_ctrl + (index & ~(detail::group_width - 1))).match_empty() != 0)
+			{
+				m_ctrl[index] = detail::ctrl_empty;
+				++m_growth_left;
+			}
+			else
+			{
+				m_ctrl[index] = detail::ctrl_deleted;
+			}
+		}
+
+		// Makes room for one more entry: rebuilds the table in place when deleted slots are what fills it,
+		// otherwise doubles it.
+		void grow()
+		{
+			if (m_capacity != 0 && m_size * 32 <= max_load(m_capacity) * 25)
+				resize(m_capacity);
+			else
+				resize(std::max(detail::group_width, m_capacity * 2));
+		}
+
+		// Moves every entry into a new table of new_capacity slots, which must hold them, and frees the old one.
+		// The new table is filled while a local map holds it and only taken over once every entry is in it, so
+		// if copying an entry throws, this map keeps its table and the local one frees the copies made so far.
+		void resize(const size_t new_capacity)
+		{
+			FlatHashMap table(0, m_hash, m_equal, m_alloc);
+			table.allocate_table(new_capacity);
+
+			for (size_t i = 0; i < m_capacity; ++i)
+			{
+				if (m_ctrl[i] < 0)
+					continue;
+
+				const auto hash = hash_of(m_slots[i].first);
+				const auto index = table.find_free_slot(hash);
+
+				transfer_entry(m_slots + i, table.m_slots + index);
+				table.m_ctrl[index] = static_cast<detail::ctrl_t>(hash & 0x7F);
+				++table.m_size;
+			}
+
+			table.m_growth_left -= m_size;
+
+			// The entries copied byte for byte now belong to the new table, so the old one must not destroy them.
+			if constexpr (relocates_bytewise)
+				reset_ctrl();
+
+			// The old table ends up in the local map, which destroys what is left of its entries and frees it.
+			swap(table);
+		}
+
+		static constexpr bool relocates_bytewise = is_trivially_relocatable_v<K> && is_trivially_relocatable_v<V>;
+
+		// Moves an entry into an uninitialized slot of another table, or copies it if moving may throw and it can be
+		// copied. The source is left in place; when the entry is copied byte for byte, it no longer owns anything.
+		void transfer_entry(value_type* src, value_type* dst)
+		{
+			if constexpr (relocates_bytewise)
+				std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(value_type));
+			else
+				AllocTraits::construct(m_alloc, dst, std::move_if_noexcept(*src));
+		}
+
+		// Allocates an empty table of capacity slots in place of the current one, which is not freed.
+		void allocate_table(const size_t capacity)
+		{
+			detail::ctrl_t* ctrl = nullptr;
+			value_type* slots = nullptr;
+
+			if (capacity != 0)
+			{
+				CtrlAllocator ctrl_alloc(m_alloc);
+				ctrl = CtrlTraits::allocate(ctrl_alloc, capacity);
+
+				try
+				{
+					slots = AllocTraits::allocate(m_alloc, capacity);
+				}
+				catch (...)
+				{
+					CtrlTraits::deallocate(ctrl_alloc, ctrl, capacity);
+					throw;
+				}
+			}
+
+			m_ctrl = ctrl;
+			m_slots = slots;
+			m_capacity = capacity;
+			reset_ctrl();
+		}
+
+		void deallocate_table(detail::ctrl_t* ctrl, value_type* slots, const size_t capacity) noexcept
+		{
+			if (capacity == 0)
+				return;
+
+			CtrlAllocator ctrl_alloc(m_alloc);
+			CtrlTraits::deallocate(ctrl_alloc, ctrl, capacity);
+			AllocTraits::deallocate(m_alloc, slots, capacity);
+		}
+
+		// Marks every slot empty.
+		void reset_ctrl() noexcept
+		{
+			if (m_capacity != 0)
+				std::memset(m_ctrl, static_cast<unsigned char>(detail::ctrl_empty), m_capacity);
+
+			m_growth_left = max_load(m_capacity);
+		}
+
+		void destroy_entries() noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<value_type>)
+			{
+				for (size_t i = 0; i < m_capacity; ++i)
+					if (m_ctrl[i] >= 0)
+						AllocTraits::destroy(m_alloc, m_slots + i);
+			}
+		}
+
+		[[no_unique_address]] Hash m_hash{};
+		[[no_unique_address]] KeyEqual m_equal{};
+		[[no_unique_address]] Allocator m_alloc{};
+		detail::ctrl_t* m_ctrl = nullptr;
+		value_type* m_slots = nullptr;
+		size_t m_capacity = 0;
+		size_t m_size = 0;
+
+		// The number of empty slots that may still be filled before the table has to grow.
+		size_t m_growth_left = 0;
+	};
+}// namespace cpp
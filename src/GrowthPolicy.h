@@ -0,0 +1,55 @@
+#pragma once
+
+#include "pch.h"
+
+#include <concepts>
+
+// Growth policies decide how much capacity Vector and String ask for when they run out of room.
+//
+// A policy is a type with a static next_capacity(capacity, required) that returns the new capacity,
+// at least required, for a container that has capacity elements and needs room for required ones.
+// Geometric growth keeps appends amortized O(1); a smaller factor wastes less memory at the cost of
+// moving the elements more often.
+namespace cpp::growth
+{
+	// Doubles the capacity (plus one, so that an empty container gets room for one element).
+	// Appending n elements moves each of them about once; up to half the capacity may be unused.
+	struct Doubling {
+		static constexpr bool round_to_size_class = false;
+
+		static constexpr size_t next_capacity(const size_t capacity, const size_t required) noexcept
+		{
+			return std::max(required, 2 * capacity + 1);
+		}
+	};
+
+	// Grows the capacity by half. Appending n elements moves each of them about twice, but at most a
+	// third of the capacity is unused, and freed blocks can eventually be reused for a later growth.
+	struct OneAndHalf {
+		static constexpr bool round_to_size_class = false;
+
+		static constexpr size_t next_capacity(const size_t capacity, const size_t required) noexcept
+		{
+			return std::max(required, capacity + capacity / 2 + 1);
+		}
+	};
+
+	// Grows like Base, then takes whatever extra room the allocator handed out on top of the request:
+	// malloc rounds every block up to one of its size classes, and the difference would otherwise sit
+	// unused until the next growth. Needs an allocator that reports usable sizes, such as MallocAllocator.
+	template<typename Base = Doubling>
+	struct SizeClass {
+		static constexpr bool round_to_size_class = true;
+
+		static constexpr size_t next_capacity(const size_t capacity, const size_t required) noexcept
+		{
+			return Base::next_capacity(capacity, required);
+		}
+	};
+
+	template<typename Policy>
+	concept GrowthPolicy = requires(size_t n) {
+		{ Policy::next_capacity(n, n) } -> std::same_as<size_t>;
+		{ Policy::round_to_size_class } -> std::convertible_to<bool>;
+	};
+}// namespace cpp::growth
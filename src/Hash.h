@@ -0,0 +1,314 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Search.h"
+#include "String.h"
+#include "StringView.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+// A 64-bit hash for byte strings in the wyhash family.
+//
+// Up to 16 bytes are read with at most four overlapping loads and mixed with two 64x64->128 bit
+// multiplications. Longer inputs are consumed 16 or 48 bytes per round, in three independent
+// multiplication chains. Beyond 256 bytes, 64-byte stripes go into eight 64-bit accumulators with
+// 32x32->64 bit multiplications, which vectorize: AVX2 or SSE2 is picked on first use like the kernels
+// in Search.h, and every kernel computes the same value. The hash is meant for hash tables in one
+// process: it is not cryptographic, and it is not stable across library versions or byte orders.
+namespace cpp::hashing
+{
+	namespace detail
+	{
+		inline constexpr uint64_t secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+		// The key the stripes of long inputs are combined with, one word per accumulator.
+		inline constexpr uint64_t stripe_secret[8] = {
+			0x9e3779b97f4a7c15ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull, 0x85ebca77c2b2ae63ull,
+			0x27d4eb2f165667c5ull, 0x94d049bb133111ebull, 0xbf58476d1ce4e5b9ull, 0xff51afd7ed558ccdull
+		};
+
+		// The accumulators are scrambled after every block of this many stripes, so that the high bits
+		// of the products, which the additions never carry down, are folded back in.
+		inline constexpr size_t stripes_per_block = 16;
+		inline constexpr uint64_t scramble_prime = 0x9e3779b1u;
+
+		// Inputs longer than this go through the striped accumulators.
+		inline constexpr size_t stripe_threshold = 256;
+
+		// Multiplies a by b into 128 bits, leaving the low half in a and the high half in b.
+		inline void multiply(uint64_t& a, uint64_t& b) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			const auto product = static_cast<unsigned __int128>(a) * b;
+			a = static_cast<uint64_t>(product);
+			b = static_cast<uint64_t>(product >> 64);
+#else
+			const uint64_t a_high = a >> 32, a_low = static_cast<uint32_t>(a);
+			const uint64_t b_high = b >> 32, b_low = static_cast<uint32_t>(b);
+			const uint64_t high = a_high * b_high, middle0 = a_high * b_low, middle1 = b_high * a_low, low = a_low * b_low;
+
+			const uint64_t t = low + (middle0 << 32);
+			uint64_t carry = t < low;
+			const uint64_t result_low = t + (middle1 << 32);
+			carry += result_low < t;
+
+			a = result_low;
+			b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+		}
+
+		// Multiplies a by b and folds the 128-bit product into 64 bits.
+		inline uint64_t mix(uint64_t a, uint64_t b) noexcept
+		{
+			multiply(a, b);
+			return a ^ b;
+		}
+
+		inline uint64_t read64(const unsigned char* p) noexcept
+		{
+			uint64_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		inline uint64_t read32(const unsigned char* p) noexcept
+		{
+			uint32_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+	}// namespace detail
+
+	// Each kernel adds `stripes` 64-byte stripes starting at p into the eight accumulators: for word j of a
+	// stripe, acc[j] += the other word of its pair + low32(word ^ key) * high32(word ^ key). After each
+	// block of stripes_per_block stripes, counted from p, every accumulator is scrambled.
+	namespace scalar
+	{
+		inline void accumulate(uint64_t (&acc)[8], const unsigned char* p, const size_t stripes) noexcept
+		{
+			for (size_t n = 1; n <= stripes; ++n, p += 64)
+			{
+				for (size_t j = 0; j < 8; ++j)
+				{
+					const auto key = detail::read64(p + 8 * j) ^ detail::stripe_secret[j];
+					acc[j] += detail::read64(p + 8 * (j ^ 1)) + (key & 0xffffffffu) * (key >> 32);
+				}
+
+				if (n % detail::stripes_per_block == 0)
+				{
+					for (size_t j = 0; j < 8; ++j)
+						acc[j] = ((acc[j] ^ (acc[j] >> 47)) ^ detail::stripe_secret[j]) * detail::scramble_prime;
+				}
+			}
+		}
+	}// namespace scalar
+
+#if CPP_SEARCH_X86
+	namespace sse2
+	{
+		CPP_SEARCH_TARGET("sse2")
+		inline void accumulate(uint64_t (&acc)[8], const unsigned char* p, const size_t stripes) noexcept
+		{
+			__m128i sums[4], keys[4];
+			for (size_t m = 0; m < 4; ++m)
+			{
+				sums[m] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2 * m));
+				keys[m] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(detail::stripe_secret + 2 * m));
+			}
+
+			const auto prime = _mm_set1_epi32(static_cast<int>(detail::scramble_prime));
+
+			for (size_t n = 1; n <= stripes; ++n, p += 64)
+			{
+				for (size_t m = 0; m < 4; ++m)
+				{
+					const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * m));
+					const auto key = _mm_xor_si128(data, keys[m]);
+					const auto product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(2, 3, 0, 1)));
+					const auto swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+					sums[m] = _mm_add_epi64(sums[m], _mm_add_epi64(product, swapped));
+				}
+
+				if (n % detail::stripes_per_block == 0)
+				{
+					for (size_t m = 0; m < 4; ++m)
+					{
+						const auto x = _mm_xor_si128(_mm_xor_si128(sums[m], _mm_srli_epi64(sums[m], 47)), keys[m]);
+						const auto low = _mm_mul_epu32(x, prime);
+						const auto high = _mm_mul_epu32(_mm_srli_epi64(x, 32), prime);
+						sums[m] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+					}
+				}
+			}
+
+			for (size_t m = 0; m < 4; ++m)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * m), sums[m]);
+		}
+	}// namespace sse2
+
+	namespace avx2
+	{
+		// The 32-byte wide version of sse2::accumulate().
+		CPP_SEARCH_TARGET("avx2")
+		inline void accumulate(uint64_t (&acc)[8], const unsigned char* p, const size_t stripes) noexcept
+		{
+			__m256i sums[2], keys[2];
+			for (size_t m = 0; m < 2; ++m)
+			{
+				sums[m] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4 * m));
+				keys[m] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(detail::stripe_secret + 4 * m));
+			}
+
+			const auto prime = _mm256_set1_epi32(static_cast<int>(detail::scramble_prime));
+
+			for (size_t n = 1; n <= stripes; ++n, p += 64)
+			{
+				for (size_t m = 0; m < 2; ++m)
+				{
+					const auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * m));
+					const auto key = _mm256_xor_si256(data, keys[m]);
+					const auto product = _mm256_mul_epu32(key, _mm256_shuffle_epi32(key, _MM_SHUFFLE(2, 3, 0, 1)));
+					const auto swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+					sums[m] = _mm256_add_epi64(sums[m], _mm256_add_epi64(product, swapped));
+				}
+
+				if (n % detail::stripes_per_block == 0)
+				{
+					for (size_t m = 0; m < 2; ++m)
+					{
+						const auto x = _mm256_xor_si256(_mm256_xor_si256(sums[m], _mm256_srli_epi64(sums[m], 47)), keys[m]);
+						const auto low = _mm256_mul_epu32(x, prime);
+						const auto high = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), prime);
+						sums[m] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+					}
+				}
+			}
+
+			for (size_t m = 0; m < 2; ++m)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4 * m), sums[m]);
+		}
+	}// namespace avx2
+#endif
+
+	namespace detail
+	{
+		inline void accumulate(uint64_t (&acc)[8], const unsigned char* p, const size_t stripes) noexcept
+		{
+#if CPP_SEARCH_X86
+			if (search::detail::cpu_features().avx2)
+				return avx2::accumulate(acc, p, stripes);
+			return sse2::accumulate(acc, p, stripes);
+#else
+			return scalar::accumulate(acc, p, stripes);
+#endif
+		}
+	}// namespace detail
+
+	// Returns the 64-bit hash of the size bytes at data. Different seeds give unrelated hash functions.
+	inline uint64_t hash_bytes(const void* data, const size_t size, uint64_t seed = 0) noexcept
+	{
+		using namespace detail;
+
+		auto p = static_cast<const unsigned char*>(data);
+		seed ^= mix(seed ^ secret[0], secret[1]);
+
+		uint64_t a = 0, b = 0;
+		if (size <= 16)
+		{
+			if (size >= 4)
+			{
+				const auto quarter = (size >> 3) << 2;
+				a = (read32(p) << 32) | read32(p + quarter);
+				b = (read32(p + size - 4) << 32) | read32(p + size - 4 - quarter);
+			}
+			else if (size > 0)
+			{
+				a = (uint64_t{ p[0] } << 16) | (uint64_t{ p[size >> 1] } << 8) | p[size - 1];
+			}
+		}
+		else
+		{
+			auto rest = size;
+			if (rest > stripe_threshold)
+			{
+				// Leave 1 to 64 bytes for the rounds below.
+				const auto stripes = (rest - 1) / 64;
+				uint64_t acc[8];
+				for (size_t j = 0; j < 8; ++j)
+					acc[j] = stripe_secret[j] ^ seed;
+
+				detail::accumulate(acc, p, stripes);
+				p += stripes * 64;
+				rest -= stripes * 64;
+
+				seed = mix(acc[0] ^ secret[1], acc[1] ^ seed) ^ mix(acc[2] ^ secret[2], acc[3] ^ seed)
+				       ^ mix(acc[4] ^ secret[3], acc[5] ^ seed) ^ mix(acc[6] ^ secret[0], acc[7] ^ seed);
+			}
+
+			if (rest > 48)
+			{
+				auto seed1 = seed, seed2 = seed;
+				do
+				{
+					seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+					seed1 = mix(read64(p + 16) ^ secret[2], read64(p + 24) ^ seed1);
+					seed2 = mix(read64(p + 32) ^ secret[3], read64(p + 40) ^ seed2);
+					p += 48;
+					rest -= 48;
+				} while (rest > 48);
+
+				seed ^= seed1 ^ seed2;
+			}
+
+			while (rest > 16)
+			{
+				seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+				p += 16;
+				rest -= 16;
+			}
+
+			// The last 16 bytes of the input, which may overlap bytes already consumed.
+			a = read64(p + rest - 16);
+			b = read64(p + rest - 8);
+		}
+
+		a ^= secret[1];
+		b ^= seed;
+		multiply(a, b);
+		return mix(a ^ secret[0] ^ size, b ^ secret[1]);
+	}
+}// namespace cpp::hashing
+
+namespace cpp
+{
+	// The hash function FlatHashMap uses by default: std::hash for every type but the string types.
+	template<typename T>
+	struct hash : std::hash<T> {
+	};
+
+	// Hashes the characters of a string with hashing::hash_bytes(). It is transparent: a StringView,
+	// a C-string and a String with the same characters hash alike, so a map with String keys can be
+	// searched for any of them without building a String. Its hashes are avalanching: every bit depends
+	// on every input bit, so hash tables use them as they are.
+	template<>
+	struct hash<StringView> {
+		using is_transparent = void;
+		using is_avalanching = void;
+
+		[[nodiscard]] size_t operator()(const StringView sv) const noexcept
+		{
+			return static_cast<size_t>(hashing::hash_bytes(sv.data(), sv.size()));
+		}
+
+		[[nodiscard]] size_t operator()(const char* s) const noexcept
+		{
+			return (*this)(StringView(s));
+		}
+	};
+
+	template<typename Allocator, typename GrowthPolicy>
+	struct hash<BasicString<Allocator, GrowthPolicy>> : hash<StringView> {
+	};
+}// namespace cpp
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Hash.h"
+#include "String.h"
+#include "StringView.h"
+#include <compare>
+#include <ostream>
+#include <utility>
+
+namespace cpp
+{
+	// A String that remembers its hash, for keys that are looked up or rehashed many times.
+	//
+	// The hash is computed by the first call to hash() and kept until the characters change: every
+	// member that modifies them forgets it. There is therefore no mutable access to single characters.
+	// Since hash() updates the cache, a HashedString shared between threads must be hashed before it is shared.
+	//
+	// It hashes like the String and the StringView with the same characters, so a FlatHashMap with
+	// HashedString keys can be searched for either; a probe key that is a HashedString is not hashed
+	// again, and growing the table does not hash its keys again. Two hashed HashedStrings with different
+	// hashes compare unequal without looking at their characters.
+	class HashedString
+	{
+	public:
+		using ConstIt = String::ConstIt;
+
+		HashedString() = default;
+
+		HashedString(const char* s)
+			: m_str(s)
+		{
+		}
+
+		HashedString(const char* s, const size_t n)
+			: m_str(s, n)
+		{
+		}
+
+		explicit HashedString(const StringView sv)
+			: m_str(sv)
+		{
+		}
+
+		explicit HashedString(String str) noexcept
+			: m_str(std::move(str))
+		{
+		}
+
+		HashedString(const HashedString& other) = default;
+
+		// Takes the characters and the hash of other, which is left empty and unhashed.
+		HashedString(HashedString&& other) noexcept
+			: m_str(std::move(other.m_str)), m_hash(other.m_hash), m_hashed(std::exchange(other.m_hashed, false))
+		{
+		}
+
+		HashedString& operator=(const HashedString& other) = default;
+
+		HashedString& operator=(HashedString&& other) noexcept
+		{
+			m_str = std::move(other.m_str);
+			m_hash = other.m_hash;
+			m_hashed = std::exchange(other.m_hashed, false);
+			return *this;
+		}
+
+		// Returns the hash of the characters, computing it if it is not known yet.
+		[[nodiscard]] size_t hash() const noexcept
+		{
+			if (!m_hashed)
+			{
+				m_hash = cpp::hash<StringView>()(m_str);
+				m_hashed = true;
+			}
+
+			return m_hash;
+		}
+
+		// Returns whether the hash is known.
+		[[nodiscard]] bool is_hashed() const noexcept
+		{
+			return m_hashed;
+		}
+
+		[[nodiscard]] const String& str() const noexcept
+		{
+			return m_str;
+		}
+
+		[[nodiscard]] StringView view() const noexcept
+		{
+			return m_str.view();
+		}
+
+		operator StringView() const noexcept
+		{
+			return m_str.view();
+		}
+
+		[[nodiscard]] const char* c_str() const
+		{
+			return m_str.c_str();
+		}
+
+		[[nodiscard]] const char* data() const
+		{
+			return m_str.data();
+		}
+
+		[[nodiscard]] size_t size() const
+		{
+			return m_str.size();
+		}
+
+		[[nodiscard]] size_t length() const
+		{
+			return m_str.length();
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return m_str.empty();
+		}
+
+		const char& operator[](const size_t index) const
+		{
+			return m_str[index];
+		}
+
+		[[nodiscard]] const char& at(const size_t pos) const
+		{
+			return m_str.at(pos);
+		}
+
+		[[nodiscard]] ConstIt begin() const
+		{
+			return m_str.begin();
+		}
+
+		[[nodiscard]] ConstIt end() const
+		{
+			return m_str.end();
+		}
+
+		// Releases the String, leaving this one empty.
+		[[nodiscard]] String release() noexcept
+		{
+			forget_hash();
+			return std::move(m_str);
+		}
+
+		HashedString& operator=(const char* s)
+		{
+			m_str = s;
+			forget_hash();
+			return *this;
+		}
+
+		HashedString& operator=(const StringView sv)
+		{
+			m_str = String(sv);
+			forget_hash();
+			return *this;
+		}
+
+		HashedString& append(const StringView sv)
+		{
+			m_str.append(sv);
+			forget_hash();
+			return *this;
+		}
+
+		HashedString& append(const char* s, const size_t n)
+		{
+			m_str.append(s, n);
+			forget_hash();
+			return *this;
+		}
+
+		HashedString& append(const size_t n, const char c)
+		{
+			m_str.append(n, c);
+			forget_hash();
+			return *this;
+		}
+
+		void push_back(const char c)
+		{
+			m_str.push_back(c);
+			forget_hash();
+		}
+
+		HashedString& replace(const size_t pos, const size_t len, const StringView substr)
+		{
+			m_str.replace(pos, len, substr);
+			forget_hash();
+			return *this;
+		}
+
+		void resize(const size_t n, const char c = '\0')
+		{
+			m_str.resize(n, c);
+			forget_hash();
+		}
+
+		void clear()
+		{
+			m_str.clear();
+			forget_hash();
+		}
+
+		// Changes the capacity only, so the hash stays.
+		void reserve(const size_t n = 0)
+		{
+			m_str.reserve(n);
+		}
+
+		// Changes the capacity only, so the hash stays.
+		void shrink_to_fit()
+		{
+			m_str.shrink_to_fit();
+		}
+
+		friend bool operator==(const HashedString& lhs, const HashedString& rhs)
+		{
+			if (lhs.m_hashed && rhs.m_hashed && lhs.m_hash != rhs.m_hash)
+				return false;
+
+			return lhs.view() == rhs.view();
+		}
+
+		friend bool operator==(const HashedString& lhs, const StringView rhs)
+		{
+			return lhs.view() == rhs;
+		}
+
+		friend bool operator==(const HashedString& lhs, const String& rhs)
+		{
+			return lhs.view() == rhs.view();
+		}
+
+		friend bool operator==(const HashedString& lhs, const char* rhs)
+		{
+			return lhs.view() == StringView(rhs);
+		}
+
+		friend std::strong_ordering operator<=>(const HashedString& lhs, const StringView rhs)
+		{
+			return lhs.view() <=> rhs;
+		}
+
+		friend std::ostream& operator<<(std::ostream& os, const HashedString& s)
+		{
+			return os << s.view();
+		}
+
+	private:
+		void forget_hash() noexcept
+		{
+			m_hashed = false;
+		}
+
+		String m_str;
+		mutable size_t m_hash = 0;
+		mutable bool m_hashed = false;
+	};
+
+	template<>
+	struct is_trivially_relocatable<HashedString> : is_trivially_relocatable<String> {
+	};
+
+	// Returns the cached hash of a HashedString, and hashes other strings like hash<StringView>.
+	template<>
+	struct hash<HashedString> : hash<StringView> {
+		using hash<StringView>::operator();
+
+		[[nodiscard]] size_t operator()(const HashedString& s) const noexcept
+		{
+			return s.hash();
+		}
+	};
+}// namespace cpp
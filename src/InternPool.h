@@ -0,0 +1,416 @@
+#pragma once
+
+#include "pch.h"
+
+#include "ConcurrentVector.h"
+#include "FlatHashMap.h"
+#include "Hash.h"
+#include "Memory.h"
+#include "StringView.h"
+#include "Vector.h"
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+
+namespace cpp
+{
+	// A handle to a string interned in an InternPool: 4 bytes, compared and hashed as an integer.
+	// The default Symbol stands for the empty string, which every pool interns first.
+	// Symbols are only meaningful to the pool that made them.
+	class Symbol
+	{
+	public:
+		constexpr Symbol() = default;
+
+		constexpr explicit Symbol(const uint32_t id) noexcept
+			: m_id(id)
+		{
+		}
+
+		// Returns the number of the symbol in its pool: symbols are numbered from 0 in the order they were interned.
+		[[nodiscard]] constexpr uint32_t id() const noexcept
+		{
+			return m_id;
+		}
+
+		friend constexpr bool operator==(Symbol lhs, Symbol rhs) = default;
+		friend constexpr std::strong_ordering operator<=>(Symbol lhs, Symbol rhs) = default;
+
+	private:
+		uint32_t m_id = 0;
+	};
+
+	template<>
+	struct hash<Symbol> {
+		[[nodiscard]] size_t operator()(const Symbol symbol) const noexcept
+		{
+			return symbol.id();
+		}
+	};
+
+	// How much memory an intern pool holds. Allocator overhead is not included.
+	struct InternPoolMemory {
+		// The number of distinct strings interned.
+		size_t symbols = 0;
+
+		// The bytes of those strings, counting one terminating null character each.
+		size_t string_bytes = 0;
+
+		// The bytes of the arena blocks the strings are stored in.
+		size_t arena_bytes = 0;
+
+		// The bytes of the hash tables and of the table from symbols to strings.
+		size_t table_bytes = 0;
+
+		[[nodiscard]] size_t total_bytes() const noexcept
+		{
+			return arena_bytes + table_bytes;
+		}
+	};
+
+	namespace detail
+	{
+		// Stores strings back to back in blocks that are never moved or freed before the arena,
+		// each followed by a null character. Blocks double in size up to max_block_size;
+		// a string too long for that gets a block of its own.
+		class StringArena
+		{
+		public:
+			static constexpr size_t first_block_size = 4096;
+			static constexpr size_t max_block_size = size_t{ 1 } << 20;
+
+			StringArena() = default;
+			StringArena(const StringArena&) = delete;
+			StringArena& operator=(const StringArena&) = delete;
+
+			~StringArena()
+			{
+				for (const auto& block : m_blocks)
+					::operator delete(block.data, block.size);
+			}
+
+			// Copies sv and a null character into the arena. Returns a view of the copy.
+			StringView store(const StringView sv)
+			{
+				const auto bytes = sv.size() + 1;
+				auto p = bytes > max_block_size / 4 ? new_block(bytes) : bump(bytes);
+
+				std::memcpy(p, sv.data(), sv.size());
+				p[sv.size()] = '\0';
+				m_used += bytes;
+
+				return StringView(p, sv.size());
+			}
+
+			// Returns the bytes of the strings stored, with their null characters.
+			[[nodiscard]] size_t used_bytes() const noexcept
+			{
+				return m_used;
+			}
+
+			// Returns the bytes of all blocks.
+			[[nodiscard]] size_t reserved_bytes() const noexcept
+			{
+				return m_reserved;
+			}
+
+		private:
+			struct Block {
+				char* data;
+				size_t size;
+			};
+
+			char* bump(const size_t bytes)
+			{
+				if (bytes > m_left)
+				{
+					const auto size = std::max(m_next_size, bytes);
+					m_next = new_block(size);
+					m_left = size;
+					m_next_size = std::min(m_next_size * 2, max_block_size);
+				}
+
+				auto p = m_next;
+				m_next += bytes;
+				m_left -= bytes;
+				return p;
+			}
+
+			char* new_block(const size_t size)
+			{
+				auto data = static_cast<char*>(::operator new(size));
+				try
+				{
+					m_blocks.push_back({ data, size });
+				}
+				catch (...)
+				{
+					::operator delete(data, size);
+					throw;
+				}
+
+				m_reserved += size;
+				return data;
+			}
+
+			Vector<Block> m_blocks;
+			char* m_next = nullptr;
+			size_t m_left = 0;
+			size_t m_next_size = first_block_size;
+			size_t m_used = 0;
+			size_t m_reserved = 0;
+		};
+
+		// A string to look up together with its hash, so that it is hashed once per lookup.
+		struct PrehashedView {
+			StringView view;
+			size_t hash;
+
+			friend bool operator==(const StringView lhs, const PrehashedView& rhs) noexcept
+			{
+				return lhs == rhs.view;
+			}
+		};
+
+		struct InternHash : hash<StringView> {
+			using hash<StringView>::operator();
+
+			[[nodiscard]] size_t operator()(const PrehashedView& key) const noexcept
+			{
+				return key.hash;
+			}
+		};
+
+		// Maps the strings of a pool, which are views into its arena, to their symbol ids.
+		using InternIndex = FlatHashMap<StringView, uint32_t, InternHash>;
+
+		inline size_t table_bytes(const InternIndex& index) noexcept
+		{
+			return index.capacity() * (sizeof(InternIndex::value_type) + 1);
+		}
+
+		inline uint32_t checked_symbol_id(const size_t id)
+		{
+			if (id > std::numeric_limits<uint32_t>::max())
+				throw std::length_error("InternPool symbol limit reached");
+
+			return static_cast<uint32_t>(id);
+		}
+	}// namespace detail
+
+	// Stores each distinct string once and hands out a 4-byte Symbol for it.
+	//
+	// The characters are copied into an arena, with a null character after each string; they never move
+	// and are freed with the pool. Interning a string that is already there costs one hash and one
+	// lookup, and allocates nothing. Turning a Symbol back into its string is an index into an array.
+	// The pool is not thread-safe; ConcurrentInternPool is.
+	class InternPool
+	{
+	public:
+		InternPool()
+		{
+			intern(StringView("", 0));
+		}
+
+		InternPool(const InternPool&) = delete;
+		InternPool& operator=(const InternPool&) = delete;
+
+		// Returns the symbol of sv, interning a copy of it if the pool does not hold it yet.
+		Symbol intern(const StringView sv)
+		{
+			const detail::PrehashedView key{ sv, hash<StringView>()(sv) };
+			if (const auto it = m_index.find(key); it != m_index.end())
+				return Symbol(it->second);
+
+			const auto id = detail::checked_symbol_id(m_strings.size());
+			const auto stored = m_arena.store(sv);
+			m_strings.push_back(stored);
+			m_index.try_emplace(stored, id);
+
+			return Symbol(id);
+		}
+
+		// Returns the symbol of sv if the pool holds it, without interning it.
+		[[nodiscard]] std::optional<Symbol> find(const StringView sv) const
+		{
+			const detail::PrehashedView key{ sv, hash<StringView>()(sv) };
+			if (const auto it = m_index.find(key); it != m_index.end())
+				return Symbol(it->second);
+
+			return std::nullopt;
+		}
+
+		// Returns the string of a symbol of this pool. It stays valid as long as the pool.
+		[[nodiscard]] StringView view(const Symbol symbol) const
+		{
+			return m_strings[symbol.id()];
+		}
+
+		// Returns the string of a symbol of this pool as a null-terminated string.
+		[[nodiscard]] const char* c_str(const Symbol symbol) const
+		{
+			return m_strings[symbol.id()].data();
+		}
+
+		// Returns whether symbol was handed out by this pool.
+		[[nodiscard]] bool contains(const Symbol symbol) const noexcept
+		{
+			return symbol.id() < m_strings.size();
+		}
+
+		// Returns the number of distinct strings interned, the empty string included.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_strings.size();
+		}
+
+		// Makes room for count distinct strings in the tables.
+		void reserve(const size_t count)
+		{
+			m_strings.reserve(count);
+			m_index.reserve(count);
+		}
+
+		[[nodiscard]] InternPoolMemory memory_usage() const noexcept
+		{
+			return {
+				.symbols = m_strings.size(),
+				.string_bytes = m_arena.used_bytes(),
+				.arena_bytes = m_arena.reserved_bytes(),
+				.table_bytes = detail::table_bytes(m_index) + m_strings.capacity() * sizeof(StringView),
+			};
+		}
+
+	private:
+		detail::StringArena m_arena;
+		detail::InternIndex m_index;
+		Vector<StringView> m_strings;
+	};
+
+	// An InternPool that any number of threads may use at the same time.
+	//
+	// The strings are spread over shard_count shards by hash, each with its own index, arena and
+	// reader-writer lock, so interning strings that are already there only takes a shared lock on
+	// one shard and threads rarely contend. The table from symbols to strings is a ConcurrentVector,
+	// so view() takes no lock at all.
+	class ConcurrentInternPool
+	{
+	public:
+		static constexpr size_t shard_bits = 4;
+		static constexpr size_t shard_count = size_t{ 1 } << shard_bits;
+
+		ConcurrentInternPool()
+		{
+			intern(StringView("", 0));
+		}
+
+		ConcurrentInternPool(const ConcurrentInternPool&) = delete;
+		ConcurrentInternPool& operator=(const ConcurrentInternPool&) = delete;
+
+		// Returns the symbol of sv, interning a copy of it if the pool does not hold it yet.
+		// Threads interning the same new string at the same time get the same symbol.
+		Symbol intern(const StringView sv)
+		{
+			const detail::PrehashedView key{ sv, hash<StringView>()(sv) };
+			auto& shard = shard_of(key.hash);
+
+			{
+				std::shared_lock lock(shard.mutex);
+				if (const auto it = shard.index.find(key); it != shard.index.end())
+					return Symbol(it->second);
+			}
+
+			std::unique_lock lock(shard.mutex);
+			if (const auto it = shard.index.find(key); it != shard.index.end())
+				return Symbol(it->second);
+
+			const auto stored = shard.arena.store(sv);
+			const auto id = detail::checked_symbol_id(m_strings.push_back(stored));
+			shard.index.try_emplace(stored, id);
+
+			return Symbol(id);
+		}
+
+		// Returns the symbol of sv if the pool holds it, without interning it.
+		[[nodiscard]] std::optional<Symbol> find(const StringView sv) const
+		{
+			const detail::PrehashedView key{ sv, hash<StringView>()(sv) };
+			const auto& shard = shard_of(key.hash);
+
+			std::shared_lock lock(shard.mutex);
+			if (const auto it = shard.index.find(key); it != shard.index.end())
+				return Symbol(it->second);
+
+			return std::nullopt;
+		}
+
+		// Returns the string of a symbol of this pool. It stays valid as long as the pool. Wait-free.
+		[[nodiscard]] StringView view(const Symbol symbol) const
+		{
+			return m_strings[symbol.id()];
+		}
+
+		// Returns the string of a symbol of this pool as a null-terminated string. Wait-free.
+		[[nodiscard]] const char* c_str(const Symbol symbol) const
+		{
+			return m_strings[symbol.id()].data();
+		}
+
+		// Returns whether symbol was handed out by this pool.
+		[[nodiscard]] bool contains(const Symbol symbol) const noexcept
+		{
+			return m_strings.ready(symbol.id());
+		}
+
+		// Returns the number of distinct strings interned, the empty string included.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_strings.size();
+		}
+
+		// Takes every shard lock in turn, so the result is only exact while no thread interns new strings.
+		[[nodiscard]] InternPoolMemory memory_usage() const
+		{
+			InternPoolMemory memory{ .symbols = m_strings.size() };
+			memory.table_bytes = memory.symbols * sizeof(StringView);
+
+			for (const auto& shard : m_shards)
+			{
+				std::shared_lock lock(shard.mutex);
+				memory.string_bytes += shard.arena.used_bytes();
+				memory.arena_bytes += shard.arena.reserved_bytes();
+				memory.table_bytes += detail::table_bytes(shard.index);
+			}
+
+			return memory;
+		}
+
+	private:
+		struct alignas(cache_line_size) Shard {
+			mutable std::shared_mutex mutex;
+			detail::InternIndex index;
+			detail::StringArena arena;
+		};
+
+		// The highest bits of the hash pick the shard, leaving the others to the index of the shard.
+		Shard& shard_of(const size_t hash) noexcept
+		{
+			return m_shards[hash >> (std::numeric_limits<size_t>::digits - shard_bits)];
+		}
+
+		const Shard& shard_of(const size_t hash) const noexcept
+		{
+			return m_shards[hash >> (std::numeric_limits<size_t>::digits - shard_bits)];
+		}
+
+		Shard m_shards[shard_count];
+		ConcurrentVector<StringView> m_strings;
+	};
+}// namespace cpp
@@ -1,113 +1,131 @@
 #pragma once
 
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <type_traits>
+
 namespace cpp
 {
+	// A random access iterator over the contiguous elements of a Container.
+	//
+	// The iterator is a thin wrapper around a pointer and models std::contiguous_iterator, so
+	// standard algorithms and ranges see through it and lower to memmove or vectorized loops.
+	// Container only keeps the iterators of different container types apart.
 	template<typename Container, typename ValueType>
 	class Iterator
 	{
-	 public:
+	public:
+		using iterator_concept = std::contiguous_iterator_tag;
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_cv_t<ValueType>;
+		using element_type = ValueType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = ValueType*;
+		using reference = ValueType&;
+
 		friend Container;
 
-		constexpr Iterator(const Iterator& obj) = default;
+		template<typename, typename>
+		friend class Iterator;
 
-		constexpr Iterator operator++()
-		{
-			++m_index;
-			return *this;
-		}
+		constexpr Iterator() = default;
 
-		constexpr Iterator operator++(int)
+		// Converts an iterator into a const iterator over the same elements.
+		template<typename OtherValueType>
+		requires(std::is_const_v<ValueType> && std::is_same_v<const OtherValueType, ValueType>)
+		constexpr Iterator(const Iterator<Container, OtherValueType>& other) noexcept
+			: m_ptr(other.m_ptr)
 		{
-			++m_index;
-			return Iterator{ m_container, m_index - 1 };
 		}
 
-		constexpr Iterator operator--()
+		constexpr reference operator*() const noexcept
 		{
-			--m_index;
-			return *this;
+			return *m_ptr;
 		}
 
-		constexpr Iterator operator--(int)
+		constexpr pointer operator->() const noexcept
 		{
-			++m_index;
-			return Iterator{ m_container, m_index + 1 };
+			return m_ptr;
 		}
 
-		constexpr ValueType& operator*()
+		constexpr reference operator[](const difference_type n) const noexcept
 		{
-			return m_container[m_index];
+			return m_ptr[n];
 		}
 
-		constexpr const ValueType& operator*() const
+		constexpr Iterator& operator++() noexcept
 		{
-			return m_container[m_index];
+			++m_ptr;
+			return *this;
 		}
 
-		constexpr ValueType* operator->()
+		constexpr Iterator operator++(int) noexcept
 		{
-			return &m_container[m_index];
+			auto copy = *this;
+			++m_ptr;
+			return copy;
 		}
 
-		constexpr const ValueType* operator->() const
+		constexpr Iterator& operator--() noexcept
 		{
-			return &m_container[m_index];
+			--m_ptr;
+			return *this;
 		}
 
-		constexpr bool operator==(Iterator other) const
+		constexpr Iterator operator--(int) noexcept
 		{
-			return m_index == other.m_index;
+			auto copy = *this;
+			--m_ptr;
+			return copy;
 		}
 
-		constexpr bool operator!=(Iterator other) const
+		constexpr Iterator& operator+=(const difference_type n) noexcept
 		{
-			return m_index != other.m_index;
+			m_ptr += n;
+			return *this;
 		}
 
-		constexpr bool operator<(Iterator other) const
+		constexpr Iterator& operator-=(const difference_type n) noexcept
 		{
-			return m_index < other.m_index;
+			m_ptr -= n;
+			return *this;
 		}
 
-		constexpr bool operator>(Iterator other) const
+		friend constexpr Iterator operator+(Iterator it, const difference_type n) noexcept
 		{
-			return m_index > other.m_index;
+			return it += n;
 		}
 
-		constexpr bool operator<=(Iterator other) const
+		friend constexpr Iterator operator+(const difference_type n, Iterator it) noexcept
 		{
-			return m_index <= other.m_index;
+			return it += n;
 		}
 
-		constexpr bool operator>=(Iterator other) const
+		friend constexpr Iterator operator-(Iterator it, const difference_type n) noexcept
 		{
-			return m_index >= other.m_index;
+			return it -= n;
 		}
 
-		Iterator& operator=(const Iterator& other)
+		friend constexpr difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept
 		{
-			m_index = other.m_index;
-			return *this;
+			return lhs.m_ptr - rhs.m_ptr;
 		}
 
-	 private:
-		static constexpr Iterator begin(Container& container)
-		{
-			return { container, 0 };
-		}
+		friend constexpr bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept = default;
 
-		static constexpr Iterator end(Container& container)
+		friend constexpr std::strong_ordering operator<=>(const Iterator& lhs, const Iterator& rhs) noexcept
 		{
-			return { container, container.size() };
+			return std::compare_three_way{}(lhs.m_ptr, rhs.m_ptr);
 		}
 
-		constexpr Iterator(Container& container, const size_t index)
-			: m_container(container), m_index(index)
+	private:
+		constexpr explicit Iterator(ValueType* ptr) noexcept
+			: m_ptr(ptr)
 		{
 		}
 
-		Container& m_container;
-		size_t m_index;
+		ValueType* m_ptr = nullptr;
 	};
 };// namespace cpp
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Memory.h"
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#if defined(__GLIBC__) || defined(__linux__)
+#include <malloc.h>
+#define CPP_MALLOC_USABLE_SIZE(p) ::malloc_usable_size(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define CPP_MALLOC_USABLE_SIZE(p) ::malloc_size(p)
+#elif defined(_MSC_VER)
+#include <malloc.h>
+#define CPP_MALLOC_USABLE_SIZE(p) ::_msize(p)
+#endif
+
+namespace cpp
+{
+	// An allocator that takes its blocks straight from malloc.
+	//
+	// Unlike blocks from operator new, malloc blocks can be grown with realloc, which often extends them
+	// in place, and malloc can tell how large a block really is. Vector uses the first for trivially
+	// relocatable elements and the second with the growth::SizeClass policy. Since free() does not need
+	// the size of a block, deallocate() accepts any size between the requested and the usable one.
+	template<typename T>
+	class MallocAllocator
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "malloc only aligns blocks for fundamental types");
+
+	public:
+		using value_type = T;
+
+		constexpr MallocAllocator() noexcept = default;
+
+		template<typename U>
+		constexpr MallocAllocator(const MallocAllocator<U>&) noexcept
+		{
+		}
+
+		// Returns a block of n elements. Throws bad_alloc if there is no memory.
+		[[nodiscard]] T* allocate(const size_t n)
+		{
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+				throw std::bad_array_new_length();
+
+			auto p = std::malloc(n * sizeof(T));
+			if (p == nullptr)
+				throw std::bad_alloc();
+
+			return static_cast<T*>(p);
+		}
+
+		void deallocate(T* p, size_t) noexcept
+		{
+			std::free(p);
+		}
+
+		// Resizes the block at p from old_n to new_n elements, in place if possible, otherwise by moving its
+		// bytes to a new block. Returns the resized block. Throws bad_alloc if there is no memory; p is
+		// left untouched then.
+		[[nodiscard]] T* reallocate(T* p, size_t, const size_t new_n)
+		{
+			if (new_n > std::numeric_limits<size_t>::max() / sizeof(T))
+				throw std::bad_array_new_length();
+
+			auto block = std::realloc(p, std::max<size_t>(new_n * sizeof(T), 1));
+			if (block == nullptr)
+				throw std::bad_alloc();
+
+			return static_cast<T*>(block);
+		}
+
+		// Returns the number of elements that fit in the block at p, which was allocated for n of them.
+		[[nodiscard]] size_t usable_size(T* p, const size_t n) const noexcept
+		{
+#ifdef CPP_MALLOC_USABLE_SIZE
+			return std::max(n, CPP_MALLOC_USABLE_SIZE(p) / sizeof(T));
+#else
+			return n;
+#endif
+		}
+
+		// All malloc allocators free each other's blocks.
+		template<typename U>
+		constexpr bool operator==(const MallocAllocator<U>&) const noexcept
+		{
+			return true;
+		}
+	};
+}// namespace cpp
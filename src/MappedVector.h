@@ -0,0 +1,419 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Iterator.h"
+#include "Memory.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cpp
+{
+	// A vector of trivially copyable elements that lives in a memory-mapped file.
+	//
+	// The file starts with a small header that records the number of elements and the element size,
+	// followed by the elements themselves, so reopening the file gives back the vector as it was left
+	// without reading or converting anything: pages are faulted in on first access, and processes that
+	// map the same file share them through the page cache. The mapping is shared, so changes reach the
+	// file without an explicit write; sync() waits until they are on disk.
+	//
+	// Growing extends the file with ftruncate() and the mapping with mremap(), which may move it, so
+	// like with Vector, growth invalidates pointers, references and iterators.
+	//
+	// A mapping only sees the elements its own capacity covers: when another process grows the file and
+	// appends past that, size() stops at the capacity until the file is opened again. Nothing synchronizes
+	// the processes, so only one of them should change the vector at a time, and none may shrink it while
+	// others have the file mapped.
+	template<typename T>
+	class MappedVector
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "MappedVector elements are stored as raw bytes");
+
+		struct Header {
+			uint64_t magic;
+			uint64_t element_size;
+			uint64_t size;
+		};
+
+		static constexpr uint64_t file_magic = 0x4d41505045445643;
+		static constexpr size_t header_size = cache_line_size;
+
+		static_assert(sizeof(Header) <= header_size && alignof(T) <= header_size);
+
+	public:
+		using value_type = T;
+
+		// Constructs a vector that is not backed by any file. It must be assigned before use.
+		MappedVector() = default;
+
+		MappedVector(const MappedVector&) = delete;
+		MappedVector& operator=(const MappedVector&) = delete;
+
+		// Constructs a vector that takes over the file and the mapping of other, which is left unbacked.
+		MappedVector(MappedVector&& other) noexcept
+			: m_fd(std::exchange(other.m_fd, -1)), m_map(std::exchange(other.m_map, nullptr)), m_capacity(std::exchange(other.m_capacity, 0))
+		{
+		}
+
+		// Releases the current file, then takes over the file and the mapping of other.
+		MappedVector& operator=(MappedVector&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release();
+				m_fd = std::exchange(other.m_fd, -1);
+				m_map = std::exchange(other.m_map, nullptr);
+				m_capacity = std::exchange(other.m_capacity, 0);
+			}
+
+			return *this;
+		}
+
+		// Unmaps and closes the file. The elements stay in the file.
+		~MappedVector()
+		{
+			release();
+		}
+
+		// Creates the file at path, replacing any existing one, with room for capacity elements and none in use.
+		// Throws a system_error if the file cannot be created or mapped.
+		[[nodiscard]] static MappedVector create(const std::filesystem::path& path, const size_t capacity = 0)
+		{
+			MappedVector vec;
+			vec.m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if (vec.m_fd < 0)
+				throw_errno("MappedVector cannot create file");
+
+			vec.resize_file(capacity);
+			vec.map(capacity);
+			*vec.header() = { file_magic, sizeof(T), 0 };
+			return vec;
+		}
+
+		// Opens the file at path, which must have been created by a MappedVector of the same element size.
+		// Throws a system_error if the file cannot be opened or mapped, and a runtime_error if it does not hold such a vector.
+		[[nodiscard]] static MappedVector open(const std::filesystem::path& path)
+		{
+			MappedVector vec;
+			vec.m_fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+			if (vec.m_fd < 0)
+				throw_errno("MappedVector cannot open file");
+
+			struct stat st {};
+			if (::fstat(vec.m_fd, &st) != 0)
+				throw_errno("MappedVector cannot stat file");
+
+			const auto file_size = static_cast<size_t>(st.st_size);
+			if (file_size < header_size)
+				throw std::runtime_error("MappedVector file is too short");
+
+			vec.map((file_size - header_size) / sizeof(T));
+
+			const auto& h = *vec.header();
+			if (h.magic != file_magic || h.element_size != sizeof(T))
+				throw std::runtime_error("MappedVector file holds a different element type");
+			if (h.size > vec.m_capacity)
+				throw std::runtime_error("MappedVector file is truncated");
+
+			return vec;
+		}
+
+		// Returns whether the vector is backed by a file.
+		[[nodiscard]] bool is_open() const noexcept
+		{
+			return m_map != nullptr;
+		}
+
+		// Returns a reference to the element at position n in the vector.
+		T& at(const size_t index)
+		{
+			if (index >= size())
+				throw std::out_of_range("MappedVector subscript out of range");
+			return data()[index];
+		}
+
+		// Returns a reference to the element at position n in the vector.
+		const T& at(const size_t index) const
+		{
+			if (index >= size())
+				throw std::out_of_range("MappedVector subscript out of range");
+			return data()[index];
+		}
+
+		// Returns a reference to the element at position n in the vector container.
+		T& operator[](const size_t index) noexcept
+		{
+			return data()[index];
+		}
+
+		// Returns a reference to the element at position n in the vector container.
+		const T& operator[](const size_t index) const noexcept
+		{
+			return data()[index];
+		}
+
+		// Returns a reference to the first element in the vector.
+		T& front() noexcept
+		{
+			return data()[0];
+		}
+
+		// Returns a reference to the first element in the vector.
+		const T& front() const noexcept
+		{
+			return data()[0];
+		}
+
+		// Returns a reference to the last element in the vector.
+		T& back() noexcept
+		{
+			return data()[size() - 1];
+		}
+
+		// Returns a reference to the last element in the vector.
+		const T& back() const noexcept
+		{
+			return data()[size() - 1];
+		}
+
+		// Returns a direct pointer to the mapped elements.
+		T* data() noexcept
+		{
+			return m_map ? reinterpret_cast<T*>(m_map + header_size) : nullptr;
+		}
+
+		// Returns a direct pointer to the mapped elements.
+		const T* data() const noexcept
+		{
+			return m_map ? reinterpret_cast<const T*>(m_map + header_size) : nullptr;
+		}
+
+		// Returns whether the vector is empty (i.e. whether its size is 0).
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		// Returns the number of elements in the vector that this mapping covers. The size in the header may be
+		// larger when another process has grown the file since it was mapped here.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_map ? std::min(static_cast<size_t>(header()->size), m_capacity) : 0;
+		}
+
+		// Returns the number of elements the file has room for.
+		[[nodiscard]] size_t capacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		// Requests that the file have room for at least new_capacity elements.
+		void reserve(const size_t new_capacity)
+		{
+			grow(new_capacity);
+		}
+
+		// Extends the file and the mapping to hold exactly new_capacity elements. Does nothing if they already hold as many.
+		// Throws a system_error if the file cannot be extended or remapped; the elements are unchanged then.
+		void grow(const size_t new_capacity)
+		{
+			if (new_capacity <= m_capacity)
+				return;
+
+			resize_file(new_capacity);
+			remap(new_capacity);
+		}
+
+		// Shrinks the file to hold exactly the elements in use.
+		// Other processes that have the file mapped get SIGBUS when they touch the truncated pages, so the
+		// file must not be mapped anywhere else while it shrinks.
+		void shrink_to_fit()
+		{
+			if (m_capacity == size())
+				return;
+
+			const auto new_capacity = size();
+			remap(new_capacity);
+			resize_file(new_capacity);
+		}
+
+		// Removes all elements from the vector, leaving the file with its capacity.
+		void clear() noexcept
+		{
+			if (m_map)
+				header()->size = 0;
+		}
+
+		// Adds a copy of value at the end of the vector, after its current last element.
+		void push_back(const T& value)
+		{
+			emplace_back(value);
+		}
+
+		// Inserts a new element at the end of the vector, constructed from args.
+		template<typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			const auto sz = size();
+
+			if (sz == m_capacity)
+			{
+				// args may refer to an element of this vector, which growing can move.
+				const T value(std::forward<Args>(args)...);
+				grow(1 + sz * 2);
+				std::construct_at(data() + sz, value);
+			}
+			else
+			{
+				std::construct_at(data() + sz, std::forward<Args>(args)...);
+			}
+
+			header()->size = sz + 1;
+			return data()[sz];
+		}
+
+		// Removes the last element in the vector, effectively reducing the container size by one.
+		void pop_back() noexcept
+		{
+			--header()->size;
+		}
+
+		// Resizes the container so that it contains count elements, the new ones being copies of value.
+		void resize(const size_t count, const T& value = {})
+		{
+			const auto sz = size();
+
+			if (count > m_capacity)
+			{
+				const T copy = value;
+				grow(count);
+				std::uninitialized_fill(data() + sz, data() + count, copy);
+			}
+			else if (count > sz)
+			{
+				std::uninitialized_fill(data() + sz, data() + count, value);
+			}
+
+			header()->size = count;
+		}
+
+		// Writes the changed pages of the file to disk and waits until that is done.
+		// Throws a system_error if writing fails.
+		void sync()
+		{
+			if (m_map && ::msync(m_map, mapped_bytes(m_capacity), MS_SYNC) != 0)
+				throw_errno("MappedVector cannot sync file");
+		}
+
+		// Exchanges the files of the two vectors.
+		void swap(MappedVector& other) noexcept
+		{
+			std::swap(m_fd, other.m_fd);
+			std::swap(m_map, other.m_map);
+			std::swap(m_capacity, other.m_capacity);
+		}
+
+		using ConstIterator = Iterator<MappedVector, T const>;
+		using It = Iterator<MappedVector, T>;
+
+		ConstIterator begin() const noexcept
+		{
+			return ConstIterator(data());
+		}
+
+		It begin() noexcept
+		{
+			return It(data());
+		}
+
+		ConstIterator end() const noexcept
+		{
+			return ConstIterator(data() + size());
+		}
+
+		It end() noexcept
+		{
+			return It(data() + size());
+		}
+
+	private:
+		[[noreturn]] static void throw_errno(const char* what)
+		{
+			throw std::system_error(errno, std::generic_category(), what);
+		}
+
+		static size_t mapped_bytes(const size_t capacity) noexcept
+		{
+			return header_size + capacity * sizeof(T);
+		}
+
+		Header* header() noexcept
+		{
+			return reinterpret_cast<Header*>(m_map);
+		}
+
+		const Header* header() const noexcept
+		{
+			return reinterpret_cast<const Header*>(m_map);
+		}
+
+		void resize_file(const size_t capacity)
+		{
+			if (::ftruncate(m_fd, static_cast<off_t>(mapped_bytes(capacity))) != 0)
+				throw_errno("MappedVector cannot resize file");
+		}
+
+		void map(const size_t capacity)
+		{
+			const auto p = ::mmap(nullptr, mapped_bytes(capacity), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+			if (p == MAP_FAILED)
+				throw_errno("MappedVector cannot map file");
+
+			m_map = static_cast<std::byte*>(p);
+			m_capacity = capacity;
+		}
+
+		// Resizes the mapping to new_capacity elements. The file must already be at least that long.
+		void remap(const size_t new_capacity)
+		{
+#ifdef MREMAP_MAYMOVE
+			const auto p = ::mremap(m_map, mapped_bytes(m_capacity), mapped_bytes(new_capacity), MREMAP_MAYMOVE);
+			if (p == MAP_FAILED)
+				throw_errno("MappedVector cannot remap file");
+
+			m_map = static_cast<std::byte*>(p);
+			m_capacity = new_capacity;
+#else
+			const auto old_map = m_map;
+			const auto old_capacity = m_capacity;
+
+			map(new_capacity);
+			::munmap(old_map, mapped_bytes(old_capacity));
+#endif
+		}
+
+		void release() noexcept
+		{
+			if (m_map)
+				::munmap(m_map, mapped_bytes(m_capacity));
+			if (m_fd >= 0)
+				::close(m_fd);
+
+			m_fd = -1;
+			m_map = nullptr;
+			m_capacity = 0;
+		}
+
+		int m_fd = -1;
+		std::byte* m_map = nullptr;
+		size_t m_capacity = 0;
+	};
+}// namespace cpp
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "pch.h"
+
+#include <concepts>
+#include <cstring>
+#include <memory>
+
+namespace cpp
+{
+	// The size of a cache line on the targets we care about. Data written by different threads is kept
+	// this far apart, so that the threads do not invalidate each other's cache lines (false sharing).
+	inline constexpr size_t cache_line_size = 64;
+
+	// Tells whether objects of type T can be moved to another address by copying their bytes,
+	// without running the move constructor and the destructor of the source.
+	//
+	// Every trivially copyable type qualifies. Containers that do not point into themselves
+	// may specialize this trait to opt in as well.
+	template<typename T>
+	struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {
+	};
+
+	template<typename T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	// Move-constructs n objects starting at src into the uninitialized storage starting at dst, copying them
+	// instead when their move constructor may throw and they are copyable. If a constructor throws, the objects
+	// already constructed are destroyed and the source objects are left as they were.
+	template<typename T>
+	constexpr void uninitialized_move_if_noexcept(T* src, const size_t n, T* dst)
+	{
+		size_t i = 0;
+		try
+		{
+			for (; i < n; ++i)
+				std::construct_at(dst + i, std::move_if_noexcept(src[i]));
+		}
+		catch (...)
+		{
+			std::destroy_n(dst, i);
+			throw;
+		}
+	}
+
+	// Moves n objects starting at src into the uninitialized storage starting at dst
+	// and ends the lifetime of the source objects. The ranges must not overlap.
+	// If a constructor throws, nothing is left in dst and the source objects are left as they were.
+	template<typename T>
+	constexpr void relocate(T* src, const size_t n, T* dst)
+	{
+		if (n == 0)
+			return;
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+				return;
+			}
+		}
+
+		if constexpr (std::is_nothrow_move_constructible_v<T>)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				std::construct_at(dst + i, std::move(src[i]));
+				std::destroy_at(src + i);
+			}
+		}
+		else
+		{
+			// The sources are only destroyed once every copy has been made.
+			uninitialized_move_if_noexcept(src, n, dst);
+			std::destroy_n(src, n);
+		}
+	}
+
+	// Like relocate(), but the ranges may overlap, as when elements are shifted within one block.
+	// If a constructor throws, every object left in either range is destroyed.
+	template<typename T>
+	constexpr void relocate_overlapping(T* src, const size_t n, T* dst)
+	{
+		if (n == 0 || src == dst)
+			return;
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+				return;
+			}
+		}
+
+		// Each object goes either to uninitialized storage or to the slot of one that has already left.
+		// So if a constructor throws, the objects cannot all be put back: those left in both ranges are destroyed.
+		if (dst < src)
+		{
+			size_t i = 0;
+			try
+			{
+				for (; i < n; ++i)
+				{
+					std::construct_at(dst + i, std::move_if_noexcept(src[i]));
+					std::destroy_at(src + i);
+				}
+			}
+			catch (...)
+			{
+				std::destroy_n(dst, i);
+				std::destroy_n(src + i, n - i);
+				throw;
+			}
+		}
+		else
+		{
+			size_t i = n;
+			try
+			{
+				for (; i-- > 0;)
+				{
+					std::construct_at(dst + i, std::move_if_noexcept(src[i]));
+					std::destroy_at(src + i);
+				}
+			}
+			catch (...)
+			{
+				std::destroy_n(src, i + 1);
+				std::destroy_n(dst + i + 1, n - i - 1);
+				throw;
+			}
+		}
+	}
+
+	// An allocator whose reallocate(p, old_n, new_n) resizes a block, possibly in place.
+	template<typename Allocator, typename T>
+	concept ReallocatingAllocator = requires(Allocator& alloc, T* p, size_t n) {
+		{ alloc.reallocate(p, n, n) } -> std::same_as<T*>;
+	};
+
+	// An allocator whose usable_size(p, n) returns how many elements really fit in a block of n,
+	// and whose deallocate() accepts that many.
+	template<typename Allocator, typename T>
+	concept SizeReportingAllocator = requires(const Allocator& alloc, T* p, size_t n) {
+		{ alloc.usable_size(p, n) } -> std::same_as<size_t>;
+	};
+}// namespace cpp
@@ -0,0 +1,542 @@
+#pragma once
+
+#include "Vector.h"
+#include "pch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+
+namespace cpp::parallel
+{
+	// A fixed set of worker threads that share work by stealing it from each other.
+	//
+	// Every worker owns a queue. Tasks spawned by a worker go to the back of its own queue and are
+	// taken from there again (newest first, while the data is still in cache); idle workers steal
+	// from the front of the other queues, taking the oldest and usually largest piece of work.
+	// Tasks submitted from outside the pool go to a shared queue.
+	class ThreadPool
+	{
+	public:
+		using Task = std::function<void()>;
+
+		// Starts threads workers.
+		explicit ThreadPool(const size_t threads = default_thread_count())
+			: m_queue_count(std::max<size_t>(threads, 1) + 1),
+			  m_queues(std::make_unique<WorkQueue[]>(m_queue_count))
+		{
+			for (size_t i = 0; i + 1 < m_queue_count; ++i)
+				m_workers.emplace_back([this, i] { worker_loop(i); });
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// Finishes the queued tasks and joins the workers.
+		~ThreadPool()
+		{
+			{
+				std::lock_guard lock(m_sleep_mutex);
+				m_stop = true;
+			}
+			m_wake.notify_all();
+
+			for (auto& worker : m_workers)
+				worker.join();
+		}
+
+		// Returns the number of worker threads.
+		size_t size() const noexcept
+		{
+			return m_workers.size();
+		}
+
+		// One worker per hardware thread, leaving one for the thread that waits on the results and helps out meanwhile.
+		static size_t default_thread_count() noexcept
+		{
+			return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		}
+
+		// Returns the pool the parallel algorithms run on.
+		static ThreadPool& default_pool()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+
+		// Queues task for execution. The task must not throw.
+		void submit(Task task)
+		{
+			const auto index = t_current.pool == this ? t_current.index : injection_queue();
+			m_pending.fetch_add(1, std::memory_order_release);
+			m_queues[index].push(std::move(task));
+
+			{
+				// Taking the lock orders the increment with a worker that is about to sleep, so the notification is not lost.
+				std::lock_guard lock(m_sleep_mutex);
+			}
+			m_wake.notify_one();
+		}
+
+		// Runs one queued task on the calling thread. Returns false if there was none.
+		bool run_pending_task()
+		{
+			Task task;
+			if (!find_task(task, t_current.pool == this ? t_current.index : injection_queue()))
+				return false;
+
+			task();
+			return true;
+		}
+
+	private:
+		struct WorkQueue {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+
+			void push(Task task)
+			{
+				std::lock_guard lock(mutex);
+				tasks.push_back(std::move(task));
+			}
+
+			// Takes the newest task, used by the owner.
+			bool pop(Task& task)
+			{
+				std::lock_guard lock(mutex);
+				if (tasks.empty())
+					return false;
+
+				task = std::move(tasks.back());
+				tasks.pop_back();
+				return true;
+			}
+
+			// Takes the oldest task, used by everybody else.
+			bool steal(Task& task)
+			{
+				std::lock_guard lock(mutex);
+				if (tasks.empty())
+					return false;
+
+				task = std::move(tasks.front());
+				tasks.pop_front();
+				return true;
+			}
+		};
+
+		// The worker a thread belongs to, if any.
+		struct WorkerSlot {
+			ThreadPool* pool;
+			size_t index;
+		};
+
+		size_t injection_queue() const noexcept
+		{
+			return m_queue_count - 1;
+		}
+
+		bool find_task(Task& task, const size_t self)
+		{
+			if (m_pending.load(std::memory_order_acquire) == 0)
+				return false;
+
+			bool found = self == injection_queue() ? m_queues[self].steal(task) : m_queues[self].pop(task);
+
+			for (size_t i = 1; !found && i < m_queue_count; ++i)
+				found = m_queues[(self + i) % m_queue_count].steal(task);
+
+			if (found)
+				m_pending.fetch_sub(1, std::memory_order_relaxed);
+
+			return found;
+		}
+
+		void worker_loop(const size_t index)
+		{
+			t_current = { this, index };
+
+			while (true)
+			{
+				Task task;
+				if (find_task(task, index))
+				{
+					task();
+					continue;
+				}
+
+				std::unique_lock lock(m_sleep_mutex);
+				m_wake.wait(lock, [this] { return m_stop || m_pending.load(std::memory_order_acquire) != 0; });
+
+				if (m_stop && m_pending.load(std::memory_order_acquire) == 0)
+					return;
+			}
+		}
+
+		static inline thread_local WorkerSlot t_current;
+
+		const size_t m_queue_count;
+		std::unique_ptr<WorkQueue[]> m_queues;
+		Vector<std::thread> m_workers;
+
+		std::atomic<size_t> m_pending = 0;
+		std::mutex m_sleep_mutex;
+		std::condition_variable m_wake;
+		bool m_stop = false;
+	};
+
+	// Runs a set of tasks on a pool and waits for all of them.
+	//
+	// The waiting thread runs queued tasks itself instead of blocking, so tasks may spawn more tasks into
+	// the same group. The first exception thrown by a task cancels the tasks not yet started and is
+	// rethrown by wait().
+	class TaskGroup
+	{
+	public:
+		explicit TaskGroup(ThreadPool& pool = ThreadPool::default_pool())
+			: m_pool(pool)
+		{
+		}
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		// Waits for the running tasks, which still refer to the group.
+		~TaskGroup()
+		{
+			join();
+		}
+
+		// Queues fn to run on the pool.
+		template<typename F>
+		void run(F&& fn)
+		{
+			m_remaining.fetch_add(1, std::memory_order_relaxed);
+
+			m_pool.submit([this, fn = std::forward<F>(fn)]() mutable {
+				if (!m_failed.load(std::memory_order_relaxed))
+				{
+					try
+					{
+						fn();
+					}
+					catch (...)
+					{
+						fail(std::current_exception());
+					}
+				}
+
+				m_remaining.fetch_sub(1, std::memory_order_release);
+			});
+		}
+
+		// Waits until every task of the group finished, then rethrows the first exception thrown by one of them.
+		void wait()
+		{
+			join();
+
+			if (m_failed.exchange(false, std::memory_order_acquire))
+				std::rethrow_exception(std::exchange(m_exception, nullptr));
+		}
+
+	private:
+		void join()
+		{
+			while (m_remaining.load(std::memory_order_acquire) != 0)
+			{
+				if (!m_pool.run_pending_task())
+					std::this_thread::yield();
+			}
+		}
+
+		void fail(std::exception_ptr exception)
+		{
+			std::lock_guard lock(m_exception_mutex);
+			if (m_failed.load(std::memory_order_relaxed))
+				return;
+
+			m_exception = std::move(exception);
+			m_failed.store(true, std::memory_order_release);
+		}
+
+		ThreadPool& m_pool;
+		std::atomic<size_t> m_remaining = 0;
+		std::atomic<bool> m_failed = false;
+		std::mutex m_exception_mutex;
+		std::exception_ptr m_exception;
+	};
+
+	namespace detail
+	{
+		// The grain used when none is given: about 256 chunks, but at least 2048 elements per chunk.
+		// It depends on n only, never on the number of threads, which keeps reductions deterministic.
+		inline size_t resolve_grain(const size_t n, const size_t grain) noexcept
+		{
+			if (grain != 0)
+				return grain;
+
+			return std::max<size_t>(2048, (n + 255) / 256);
+		}
+
+		// Calls body(chunk) for every chunk in [first, last), halving the range and handing one half to the
+		// pool until a single chunk is left, so that idle workers always find a large piece to steal.
+		template<typename F>
+		void split(TaskGroup& group, size_t first, size_t last, const F& body)
+		{
+			while (last - first > 1)
+			{
+				const auto middle = first + (last - first) / 2;
+				group.run([&group, middle, last, &body] { split(group, middle, last, body); });
+				last = middle;
+			}
+
+			body(first);
+		}
+
+		// Cuts [0, n) into chunks of grain elements and calls body(chunk, begin, end) for each of them in parallel.
+		template<typename F>
+		void for_chunks(const size_t n, const size_t grain, const F& body)
+		{
+			const auto chunks = (n + grain - 1) / grain;
+			const auto chunk_body = [&](const size_t chunk) {
+				body(chunk, chunk * grain, std::min(n, (chunk + 1) * grain));
+			};
+
+			if (chunks <= 1)
+			{
+				if (n != 0)
+					chunk_body(0);
+				return;
+			}
+
+			TaskGroup group;
+			split(group, 0, chunks, chunk_body);
+			group.wait();
+		}
+
+		// Merges the sorted ranges [a_first, a_last) and [b_first, b_last) into out by moving the elements.
+		// Large merges are split at the middle of the larger range, so both halves can run in parallel.
+		template<typename T, typename Compare>
+		void merge(TaskGroup& group, T* a_first, T* a_last, T* b_first, T* b_last, T* out, const Compare& comp, const size_t grain)
+		{
+			while (static_cast<size_t>((a_last - a_first) + (b_last - b_first)) > std::max<size_t>(grain, 2))
+			{
+				if (a_last - a_first < b_last - b_first)
+				{
+					std::swap(a_first, b_first);
+					std::swap(a_last, b_last);
+				}
+
+				const auto a_middle = a_first + (a_last - a_first) / 2;
+				const auto b_middle = std::lower_bound(b_first, b_last, *a_middle, comp);
+				const auto out_middle = out + (a_middle - a_first) + (b_middle - b_first);
+
+				group.run([=, &group, &comp] { merge(group, a_middle, a_last, b_middle, b_last, out_middle, comp, grain); });
+
+				a_last = a_middle;
+				b_last = b_middle;
+			}
+
+			std::merge(std::make_move_iterator(a_first), std::make_move_iterator(a_last),
+					   std::make_move_iterator(b_first), std::make_move_iterator(b_last), out, comp);
+		}
+	}// namespace detail
+
+	// Calls body(i) for every i in [first, last).
+	// A grain of 0 picks one; pass a smaller grain when a single call is expensive.
+	template<typename F>
+	void parallel_for(const size_t first, const size_t last, F&& body, const size_t grain = 0)
+	{
+		const auto n = last > first ? last - first : 0;
+
+		detail::for_chunks(n, detail::resolve_grain(n, grain), [&](size_t, const size_t begin, const size_t end) {
+			for (auto i = first + begin; i != first + end; ++i)
+				body(i);
+		});
+	}
+
+	// Applies fn to each of the elements in range.
+	template<std::ranges::contiguous_range R, typename F>
+	void for_each(R&& range, F&& fn, const size_t grain = 0)
+	{
+		const auto data = std::ranges::data(range);
+		const auto n = static_cast<size_t>(std::ranges::size(range));
+
+		detail::for_chunks(n, detail::resolve_grain(n, grain), [&](size_t, const size_t begin, const size_t end) {
+			for (auto i = begin; i != end; ++i)
+				fn(data[i]);
+		});
+	}
+
+	// Stores the result of op applied to each of the elements in in at the same position in out.
+	// Throws std::invalid_argument if out is shorter than in.
+	template<std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename UnaryOp>
+	void transform(const In& in, Out&& out, UnaryOp&& op, const size_t grain = 0)
+	{
+		const auto input = std::ranges::data(in);
+		const auto output = std::ranges::data(out);
+		const auto n = static_cast<size_t>(std::ranges::size(in));
+
+		if (static_cast<size_t>(std::ranges::size(out)) < n)
+			throw std::invalid_argument("transform output is shorter than its input");
+
+		detail::for_chunks(n, detail::resolve_grain(n, grain), [&](size_t, const size_t begin, const size_t end) {
+			for (auto i = begin; i != end; ++i)
+				output[i] = op(input[i]);
+		});
+	}
+
+	// Combines init and the elements in range with op, which must be associative.
+	//
+	// Every chunk is reduced from left to right and the chunk results are then combined in order, so for a
+	// given grain the result is the same on every run and with any number of threads, even for floating point.
+	template<std::ranges::contiguous_range R, typename T, typename BinaryOp = std::plus<>>
+	T reduce(const R& range, T init, BinaryOp op = {}, size_t grain = 0)
+	{
+		const auto data = std::ranges::data(range);
+		const auto n = static_cast<size_t>(std::ranges::size(range));
+		grain = detail::resolve_grain(n, grain);
+
+		Vector<std::optional<T>> partials;
+		partials.resize((n + grain - 1) / grain);
+
+		detail::for_chunks(n, grain, [&](const size_t chunk, const size_t begin, const size_t end) {
+			T result = data[begin];
+			for (auto i = begin + 1; i != end; ++i)
+				result = op(std::move(result), data[i]);
+
+			partials[chunk].emplace(std::move(result));
+		});
+
+		for (auto& partial : partials)
+			init = op(std::move(init), std::move(*partial));
+
+		return init;
+	}
+
+	// Stores in out[i] the combination with op of the elements in[0] to in[i]. op must be associative.
+	// in and out may be the same range. Like reduce(), the result does not depend on the number of threads.
+	// Throws std::invalid_argument if out is shorter than in.
+	template<std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename BinaryOp = std::plus<>>
+	void inclusive_scan(const In& in, Out&& out, BinaryOp op = {}, size_t grain = 0)
+	{
+		using T = std::ranges::range_value_t<Out>;
+
+		const auto input = std::ranges::data(in);
+		const auto output = std::ranges::data(out);
+		const auto n = static_cast<size_t>(std::ranges::size(in));
+		grain = detail::resolve_grain(n, grain);
+
+		if (static_cast<size_t>(std::ranges::size(out)) < n)
+			throw std::invalid_argument("inclusive_scan output is shorter than its input");
+
+		// First the total of every chunk, then the sum of everything before each chunk, then the scan of each
+		// chunk starting from that sum.
+		Vector<std::optional<T>> carries;
+		carries.resize((n + grain - 1) / grain);
+
+		detail::for_chunks(n, grain, [&](const size_t chunk, const size_t begin, const size_t end) {
+			if (chunk + 1 == carries.size())
+				return;
+
+			T total = input[begin];
+			for (auto i = begin + 1; i != end; ++i)
+				total = op(std::move(total), input[i]);
+
+			carries[chunk + 1].emplace(std::move(total));
+		});
+
+		for (size_t chunk = 2; chunk < carries.size(); ++chunk)
+			carries[chunk] = op(*carries[chunk - 1], std::move(*carries[chunk]));
+
+		detail::for_chunks(n, grain, [&](const size_t chunk, const size_t begin, const size_t end) {
+			T result = chunk == 0 ? T(input[begin]) : op(*carries[chunk], input[begin]);
+			output[begin] = result;
+
+			for (auto i = begin + 1; i != end; ++i)
+			{
+				result = op(std::move(result), input[i]);
+				output[i] = result;
+			}
+		});
+	}
+
+	// Sorts the elements in range into ascending order, as defined by comp. The order of equal elements is not preserved.
+	//
+	// The chunks are sorted in parallel and then merged pairwise, every merge being split again over the pool.
+	// Types whose move constructor may throw are sorted on the calling thread.
+	template<std::ranges::contiguous_range R, typename Compare = std::less<>>
+	void sort(R&& range, Compare comp = {}, size_t grain = 0)
+	{
+		using T = std::ranges::range_value_t<R>;
+
+		const auto data = std::ranges::data(range);
+		const auto n = static_cast<size_t>(std::ranges::size(range));
+		grain = detail::resolve_grain(n, grain);
+
+		if (n <= grain || !std::is_nothrow_move_constructible_v<T>)
+		{
+			std::sort(data, data + n, comp);
+			return;
+		}
+
+		detail::for_chunks(n, grain, [&](size_t, const size_t begin, const size_t end) {
+			std::sort(data + begin, data + end, comp);
+		});
+
+		// The sorted chunks are moved into a buffer, and the merges go back and forth between it and the range,
+		// starting from the buffer since the range only holds moved-from elements by then.
+		std::allocator<T> alloc;
+		const auto buffer = alloc.allocate(n);
+
+		detail::for_chunks(n, grain, [&](size_t, const size_t begin, const size_t end) {
+			std::uninitialized_move(data + begin, data + end, buffer + begin);
+		});
+
+		auto source = buffer;
+		auto target = data;
+
+		try
+		{
+			for (auto width = grain; width < n; width *= 2)
+			{
+				TaskGroup group;
+				for (size_t first = 0; first < n; first += 2 * width)
+				{
+					const auto middle = std::min(first + width, n);
+					const auto last = std::min(first + 2 * width, n);
+
+					group.run([=, &group, &comp] {
+						detail::merge(group, source + first, source + middle, source + middle, source + last, target + first, comp, grain);
+					});
+				}
+				group.wait();
+
+				std::swap(source, target);
+			}
+		}
+		catch (...)
+		{
+			// comp threw: the elements are left in an unspecified order, but none of them leaks.
+			std::destroy(buffer, buffer + n);
+			alloc.deallocate(buffer, n);
+			throw;
+		}
+
+		detail::for_chunks(n, grain, [&](size_t, const size_t begin, const size_t end) {
+			if (source != data)
+				std::move(buffer + begin, buffer + end, data + begin);
+
+			std::destroy(buffer + begin, buffer + end);
+		});
+
+		alloc.deallocate(buffer, n);
+	}
+}// namespace cpp::parallel
@@ -0,0 +1,466 @@
+#pragma once
+
+#include "pch.h"
+
+#include "String.h"
+#include "StringView.h"
+#include "Vector.h"
+#include <iterator>
+#include <memory>
+
+namespace cpp
+{
+	// A string built as a balanced tree of shared, immutable String chunks.
+	//
+	// Concatenation links two trees under a new node instead of copying characters, and substr shares
+	// the chunks it covers, so both run in O(log n) like indexing does. Nodes are never modified after
+	// they are built, which lets copies of a rope and the ropes derived from it share their structure.
+	// The tree is kept height-balanced the way an AVL tree is.
+	class Rope
+	{
+		struct Node;
+		using NodePtr = std::shared_ptr<const Node>;
+
+	public:
+		// npos is a static member constant value with the greatest possible value for an element of type size_t.
+		static constexpr size_t npos = -1;
+
+		// Appended pieces are copied into the last chunk while it stays below this size, so that ropes
+		// assembled from many small fragments do not end up with one node per fragment.
+		static constexpr size_t small_chunk = 256;
+
+		// Iterates over the chunks of a rope from left to right, presenting each of them as a StringView.
+		class ChunkIterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = StringView;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = StringView;
+
+			ChunkIterator() = default;
+
+			StringView operator*() const
+			{
+				return m_leaf->chunk->view(m_leaf->offset, m_leaf->size);
+			}
+
+			ChunkIterator& operator++()
+			{
+				if (m_pending.empty())
+				{
+					m_leaf = nullptr;
+					return *this;
+				}
+
+				const auto next = m_pending.back();
+				m_pending.pop_back();
+				descend(next);
+				return *this;
+			}
+
+			ChunkIterator operator++(int)
+			{
+				auto copy = *this;
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const ChunkIterator& lhs, const ChunkIterator& rhs) noexcept
+			{
+				return lhs.m_leaf == rhs.m_leaf;
+			}
+
+		private:
+			friend class Rope;
+
+			explicit ChunkIterator(const Node* root)
+			{
+				if (root)
+					descend(root);
+			}
+
+			// Walks down to the leftmost leaf of node, remembering the right subtrees still to visit.
+			void descend(const Node* node)
+			{
+				while (!node->is_leaf())
+				{
+					m_pending.push_back(node->right.get());
+					node = node->left.get();
+				}
+
+				m_leaf = node;
+			}
+
+			Vector<const Node*> m_pending;
+			const Node* m_leaf = nullptr;
+		};
+
+		// The chunks of a rope, for scatter-gather output: for (StringView chunk : rope.chunks()) ...
+		class Chunks
+		{
+		public:
+			[[nodiscard]] ChunkIterator begin() const
+			{
+				return ChunkIterator(m_root);
+			}
+
+			[[nodiscard]] ChunkIterator end() const
+			{
+				return ChunkIterator();
+			}
+
+		private:
+			friend class Rope;
+
+			explicit Chunks(const Node* root)
+				: m_root(root)
+			{
+			}
+
+			const Node* m_root;
+		};
+
+		// Constructs an empty rope.
+		Rope() = default;
+
+		// Constructs a rope holding a copy of the characters of sv.
+		explicit Rope(const StringView sv)
+			: Rope(String(sv))
+		{
+		}
+
+		// Constructs a rope holding a copy of the null-terminated character sequence (C-string) pointed by s.
+		explicit Rope(const char* s)
+			: Rope(StringView(s))
+		{
+		}
+
+		// Constructs a rope made of a single chunk that takes over str.
+		explicit Rope(String str)
+			: m_root(make_leaf(std::move(str)))
+		{
+		}
+
+		// Returns the number of characters in the rope.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_root ? m_root->size : 0;
+		}
+
+		// Returns the number of characters in the rope.
+		[[nodiscard]] size_t length() const noexcept
+		{
+			return size();
+		}
+
+		// Returns whether the rope is empty (i.e. whether its length is 0).
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return !m_root;
+		}
+
+		// Returns the height of the tree, 0 for a rope of at most one chunk.
+		[[nodiscard]] size_t depth() const noexcept
+		{
+			return m_root ? m_root->height : 0;
+		}
+
+		// Returns the character at position index in the rope, in O(log n).
+		char operator[](size_t index) const noexcept
+		{
+			auto node = m_root.get();
+
+			while (!node->is_leaf())
+			{
+				if (index < node->left->size)
+				{
+					node = node->left.get();
+				}
+				else
+				{
+					index -= node->left->size;
+					node = node->right.get();
+				}
+			}
+
+			return (*node->chunk)[node->offset + index];
+		}
+
+		// Returns the character at position pos in the rope,
+		// throwing an out_of_range exception if pos is not less than the length.
+		[[nodiscard]] char at(const size_t pos) const
+		{
+			if (pos >= size())
+				throw std::out_of_range("Position outside of rope");
+
+			return (*this)[pos];
+		}
+
+		// Appends the characters of other, sharing its chunks.
+		Rope& append(const Rope& other)
+		{
+			m_root = join(m_root, other.m_root);
+			return *this;
+		}
+
+		// Appends a copy of the characters of sv.
+		Rope& append(const StringView sv)
+		{
+			if (!sv.empty())
+				m_root = join(m_root, make_leaf(String(sv)));
+
+			return *this;
+		}
+
+		// Appends the characters of other, sharing its chunks.
+		Rope& operator+=(const Rope& other)
+		{
+			return append(other);
+		}
+
+		// Appends a copy of the characters of sv.
+		Rope& operator+=(const StringView sv)
+		{
+			return append(sv);
+		}
+
+		// Returns a rope holding the characters of lhs followed by those of rhs. Both keep their chunks shared.
+		friend Rope operator+(Rope lhs, const Rope& rhs)
+		{
+			return std::move(lhs.append(rhs));
+		}
+
+		// Returns a rope holding the characters of lhs followed by a copy of those of rhs.
+		friend Rope operator+(Rope lhs, const StringView rhs)
+		{
+			return std::move(lhs.append(rhs));
+		}
+
+		// Returns a rope of the len characters starting at pos (or until the end of the rope, if it is too short).
+		// The chunks are shared with this rope. Like String::substr(), returns an empty rope if pos is past the end.
+		[[nodiscard]] Rope substr(const size_t pos = 0, size_t len = npos) const
+		{
+			if (pos >= size())
+				return {};
+
+			len = std::min(len, size() - pos);
+			return Rope(slice(m_root, pos, pos + len));
+		}
+
+		// Returns the characters of the rope as a single, flat string.
+		[[nodiscard]] String to_string() const
+		{
+			String result;
+			result.reserve(size());
+
+			for (const auto chunk : chunks())
+				result.append(chunk);
+
+			return result;
+		}
+
+		// Returns the chunks of the rope, from left to right.
+		[[nodiscard]] Chunks chunks() const noexcept
+		{
+			return Chunks(m_root.get());
+		}
+
+		// This function performs a binary comparison of the characters inside the ropes.
+		friend bool operator==(const Rope& lhs, const Rope& rhs)
+		{
+			return lhs.size() == rhs.size() && equal_chunks(lhs.chunks(), rhs.chunks());
+		}
+
+		// This function performs a binary comparison of the characters of the rope and of the view.
+		friend bool operator==(const Rope& lhs, const StringView rhs)
+		{
+			if (lhs.size() != rhs.size())
+				return false;
+
+			size_t offset = 0;
+			for (const auto chunk : lhs.chunks())
+			{
+				if (chunk != rhs.substr(offset, chunk.size()))
+					return false;
+
+				offset += chunk.size();
+			}
+
+			return true;
+		}
+
+		// Inserts the characters of the rope into os, chunk by chunk.
+		friend std::ostream& operator<<(std::ostream& os, const Rope& rope)
+		{
+			for (const auto chunk : rope.chunks())
+				os << chunk;
+
+			return os;
+		}
+
+	private:
+		// A leaf refers to the characters [offset, offset + size) of a shared chunk; an inner node
+		// concatenates its two children. Leaves are never empty.
+		struct Node {
+			size_t size = 0;
+			size_t height = 0;
+			NodePtr left, right;
+			std::shared_ptr<const String> chunk;
+			size_t offset = 0;
+
+			[[nodiscard]] bool is_leaf() const noexcept
+			{
+				return !left;
+			}
+		};
+
+		explicit Rope(NodePtr root)
+			: m_root(std::move(root))
+		{
+		}
+
+		static NodePtr make_leaf(std::shared_ptr<const String> chunk, const size_t offset, const size_t size)
+		{
+			auto node = std::make_shared<Node>();
+			node->size = size;
+			node->chunk = std::move(chunk);
+			node->offset = offset;
+			return node;
+		}
+
+		static NodePtr make_leaf(String str)
+		{
+			if (str.empty())
+				return nullptr;
+
+			const auto size = str.size();
+			return make_leaf(std::make_shared<const String>(std::move(str)), 0, size);
+		}
+
+		static NodePtr make_node(NodePtr left, NodePtr right)
+		{
+			auto node = std::make_shared<Node>();
+			node->size = left->size + right->size;
+			node->height = 1 + std::max(left->height, right->height);
+			node->left = std::move(left);
+			node->right = std::move(right);
+			return node;
+		}
+
+		// Returns the characters of a leaf as a view.
+		static StringView leaf_view(const Node& leaf)
+		{
+			return leaf.chunk->view(leaf.offset, leaf.size);
+		}
+
+		// Copies the characters of leaf right into the last leaf of left, if that leaf stays small.
+		// Only the nodes on the right spine of left are rebuilt, and the heights do not change.
+		static NodePtr merge_into_last_leaf(const NodePtr& left, const Node& right)
+		{
+			if (left->is_leaf())
+			{
+				if (left->size + right.size > small_chunk)
+					return nullptr;
+
+				String merged;
+				merged.reserve(left->size + right.size);
+				merged.append(leaf_view(*left));
+				merged.append(leaf_view(right));
+				return make_leaf(std::move(merged));
+			}
+
+			auto merged = merge_into_last_leaf(left->right, right);
+			return merged ? make_node(left->left, std::move(merged)) : nullptr;
+		}
+
+		// Concatenates two balanced trees into a balanced tree, in O(|height(left) - height(right)|).
+		// The taller tree is descended along its inner spine until the heights meet, and the nodes on the
+		// way back up are rotated where they would otherwise get out of balance.
+		static NodePtr join(const NodePtr& left, const NodePtr& right)
+		{
+			if (!left)
+				return right;
+			if (!right)
+				return left;
+
+			if (right->is_leaf() && right->size < small_chunk)
+			{
+				if (auto merged = merge_into_last_leaf(left, *right))
+					return merged;
+			}
+
+			if (left->height > right->height + 1)
+			{
+				auto joined = join(left->right, right);
+				if (joined->height <= left->left->height + 1)
+					return make_node(left->left, std::move(joined));
+
+				if (joined->left->height > joined->right->height)
+					return make_node(make_node(left->left, joined->left->left), make_node(joined->left->right, joined->right));
+
+				return make_node(make_node(left->left, joined->left), joined->right);
+			}
+
+			if (right->height > left->height + 1)
+			{
+				auto joined = join(left, right->left);
+				if (joined->height <= right->right->height + 1)
+					return make_node(std::move(joined), right->right);
+
+				if (joined->right->height > joined->left->height)
+					return make_node(make_node(joined->left, joined->right->left), make_node(joined->right->right, right->right));
+
+				return make_node(joined->left, make_node(joined->right, right->right));
+			}
+
+			return make_node(left, right);
+		}
+
+		// Returns the characters [first, last) of node, which must not be empty, sharing the chunks.
+		static NodePtr slice(const NodePtr& node, const size_t first, const size_t last)
+		{
+			if (first == 0 && last == node->size)
+				return node;
+
+			if (node->is_leaf())
+				return make_leaf(node->chunk, node->offset + first, last - first);
+
+			const auto middle = node->left->size;
+			if (last <= middle)
+				return slice(node->left, first, last);
+			if (first >= middle)
+				return slice(node->right, first - middle, last - middle);
+
+			return join(slice(node->left, first, middle), slice(node->right, 0, last - middle));
+		}
+
+		// Compares the characters of two chunk sequences of the same total length.
+		static bool equal_chunks(const Chunks& lhs, const Chunks& rhs)
+		{
+			auto it = rhs.begin();
+			StringView current;
+
+			for (auto chunk : lhs)
+			{
+				while (!chunk.empty())
+				{
+					if (current.empty())
+						current = *it++;
+
+					const auto n = std::min(chunk.size(), current.size());
+					if (chunk.substr(0, n) != current.substr(0, n))
+						return false;
+
+					chunk.remove_prefix(n);
+					current.remove_prefix(n);
+				}
+			}
+
+			return true;
+		}
+
+		NodePtr m_root;
+	};
+}// namespace cpp
@@ -0,0 +1,457 @@
+#pragma once
+
+#include "pch.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define CPP_SEARCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define CPP_SEARCH_X86 0
+#endif
+
+// GCC and Clang only emit vector instructions in functions that are compiled for that target,
+// MSVC accepts the intrinsics anywhere.
+#if CPP_SEARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+#define CPP_SEARCH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CPP_SEARCH_TARGET(isa)
+#endif
+
+// Length-aware search kernels over character ranges, used by String.
+//
+// Every public function picks the widest instruction set the running CPU supports the first time
+// it is called: AVX2 or SSE2 for characters and substrings, SSE4.2 for character sets, and plain
+// scalar code everywhere else. Vector loads never read outside of [s, s + n).
+namespace cpp::search
+{
+	// Returned by every search that finds nothing.
+	inline constexpr size_t npos = static_cast<size_t>(-1);
+
+	namespace detail
+	{
+		struct CpuFeatures {
+			bool sse42 = false;
+			bool avx2 = false;
+		};
+
+		inline CpuFeatures detect_cpu_features()
+		{
+			CpuFeatures features;
+#if CPP_SEARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+			__builtin_cpu_init();
+			features.sse42 = __builtin_cpu_supports("sse4.2");
+			features.avx2 = __builtin_cpu_supports("avx2");
+#elif CPP_SEARCH_X86 && defined(_MSC_VER)
+			int regs[4];
+			__cpuid(regs, 1);
+			features.sse42 = (regs[2] & (1 << 20)) != 0;
+
+			// AVX2 also needs the OS to save the upper halves of the ymm registers.
+			const bool os_avx = (regs[2] & (1 << 27)) != 0 && (regs[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+			__cpuidex(regs, 7, 0);
+			features.avx2 = os_avx && (regs[1] & (1 << 5)) != 0;
+#endif
+			return features;
+		}
+
+		inline const CpuFeatures& cpu_features()
+		{
+			static const CpuFeatures features = detect_cpu_features();
+			return features;
+		}
+
+		// A 256-bit membership table of the characters in a set.
+		struct CharSet {
+			uint64_t bits[4] = {};
+
+			CharSet(const char* set, const size_t m)
+			{
+				for (size_t i = 0; i < m; ++i)
+				{
+					const auto c = static_cast<unsigned char>(set[i]);
+					bits[c >> 6] |= uint64_t{ 1 } << (c & 63);
+				}
+			}
+
+			[[nodiscard]] bool contains(const char ch) const
+			{
+				const auto c = static_cast<unsigned char>(ch);
+				return (bits[c >> 6] >> (c & 63)) & 1;
+			}
+		};
+	}// namespace detail
+
+	namespace scalar
+	{
+		inline size_t find_char(const char* s, const size_t n, const char c)
+		{
+			const auto result = static_cast<const char*>(memchr(s, c, n));
+			return result == nullptr ? npos : static_cast<size_t>(result - s);
+		}
+
+		inline size_t rfind_char(const char* s, size_t n, const char c)
+		{
+			while (n-- > 0)
+				if (s[n] == c)
+					return n;
+
+			return npos;
+		}
+
+		inline size_t count_char(const char* s, const size_t n, const char c)
+		{
+			size_t count = 0;
+			for (size_t i = 0; i < n; ++i)
+				count += s[i] == c;
+
+			return count;
+		}
+
+		// Finds needle (of length m >= 1) in s starting at from, using memchr to skip to candidates.
+		inline size_t find(const char* s, const size_t n, const char* needle, const size_t m, size_t from = 0)
+		{
+			if (m > n)
+				return npos;
+
+			const auto last_start = n - m;
+			while (from <= last_start)
+			{
+				const auto candidate = find_char(s + from, last_start - from + 1, needle[0]);
+				if (candidate == npos)
+					return npos;
+
+				from += candidate;
+				if (memcmp(s + from + 1, needle + 1, m - 1) == 0)
+					return from;
+
+				++from;
+			}
+
+			return npos;
+		}
+
+		inline size_t find_first_of(const char* s, const size_t n, const char* set, const size_t m)
+		{
+			const detail::CharSet chars(set, m);
+			for (size_t i = 0; i < n; ++i)
+				if (chars.contains(s[i]))
+					return i;
+
+			return npos;
+		}
+
+		inline size_t find_last_of(const char* s, size_t n, const char* set, const size_t m)
+		{
+			const detail::CharSet chars(set, m);
+			while (n-- > 0)
+				if (chars.contains(s[n]))
+					return n;
+
+			return npos;
+		}
+	}// namespace scalar
+
+#if CPP_SEARCH_X86
+	namespace sse2
+	{
+		CPP_SEARCH_TARGET("sse2")
+		inline size_t rfind_char(const char* s, size_t n, const char c)
+		{
+			const auto needle = _mm_set1_epi8(c);
+			for (; n >= 16; n -= 16)
+			{
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + n - 16));
+				const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+				if (mask != 0)
+					return n - 16 + (31 - std::countl_zero(mask));
+			}
+
+			return scalar::rfind_char(s, n, c);
+		}
+
+		CPP_SEARCH_TARGET("sse2")
+		inline size_t count_char(const char* s, const size_t n, const char c)
+		{
+			const auto needle = _mm_set1_epi8(c);
+			size_t count = 0;
+			size_t i = 0;
+			for (; i + 16 <= n; i += 16)
+			{
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				count += std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))));
+			}
+
+			return count + scalar::count_char(s + i, n - i, c);
+		}
+
+		// Compares the first and the last byte of needle (m >= 2) against 16 positions at once,
+		// and only runs memcmp on the positions where both match.
+		CPP_SEARCH_TARGET("sse2")
+		inline size_t find(const char* s, const size_t n, const char* needle, const size_t m)
+		{
+			if (m > n)
+				return npos;
+
+			const auto first = _mm_set1_epi8(needle[0]);
+			const auto last = _mm_set1_epi8(needle[m - 1]);
+
+			size_t i = 0;
+			for (; i + m - 1 + 16 <= n; i += 16)
+			{
+				const auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				const auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+				auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+
+				for (; mask != 0; mask &= mask - 1)
+				{
+					const auto offset = i + std::countr_zero(mask);
+					if (memcmp(s + offset + 1, needle + 1, m - 2) == 0)
+						return offset;
+				}
+			}
+
+			return scalar::find(s, n, needle, m, i);
+		}
+	}// namespace sse2
+
+	namespace sse42
+	{
+		// Finds the first character of s that is one of the m <= 16 characters of set.
+		CPP_SEARCH_TARGET("sse4.2")
+		inline size_t find_first_of(const char* s, const size_t n, const char* set, const size_t m)
+		{
+			char set_bytes[16] = {};
+			memcpy(set_bytes, set, m);
+			const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set_bytes));
+
+			size_t i = 0;
+			for (; i + 16 <= n; i += 16)
+			{
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				const auto index = _mm_cmpestri(chars, static_cast<int>(m), block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+				if (index < 16)
+					return i + index;
+			}
+
+			const auto result = scalar::find_first_of(s + i, n - i, set, m);
+			return result == npos ? npos : i + result;
+		}
+
+		// Finds the last character of s that is one of the m <= 16 characters of set.
+		CPP_SEARCH_TARGET("sse4.2")
+		inline size_t find_last_of(const char* s, size_t n, const char* set, const size_t m)
+		{
+			char set_bytes[16] = {};
+			memcpy(set_bytes, set, m);
+			const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set_bytes));
+
+			for (; n >= 16; n -= 16)
+			{
+				const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + n - 16));
+				const auto index = _mm_cmpestri(chars, static_cast<int>(m), block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_MOST_SIGNIFICANT);
+				if (index < 16)
+					return n - 16 + index;
+			}
+
+			return scalar::find_last_of(s, n, set, m);
+		}
+	}// namespace sse42
+
+	namespace avx2
+	{
+		CPP_SEARCH_TARGET("avx2")
+		inline size_t rfind_char(const char* s, size_t n, const char c)
+		{
+			const auto needle = _mm256_set1_epi8(c);
+			for (; n >= 32; n -= 32)
+			{
+				const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + n - 32));
+				const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+				if (mask != 0)
+					return n - 32 + (31 - std::countl_zero(mask));
+			}
+
+			return sse2::rfind_char(s, n, c);
+		}
+
+		CPP_SEARCH_TARGET("avx2,popcnt")
+		inline size_t count_char(const char* s, const size_t n, const char c)
+		{
+			const auto needle = _mm256_set1_epi8(c);
+			size_t count = 0;
+			size_t i = 0;
+			for (; i + 32 <= n; i += 32)
+			{
+				const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+				count += std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))));
+			}
+
+			return count + scalar::count_char(s + i, n - i, c);
+		}
+
+		// The 32-wide version of sse2::find().
+		CPP_SEARCH_TARGET("avx2")
+		inline size_t find(const char* s, const size_t n, const char* needle, const size_t m)
+		{
+			if (m > n)
+				return npos;
+
+			const auto first = _mm256_set1_epi8(needle[0]);
+			const auto last = _mm256_set1_epi8(needle[m - 1]);
+
+			size_t i = 0;
+			for (; i + m - 1 + 32 <= n; i += 32)
+			{
+				const auto block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+				const auto block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+				auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+
+				for (; mask != 0; mask &= mask - 1)
+				{
+					const auto offset = i + std::countr_zero(mask);
+					if (memcmp(s + offset + 1, needle + 1, m - 2) == 0)
+						return offset;
+				}
+			}
+
+			return scalar::find(s, n, needle, m, i);
+		}
+	}// namespace avx2
+#endif
+
+	// Returns the index of the first c in the n characters at s.
+	// memchr is already vectorized by every C library worth using, so it is the kernel here.
+	inline size_t find_char(const char* s, const size_t n, const char c)
+	{
+		return scalar::find_char(s, n, c);
+	}
+
+	// Returns the index of the last c in the n characters at s.
+	inline size_t rfind_char(const char* s, const size_t n, const char c)
+	{
+#if CPP_SEARCH_X86
+		if (detail::cpu_features().avx2)
+			return avx2::rfind_char(s, n, c);
+		return sse2::rfind_char(s, n, c);
+#else
+		return scalar::rfind_char(s, n, c);
+#endif
+	}
+
+	// Returns how many times c occurs in the n characters at s.
+	inline size_t count_char(const char* s, const size_t n, const char c)
+	{
+#if CPP_SEARCH_X86
+		if (detail::cpu_features().avx2)
+			return avx2::count_char(s, n, c);
+		return sse2::count_char(s, n, c);
+#else
+		return scalar::count_char(s, n, c);
+#endif
+	}
+
+	// Returns the index of the first occurrence of the m characters at needle in the n characters at s.
+	// An empty needle is found at index 0.
+	inline size_t find(const char* s, const size_t n, const char* needle, const size_t m)
+	{
+		if (m == 0)
+			return 0;
+
+		if (m == 1)
+			return find_char(s, n, needle[0]);
+
+#if CPP_SEARCH_X86
+		if (detail::cpu_features().avx2)
+			return avx2::find(s, n, needle, m);
+		return sse2::find(s, n, needle, m);
+#else
+		return scalar::find(s, n, needle, m);
+#endif
+	}
+
+	// Returns the index of the last occurrence of the m characters at needle in the n characters at s.
+	// An empty needle is found at index n.
+	inline size_t rfind(const char* s, const size_t n, const char* needle, const size_t m)
+	{
+		if (m > n)
+			return npos;
+
+		if (m == 0)
+			return n;
+
+		// Candidates are the positions of the first needle character, searched for backwards.
+		auto end = n - m + 1;
+		while (end > 0)
+		{
+			const auto candidate = rfind_char(s, end, needle[0]);
+			if (candidate == npos)
+				return npos;
+
+			if (memcmp(s + candidate + 1, needle + 1, m - 1) == 0)
+				return candidate;
+
+			end = candidate;
+		}
+
+		return npos;
+	}
+
+	// Returns how many non-overlapping occurrences of the m > 0 characters at needle
+	// are in the n characters at s.
+	inline size_t count(const char* s, const size_t n, const char* needle, const size_t m)
+	{
+		if (m == 1)
+			return count_char(s, n, needle[0]);
+
+		size_t count = 0;
+		for (size_t pos = 0; pos + m <= n; pos += m, ++count)
+		{
+			const auto found = find(s + pos, n - pos, needle, m);
+			if (found == npos)
+				break;
+
+			pos += found;
+		}
+
+		return count;
+	}
+
+	// Returns the index of the first of the n characters at s that is one of the m characters at set.
+	inline size_t find_first_of(const char* s, const size_t n, const char* set, const size_t m)
+	{
+		if (m == 0)
+			return npos;
+
+		if (m == 1)
+			return find_char(s, n, set[0]);
+
+#if CPP_SEARCH_X86
+		if (m <= 16 && detail::cpu_features().sse42)
+			return sse42::find_first_of(s, n, set, m);
+#endif
+		return scalar::find_first_of(s, n, set, m);
+	}
+
+	// Returns the index of the last of the n characters at s that is one of the m characters at set.
+	inline size_t find_last_of(const char* s, const size_t n, const char* set, const size_t m)
+	{
+		if (m == 0)
+			return npos;
+
+		if (m == 1)
+			return rfind_char(s, n, set[0]);
+
+#if CPP_SEARCH_X86
+		if (m <= 16 && detail::cpu_features().sse42)
+			return sse42::find_last_of(s, n, set, m);
+#endif
+		return scalar::find_last_of(s, n, set, m);
+	}
+}// namespace cpp::search
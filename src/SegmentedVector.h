@@ -0,0 +1,522 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Vector.h"
+#include <bit>
+#include <compare>
+#include <iterator>
+#include <memory_resource>
+
+namespace cpp
+{
+	// A vector whose elements live in fixed-size blocks, found through an index of block pointers.
+	//
+	// Growing allocates one more block and never moves an element, so the memory in use stays close to
+	// the live size and references to elements stay valid. Only the index of block pointers is
+	// reallocated, which is block_size times smaller than the elements. Random access costs a shift and
+	// a mask; the iterators walk a block with a plain pointer and only look at the index between blocks.
+	template<typename T, typename Allocator = std::allocator<T>>
+	class SegmentedVector
+	{
+		using AllocTraits = std::allocator_traits<Allocator>;
+		using BlockIndex = Vector<T*, typename AllocTraits::template rebind_alloc<T*>>;
+
+	public:
+		using value_type = T;
+		using allocator_type = Allocator;
+
+		// The number of elements per block: a power of two, with blocks of about 16 KiB.
+		static constexpr size_t block_size = std::bit_floor(std::max<size_t>(1, 16384 / sizeof(T)));
+
+		template<typename ValueType>
+		class SegmentedIterator;
+
+		using ConstIterator = SegmentedIterator<T const>;
+		using It = SegmentedIterator<T>;
+
+		// Constructs an empty container, with no elements.
+		SegmentedVector() = default;
+
+		// Constructs an empty container, with no elements, that allocates through alloc.
+		explicit SegmentedVector(const Allocator& alloc)
+			: _alloc(alloc), _blocks(typename BlockIndex::allocator_type(alloc))
+		{
+		}
+
+		// Constructs a container with a copy of each of the elements in x, in the same order.
+		SegmentedVector(const SegmentedVector& other)
+			: SegmentedVector(other, AllocTraits::select_on_container_copy_construction(other._alloc))
+		{
+		}
+
+		// Constructs a container with a copy of each of the elements in x, in the same order, using alloc.
+		SegmentedVector(const SegmentedVector& other, const Allocator& alloc)
+			: SegmentedVector(alloc)
+		{
+			reserve(other.size());
+
+			for (const auto& element : other)
+				emplace_back(element);
+		}
+
+		// Constructs a container that acquires the elements of x.
+		SegmentedVector(SegmentedVector&& other) noexcept
+			: _alloc(std::move(other._alloc)), _blocks(std::move(other._blocks)), _sz(std::exchange(other._sz, 0))
+		{
+		}
+
+		// Constructs a container with a copy of each of the elements in il, in the same order.
+		SegmentedVector(const std::initializer_list<T>& list, const Allocator& alloc = Allocator())
+			: SegmentedVector(alloc)
+		{
+			reserve(list.size());
+
+			for (const auto& element : list)
+				emplace_back(element);
+		}
+
+		// Destroys the container object.
+		~SegmentedVector()
+		{
+			clear();
+			release_blocks(0);
+		}
+
+		// Returns a copy of the allocator object associated with the vector.
+		allocator_type get_allocator() const noexcept
+		{
+			return _alloc;
+		}
+
+		// Returns a reference to the element at position n in the vector.
+		T& at(const size_t index)
+		{
+			if (index >= _sz)
+				throw std::out_of_range("SegmentedVector subscript out of range");
+			return (*this)[index];
+		}
+
+		// Returns a reference to the element at position n in the vector.
+		const T& at(const size_t index) const
+		{
+			if (index >= _sz)
+				throw std::out_of_range("SegmentedVector subscript out of range");
+			return (*this)[index];
+		}
+
+		// Returns a reference to the element at position n in the vector container.
+		T& operator[](const size_t index) noexcept
+		{
+			return _blocks[index / block_size][index % block_size];
+		}
+
+		// Returns a reference to the element at position n in the vector container.
+		const T& operator[](const size_t index) const noexcept
+		{
+			return _blocks[index / block_size][index % block_size];
+		}
+
+		// Returns a reference to the first element in the vector.
+		T& front()
+		{
+			return (*this)[0];
+		}
+
+		// Returns a reference to the first element in the vector.
+		const T& front() const
+		{
+			return (*this)[0];
+		}
+
+		// Returns a reference to the last element in the vector.
+		T& back()
+		{
+			return (*this)[_sz - 1];
+		}
+
+		// Returns a reference to the last element in the vector.
+		const T& back() const
+		{
+			return (*this)[_sz - 1];
+		}
+
+		// Returns whether the vector is empty (i.e. whether its size is 0).
+		bool empty() const noexcept
+		{
+			return _sz == 0;
+		}
+
+		// Returns the number of elements in the vector.
+		size_t size() const noexcept
+		{
+			return _sz;
+		}
+
+		// Returns the maximum number of elements that the vector can hold.
+		size_t max_size() const noexcept
+		{
+			return AllocTraits::max_size(_alloc);
+		}
+
+		// Returns the number of blocks currently allocated.
+		size_t block_count() const noexcept
+		{
+			return _blocks.size();
+		}
+
+		// Returns the number of elements the allocated blocks can hold.
+		size_t capacity() const noexcept
+		{
+			return _blocks.size() * block_size;
+		}
+
+		// Allocates blocks until n elements fit.
+		void reserve(const size_t n)
+		{
+			_blocks.reserve((n + block_size - 1) / block_size);
+
+			while (capacity() < n)
+				add_block();
+		}
+
+		// Releases the blocks that hold no element.
+		void shrink_to_fit()
+		{
+			release_blocks((_sz + block_size - 1) / block_size);
+			_blocks.shrink_to_fit();
+		}
+
+		// Removes all elements from the vector (which are destroyed), leaving the container with a size of 0.
+		// The blocks are kept.
+		void clear() noexcept
+		{
+			while (_sz != 0)
+				pop_back();
+		}
+
+		// Adds a new element at the end of the vector, after its current last element. The content of val is copied to the new element.
+		void push_back(const T& value)
+		{
+			emplace_back(value);
+		}
+
+		// Adds a new element at the end of the vector, after its current last element. The content of val is moved to the new element.
+		void push_back(T&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		// Inserts a new element at the end of the vector, right after its current last element.
+		// This new element is constructed in place using args as the arguments for its constructor.
+		// No element is moved, even when a new block is needed.
+		template<typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (_sz == capacity())
+				add_block();
+
+			auto slot = &(*this)[_sz];
+			AllocTraits::construct(_alloc, slot, std::forward<Args>(args)...);
+			++_sz;
+			return *slot;
+		}
+
+		// Removes the last element in the vector, effectively reducing the container size by one.
+		void pop_back()
+		{
+			--_sz;
+			AllocTraits::destroy(_alloc, &(*this)[_sz]);
+		}
+
+		// Resizes the container so that it contains n elements.
+		// If value is not specified, the default constructor is used instead.
+		void resize(const size_t count, const T& value = {})
+		{
+			while (_sz > count)
+				pop_back();
+
+			reserve(count);
+
+			while (_sz < count)
+				emplace_back(value);
+		}
+
+		// Exchanges the content of the container by the content of x, which is another vector object of the same type. Sizes may differ.
+		void swap(SegmentedVector& other) noexcept
+		{
+			if constexpr (AllocTraits::propagate_on_container_swap::value)
+			{
+				using std::swap;
+				swap(_alloc, other._alloc);
+			}
+
+			_blocks.swap(other._blocks);
+			std::swap(_sz, other._sz);
+		}
+
+		// Assigns new contents to the container, replacing its current contents, and modifying its size accordingly.
+		SegmentedVector& operator=(SegmentedVector&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+		{
+			if (this == &other)
+				return *this;
+
+			clear();
+
+			if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value)
+			{
+				// The blocks of other can only be adopted if our allocator is able to free them.
+				if (_alloc != other._alloc)
+				{
+					reserve(other.size());
+
+					for (auto& element : other)
+						emplace_back(std::move(element));
+
+					other.clear();
+					return *this;
+				}
+			}
+
+			release_blocks(0);
+
+			if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+				_alloc = std::move(other._alloc);
+
+			_blocks = std::move(other._blocks);
+			_sz = std::exchange(other._sz, 0);
+			return *this;
+		}
+
+		// Assigns new contents to the container, replacing its current contents, and modifying its size accordingly.
+		SegmentedVector& operator=(const SegmentedVector& other)
+		{
+			if (this == &other)
+				return *this;
+
+			clear();
+
+			if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+			{
+				if (_alloc != other._alloc)
+				{
+					release_blocks(0);
+					_blocks = BlockIndex(typename BlockIndex::allocator_type(other._alloc));
+				}
+				_alloc = other._alloc;
+			}
+
+			reserve(other.size());
+
+			for (const auto& element : other)
+				emplace_back(element);
+
+			return *this;
+		}
+
+		ConstIterator begin() const noexcept
+		{
+			return ConstIterator(_blocks.data(), _blocks.size(), 0);
+		}
+
+		It begin() noexcept
+		{
+			return It(_blocks.data(), _blocks.size(), 0);
+		}
+
+		ConstIterator end() const noexcept
+		{
+			return ConstIterator(_blocks.data(), _blocks.size(), _sz);
+		}
+
+		It end() noexcept
+		{
+			return It(_blocks.data(), _blocks.size(), _sz);
+		}
+
+		// A random access iterator that keeps a pointer into the current block, so that stepping through
+		// a block is a pointer increment and the block index is read once per block.
+		template<typename ValueType>
+		class SegmentedIterator
+		{
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = std::remove_cv_t<ValueType>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = ValueType*;
+			using reference = ValueType&;
+
+			SegmentedIterator() = default;
+
+			// Converts an iterator into a const iterator over the same elements.
+			template<typename OtherValueType>
+			requires(std::is_const_v<ValueType> && std::is_same_v<const OtherValueType, ValueType>)
+			SegmentedIterator(const SegmentedIterator<OtherValueType>& other) noexcept
+				: m_blocks(other.m_blocks), m_block_count(other.m_block_count), m_index(other.m_index), m_ptr(other.m_ptr), m_block_end(other.m_block_end)
+			{
+			}
+
+			reference operator*() const noexcept
+			{
+				return *m_ptr;
+			}
+
+			pointer operator->() const noexcept
+			{
+				return m_ptr;
+			}
+
+			reference operator[](const difference_type n) const noexcept
+			{
+				return *(*this + n);
+			}
+
+			SegmentedIterator& operator++() noexcept
+			{
+				++m_index;
+				if (++m_ptr == m_block_end)
+					seek();
+
+				return *this;
+			}
+
+			SegmentedIterator operator++(int) noexcept
+			{
+				auto copy = *this;
+				++*this;
+				return copy;
+			}
+
+			SegmentedIterator& operator--() noexcept
+			{
+				--m_index;
+				if (m_index % block_size == block_size - 1)
+					seek();
+				else
+					--m_ptr;
+
+				return *this;
+			}
+
+			SegmentedIterator operator--(int) noexcept
+			{
+				auto copy = *this;
+				--*this;
+				return copy;
+			}
+
+			SegmentedIterator& operator+=(const difference_type n) noexcept
+			{
+				m_index += n;
+				seek();
+				return *this;
+			}
+
+			SegmentedIterator& operator-=(const difference_type n) noexcept
+			{
+				return *this += -n;
+			}
+
+			friend SegmentedIterator operator+(SegmentedIterator it, const difference_type n) noexcept
+			{
+				return it += n;
+			}
+
+			friend SegmentedIterator operator+(const difference_type n, SegmentedIterator it) noexcept
+			{
+				return it += n;
+			}
+
+			friend SegmentedIterator operator-(SegmentedIterator it, const difference_type n) noexcept
+			{
+				return it -= n;
+			}
+
+			friend difference_type operator-(const SegmentedIterator& lhs, const SegmentedIterator& rhs) noexcept
+			{
+				return static_cast<difference_type>(lhs.m_index - rhs.m_index);
+			}
+
+			friend bool operator==(const SegmentedIterator& lhs, const SegmentedIterator& rhs) noexcept
+			{
+				return lhs.m_index == rhs.m_index;
+			}
+
+			friend std::strong_ordering operator<=>(const SegmentedIterator& lhs, const SegmentedIterator& rhs) noexcept
+			{
+				return lhs.m_index <=> rhs.m_index;
+			}
+
+		private:
+			friend class SegmentedVector;
+
+			template<typename>
+			friend class SegmentedIterator;
+
+			SegmentedIterator(T* const* blocks, const size_t block_count, const size_t index) noexcept
+				: m_blocks(blocks), m_block_count(block_count), m_index(index)
+			{
+				seek();
+			}
+
+			// Points m_ptr at m_index, looking its block up in the index. Past the last block there is
+			// nothing to point at, which only happens for an end iterator.
+			void seek() noexcept
+			{
+				const auto block = m_index / block_size;
+				if (block >= m_block_count)
+				{
+					m_ptr = m_block_end = nullptr;
+					return;
+				}
+
+				m_ptr = m_blocks[block] + m_index % block_size;
+				m_block_end = m_blocks[block] + block_size;
+			}
+
+			T* const* m_blocks = nullptr;
+			size_t m_block_count = 0;
+			size_t m_index = 0;
+			ValueType* m_ptr = nullptr;
+			ValueType* m_block_end = nullptr;
+		};
+
+	private:
+		void add_block()
+		{
+			auto block = AllocTraits::allocate(_alloc, block_size);
+
+			try
+			{
+				_blocks.push_back(block);
+			}
+			catch (...)
+			{
+				AllocTraits::deallocate(_alloc, block, block_size);
+				throw;
+			}
+		}
+
+		// Frees the blocks from index first on, which must hold no element.
+		void release_blocks(const size_t first) noexcept
+		{
+			while (_blocks.size() > first)
+			{
+				AllocTraits::deallocate(_alloc, _blocks.back(), block_size);
+				_blocks.pop_back();
+			}
+		}
+
+		[[no_unique_address]] Allocator _alloc{};
+		BlockIndex _blocks{ typename BlockIndex::allocator_type(_alloc) };
+		size_t _sz = 0;
+	};
+
+	namespace pmr
+	{
+		// A SegmentedVector whose blocks and block index come from a std::pmr::memory_resource.
+		template<typename T>
+		using SegmentedVector = cpp::SegmentedVector<T, std::pmr::polymorphic_allocator<T>>;
+	}// namespace pmr
+}// namespace cpp
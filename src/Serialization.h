@@ -0,0 +1,401 @@
+#pragma once
+
+#include "pch.h"
+
+#include "StringView.h"
+#include "Vector.h"
+#include "VectorView.h"
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <system_error>
+
+#include <climits>
+#include <sys/uio.h>
+
+namespace cpp::binary
+{
+	// A binary format for persisting and sending containers without encoding their elements.
+	//
+	// A stream is a sequence of records, one per container. Every record starts with a 32-byte header
+	// that names the kind of record, the format version, the element size and the element count, followed
+	// by the payload and zero padding up to a multiple of record_alignment:
+	//
+	//   - an array record holds the bytes of a contiguous sequence of trivially copyable elements, such as a
+	//     Vector<int>, an Array<double, N> or the characters of a String;
+	//   - a string list record holds a sequence of strings, such as a Vector<String>, as a table of count + 1
+	//     uint64_t offsets followed by the characters of all strings; string i spans [offsets[i], offsets[i + 1]).
+	//
+	// All numbers are little-endian. Since payloads are the in-memory representation of the elements,
+	// writing a container is a single writev() of the header and the container memory, and a Reader
+	// hands out VectorViews and StringViews that point into the buffer instead of copying out of it.
+
+	// The version written into every record. Readers reject records of a newer version.
+	inline constexpr uint16_t format_version = 1;
+
+	// Records start at multiples of this many bytes from the start of the stream.
+	inline constexpr size_t record_alignment = 16;
+
+	static_assert(std::endian::native == std::endian::little, "the binary format stores elements in their native, little-endian representation");
+
+	enum class RecordKind : uint16_t {
+		array = 1,
+		string_list = 2,
+	};
+
+	struct RecordHeader {
+		uint32_t magic;
+		uint16_t version;
+		RecordKind kind;
+		uint32_t element_size;
+		uint32_t element_alignment;
+		uint64_t count;
+		uint64_t payload_size;
+	};
+
+	inline constexpr uint32_t record_magic = 0x31505043;
+
+	static_assert(sizeof(RecordHeader) == 32 && sizeof(RecordHeader) % record_alignment == 0);
+
+	// A contiguous range whose elements can be written as their bytes.
+	template<typename Range>
+	concept TriviallyCopyableRange = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>
+		&& std::is_trivially_copyable_v<std::ranges::range_value_t<Range>> && !std::is_pointer_v<std::ranges::range_value_t<Range>>
+		&& !std::is_convertible_v<std::ranges::range_value_t<Range>, StringView> && alignof(std::ranges::range_value_t<Range>) <= record_alignment;
+
+	// A range of strings, such as a Vector<String> or a Vector<StringView>.
+	template<typename Range>
+	concept StringRange = std::ranges::sized_range<Range> && std::is_convertible_v<std::ranges::range_reference_t<Range>, StringView>
+		&& !TriviallyCopyableRange<Range>;
+
+	namespace detail
+	{
+		inline constexpr std::byte zero_padding[record_alignment] = {};
+
+		constexpr size_t padding_after(const size_t payload_size) noexcept
+		{
+			return (record_alignment - payload_size % record_alignment) % record_alignment;
+		}
+
+		// Writes all the buffers of iov to fd, resuming after partial writes and interrupted calls,
+		// with as few writev() calls as the system allows.
+		inline void write_all(const int fd, iovec* iov, size_t count)
+		{
+			while (count > 0)
+			{
+				const auto written = ::writev(fd, iov, static_cast<int>(std::min<size_t>(count, IOV_MAX)));
+				if (written < 0)
+				{
+					if (errno == EINTR)
+						continue;
+
+					throw std::system_error(errno, std::generic_category(), "binary::write failed");
+				}
+
+				auto left = static_cast<size_t>(written);
+				while (count > 0 && left >= iov->iov_len)
+				{
+					left -= iov->iov_len;
+					++iov;
+					--count;
+				}
+
+				if (count > 0)
+				{
+					iov->iov_base = static_cast<std::byte*>(iov->iov_base) + left;
+					iov->iov_len -= left;
+				}
+			}
+		}
+
+		inline iovec buffer(const void* p, const size_t n) noexcept
+		{
+			return { const_cast<void*>(p), n };
+		}
+	}// namespace detail
+
+	// Writes range to fd as an array record, with a single writev().
+	// Throws a system_error if writing fails.
+	template<TriviallyCopyableRange Range>
+	void write(const int fd, const Range& range)
+	{
+		using T = std::ranges::range_value_t<Range>;
+
+		const auto count = static_cast<size_t>(std::ranges::size(range));
+		const RecordHeader header{ record_magic, format_version, RecordKind::array, sizeof(T), alignof(T), count, count * sizeof(T) };
+
+		iovec iov[] = {
+			detail::buffer(&header, sizeof(header)),
+			detail::buffer(std::ranges::data(range), header.payload_size),
+			detail::buffer(detail::zero_padding, detail::padding_after(header.payload_size)),
+		};
+
+		detail::write_all(fd, iov, std::size(iov));
+	}
+
+	// Writes strings to fd as a string list record. The characters of every string are written from
+	// where they are; only the offsets table is built. Needs one writev() unless there are more strings than
+	// a single call accepts buffers (IOV_MAX).
+	// Throws a system_error if writing fails.
+	template<StringRange Range>
+	void write(const int fd, const Range& strings)
+	{
+		const auto count = static_cast<size_t>(std::ranges::size(strings));
+
+		Vector<uint64_t> offsets;
+		offsets.reserve(count + 1);
+
+		Vector<iovec> iov;
+		iov.reserve(count + 3);
+		iov.push_back({});
+		iov.push_back({});
+
+		uint64_t offset = 0;
+		offsets.push_back(offset);
+
+		for (const auto& s : strings)
+		{
+			const StringView sv = s;
+			if (!sv.empty())
+				iov.push_back(detail::buffer(sv.data(), sv.size()));
+
+			offset += sv.size();
+			offsets.push_back(offset);
+		}
+
+		const auto payload_size = offsets.size() * sizeof(uint64_t) + offset;
+		const RecordHeader header{ record_magic, format_version, RecordKind::string_list, 1, 1, count, payload_size };
+
+		iov[0] = detail::buffer(&header, sizeof(header));
+		iov[1] = detail::buffer(offsets.data(), offsets.size() * sizeof(uint64_t));
+		iov.push_back(detail::buffer(detail::zero_padding, detail::padding_after(payload_size)));
+
+		detail::write_all(fd, iov.data(), iov.size());
+	}
+
+	// A view of the strings of a string list record.
+	class StringListView
+	{
+	public:
+		// Iterates over the strings of the list, presenting each of them as a StringView.
+		class ConstIt
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = StringView;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = StringView;
+
+			ConstIt() = default;
+
+			StringView operator*() const noexcept
+			{
+				return (*m_list)[m_index];
+			}
+
+			ConstIt& operator++() noexcept
+			{
+				++m_index;
+				return *this;
+			}
+
+			ConstIt operator++(int) noexcept
+			{
+				auto copy = *this;
+				++m_index;
+				return copy;
+			}
+
+			friend bool operator==(const ConstIt& lhs, const ConstIt& rhs) noexcept
+			{
+				return lhs.m_index == rhs.m_index;
+			}
+
+		private:
+			friend class StringListView;
+
+			ConstIt(const StringListView* list, const size_t index) noexcept
+				: m_list(list), m_index(index)
+			{
+			}
+
+			const StringListView* m_list = nullptr;
+			size_t m_index = 0;
+		};
+
+		// Constructs an empty list.
+		StringListView() = default;
+
+		// Constructs a list of offsets.size() - 1 strings whose characters start at chars.
+		StringListView(const VectorView<uint64_t> offsets, const char* chars) noexcept
+			: m_offsets(offsets), m_chars(chars)
+		{
+		}
+
+		// Returns the number of strings in the list.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+		}
+
+		// Returns whether the list holds no string.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		// Returns the string at position index in the list.
+		StringView operator[](const size_t index) const noexcept
+		{
+			return { m_chars + m_offsets[index], static_cast<size_t>(m_offsets[index + 1] - m_offsets[index]) };
+		}
+
+		// Returns the string at position pos in the list,
+		// throwing an out_of_range exception if pos is not less than the size.
+		[[nodiscard]] StringView at(const size_t pos) const
+		{
+			if (pos >= size())
+				throw std::out_of_range("Position outside of string list");
+
+			return (*this)[pos];
+		}
+
+		[[nodiscard]] ConstIt begin() const noexcept
+		{
+			return { this, 0 };
+		}
+
+		[[nodiscard]] ConstIt end() const noexcept
+		{
+			return { this, size() };
+		}
+
+	private:
+		VectorView<uint64_t> m_offsets;
+		const char* m_chars = nullptr;
+	};
+
+	// Reads the records of a stream from a buffer, such as a mapped file or a received message, one
+	// after the other. The views it returns point into the buffer, which must outlive them and must start
+	// at an address aligned to record_alignment.
+	//
+	// Throws a runtime_error when the next record is not of the requested kind or does not fit in the buffer.
+	class Reader
+	{
+	public:
+		// Constructs a reader of the size bytes starting at data.
+		Reader(const void* data, const size_t size) noexcept
+			: m_data(static_cast<const std::byte*>(data)), m_size(size)
+		{
+		}
+
+		// Constructs a reader of the bytes of a contiguous container.
+		template<std::ranges::contiguous_range Range>
+		requires(sizeof(std::ranges::range_value_t<Range>) == 1)
+		explicit Reader(const Range& bytes) noexcept
+			: Reader(std::ranges::data(bytes), std::ranges::size(bytes))
+		{
+		}
+
+		// Returns whether every record has been read.
+		[[nodiscard]] bool done() const noexcept
+		{
+			return m_offset == m_size;
+		}
+
+		// Returns the number of bytes read so far.
+		[[nodiscard]] size_t offset() const noexcept
+		{
+			return m_offset;
+		}
+
+		// Returns the kind of the next record, without reading it.
+		[[nodiscard]] RecordKind peek_kind() const
+		{
+			return next_header().kind;
+		}
+
+		// Reads an array record of elements of type T and returns a view of its elements.
+		template<typename T>
+		requires(std::is_trivially_copyable_v<T>)
+		[[nodiscard]] VectorView<T> read_array()
+		{
+			const auto& header = next_header();
+			if (header.kind != RecordKind::array || header.element_size != sizeof(T) || header.element_alignment != alignof(T))
+				throw std::runtime_error("binary::Reader expected an array of another element type");
+
+			const auto payload = m_data + m_offset + sizeof(RecordHeader);
+			if (header.payload_size / sizeof(T) != header.count || header.payload_size % sizeof(T) != 0)
+				throw std::runtime_error("binary::Reader found a corrupt array record");
+			if (reinterpret_cast<uintptr_t>(payload) % alignof(T) != 0)
+				throw std::runtime_error("binary::Reader buffer is misaligned");
+
+			skip_record(header);
+			return { reinterpret_cast<const T*>(payload), static_cast<size_t>(header.count) };
+		}
+
+		// Reads an array record of characters and returns a view of them.
+		[[nodiscard]] StringView read_string()
+		{
+			const auto chars = read_array<char>();
+			return { chars.data(), chars.size() };
+		}
+
+		// Reads a string list record and returns a view of its strings.
+		[[nodiscard]] StringListView read_strings()
+		{
+			const auto& header = next_header();
+			if (header.kind != RecordKind::string_list)
+				throw std::runtime_error("binary::Reader expected a string list");
+
+			const auto payload = m_data + m_offset + sizeof(RecordHeader);
+			if (header.count >= header.payload_size / sizeof(uint64_t))
+				throw std::runtime_error("binary::Reader found a corrupt string list record");
+
+			const auto table_size = (header.count + 1) * sizeof(uint64_t);
+
+			const VectorView offsets(reinterpret_cast<const uint64_t*>(payload), static_cast<size_t>(header.count + 1));
+			const auto chars_size = header.payload_size - table_size;
+
+			// The offsets are checked once here, so that indexing the list never leaves the record.
+			if (offsets.front() != 0 || offsets.back() != chars_size || !std::ranges::is_sorted(offsets))
+				throw std::runtime_error("binary::Reader found a corrupt string list record");
+
+			skip_record(header);
+			return { offsets, reinterpret_cast<const char*>(payload + table_size) };
+		}
+
+	private:
+		// Returns the header of the next record, once it is known to fit in the buffer together with its payload.
+		[[nodiscard]] const RecordHeader& next_header() const
+		{
+			if (m_size - m_offset < sizeof(RecordHeader))
+				throw std::runtime_error("binary::Reader reached the end of the buffer");
+			if (reinterpret_cast<uintptr_t>(m_data + m_offset) % alignof(RecordHeader) != 0)
+				throw std::runtime_error("binary::Reader buffer is misaligned");
+
+			const auto& header = *reinterpret_cast<const RecordHeader*>(m_data + m_offset);
+			if (header.magic != record_magic)
+				throw std::runtime_error("binary::Reader found no record");
+			if (header.version > format_version)
+				throw std::runtime_error("binary::Reader found a record of a newer format version");
+			if (header.payload_size > m_size - m_offset - sizeof(RecordHeader))
+				throw std::runtime_error("binary::Reader found a truncated record");
+
+			return header;
+		}
+
+		void skip_record(const RecordHeader& header) noexcept
+		{
+			const auto payload_size = static_cast<size_t>(header.payload_size);
+			m_offset = std::min(m_size, m_offset + sizeof(RecordHeader) + payload_size + detail::padding_after(payload_size));
+		}
+
+		const std::byte* m_data;
+		size_t m_size;
+		size_t m_offset = 0;
+	};
+}// namespace cpp::binary
@@ -0,0 +1,525 @@
+#pragma once
+
+#include "Iterator.h"
+#include "Memory.h"
+#include "pch.h"
+
+#include <memory_resource>
+
+namespace cpp
+{
+	// A vector that keeps its first N elements inside the object, like an Array, and only
+	// allocates a heap block once it grows past N. It offers the same interface as Vector.
+	//
+	// Moving a small vector whose elements are inline relocates at most N elements, which is a
+	// single memcpy for trivially relocatable T. A heap block is handed over as in Vector.
+	template<typename T, size_t N, typename Allocator = std::allocator<T>>
+	class SmallVector
+	{
+		static_assert(N > 0, "A SmallVector needs room for at least one inline element");
+
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+	public:
+		using value_type = T;
+		using allocator_type = Allocator;
+
+		// The number of elements that fit into the object without allocating.
+		static constexpr size_t inline_capacity = N;
+
+		// Constructs an empty container, with no elements.
+		SmallVector() noexcept
+		{
+		}
+
+		// Constructs an empty container, with no elements, that allocates through alloc.
+		explicit SmallVector(const Allocator& alloc)
+			: _alloc(alloc)
+		{
+		}
+
+		// Constructs an empty container, with no elements and required cap.
+		explicit SmallVector(const size_t capacity, const Allocator& alloc = Allocator())
+			: _alloc(alloc)
+		{
+			reserve(capacity);
+		}
+
+		// Constructs a container with a copy of each of the elements in x, in the same order.
+		SmallVector(const SmallVector& other)
+			: SmallVector(other, AllocTraits::select_on_container_copy_construction(other._alloc))
+		{
+		}
+
+		// Constructs a container with a copy of each of the elements in x, in the same order, using alloc.
+		SmallVector(const SmallVector& other, const Allocator& alloc)
+			: _alloc(alloc)
+		{
+			reserve(other.size());
+
+			for (; _sz < other.size(); ++_sz)
+				construct(_p + _sz, other[_sz]);
+		}
+
+		// Constructs a container that acquires the elements of x.
+		SmallVector(SmallVector&& other) noexcept
+			: _alloc(std::move(other._alloc))
+		{
+			take(other);
+		}
+
+		// Constructs a container that acquires the elements of x, using alloc.
+		// The elements are moved one by one if x's heap block cannot be freed by alloc.
+		SmallVector(SmallVector&& other, const Allocator& alloc)
+			: _alloc(alloc)
+		{
+			if (other.is_inline() || _alloc == other._alloc)
+			{
+				take(other);
+				return;
+			}
+
+			reserve(other.size());
+
+			for (; _sz < other.size(); ++_sz)
+				construct(_p + _sz, std::move(other[_sz]));
+
+			other.clear();
+		}
+
+		// Constructs a container with a copy of each of the elements in il, in the same order.
+		SmallVector(const std::initializer_list<T>& list, const Allocator& alloc = Allocator())
+			: _alloc(alloc)
+		{
+			auto const& list_data = std::data(list);
+			reserve(list.size());
+
+			for (; _sz < list.size(); ++_sz)
+				construct(_p + _sz, list_data[_sz]);
+		}
+
+		// Destroys the container object.
+		~SmallVector()
+		{
+			clear();
+			release_heap();
+		}
+
+		// Returns a copy of the allocator object associated with the vector.
+		allocator_type get_allocator() const noexcept
+		{
+			return _alloc;
+		}
+
+		// Returns a reference to the element at position n in the vector.
+		T& at(const size_t index)
+		{
+			if (index >= _sz)
+				throw std::out_of_range("SmallVector subscript out of range");
+			return _p[index];
+		}
+
+		// Returns a reference to the element at position n in the vector.
+		const T& at(const size_t index) const
+		{
+			if (index >= _sz)
+				throw std::out_of_range("SmallVector subscript out of range");
+			return _p[index];
+		}
+
+		// Returns a reference to the element at position n in the vector container.
+		T& operator[](const size_t index)
+		{
+			return _p[index];
+		}
+
+		// Returns a reference to the element at position n in the vector container.
+		const T& operator[](const size_t index) const
+		{
+			return _p[index];
+		}
+
+		// Returns a reference to the first element in the vector.
+		T& front()
+		{
+			return _p[0];
+		}
+
+		// Returns a reference to the first element in the vector.
+		const T& front() const
+		{
+			return _p[0];
+		}
+
+		// Returns a reference to the last element in the vector.
+		T& back()
+		{
+			return _p[_sz - 1];
+		}
+
+		// Returns a reference to the last element in the vector.
+		const T& back() const
+		{
+			return _p[_sz - 1];
+		}
+
+		// Returns a direct pointer to the memory array used internally by the vector to store its owned elements.
+		T* data() noexcept
+		{
+			return _p;
+		}
+
+		// Returns a direct pointer to the memory array used internally by the vector to store its owned elements.
+		const T* data() const noexcept
+		{
+			return _p;
+		}
+
+		// Returns whether the vector is empty (i.e. whether its size is 0).
+		bool empty() const noexcept
+		{
+			return _sz == 0;
+		}
+
+		// Returns the number of elements in the vector.
+		size_t size() const noexcept
+		{
+			return _sz;
+		}
+
+		// Returns the maximum number of elements that the vector can hold.
+		size_t max_size() const noexcept
+		{
+			return AllocTraits::max_size(_alloc);
+		}
+
+		// Returns whether the elements are stored inside the object rather than in a heap block.
+		bool is_inline() const noexcept
+		{
+			return _p == inline_data();
+		}
+
+		// Requests that the vector cap be at least enough to contain n elements.
+		void reserve(const size_t new_capacity)
+		{
+			if (_cap >= new_capacity)
+				return;
+
+			reallocate(new_capacity);
+		}
+
+		// Returns the size of the storage space currently available to the vector, expressed in terms of elements.
+		// It is never less than N.
+		size_t capacity() const noexcept
+		{
+			return _cap;
+		}
+
+		// Requests the container to reduce its cap to fit its size.
+		// Elements that fit into the object are moved back inline and the heap block is released.
+		void shrink_to_fit()
+		{
+			if (is_inline() || _cap == _sz)
+				return;
+
+			if (_sz <= N)
+			{
+				auto block = _p;
+				relocate(block, _sz, inline_data());
+				AllocTraits::deallocate(_alloc, block, _cap);
+
+				_p = inline_data();
+				_cap = N;
+				return;
+			}
+
+			reallocate(_sz);
+		}
+
+		// Removes all elements from the vector (which are destroyed), leaving the container with a size of 0.
+		void clear() noexcept
+		{
+			destroy(_p, _p + _sz);
+			_sz = 0;
+		}
+
+		// Adds a new element at the end of the vector, after its current last element. The content of val is copied to the new element.
+		void push_back(const T& value)
+		{
+			emplace_back(value);
+		}
+
+		// Adds a new element at the end of the vector, after its current last element. The content of val is moved to the new element.
+		void push_back(T&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		// Inserts a new element at the end of the vector, right after its current last element.
+		// This new element is constructed in place using args as the arguments for its constructor.
+		template<typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (_cap == _sz)
+				return grow_emplace_back(std::forward<Args>(args)...);
+
+			construct(_p + _sz, std::forward<Args>(args)...);
+			return _p[_sz++];
+		}
+
+		// Removes the last element in the vector, effectively reducing the container size by one.
+		void pop_back()
+		{
+			--_sz;
+			AllocTraits::destroy(_alloc, _p + _sz);
+		}
+
+		// Resizes the container so that it contains n elements.
+		// If value is not specified, the default constructor is used instead.
+		void resize(const size_t count, const T& value = {})
+		{
+			if (count <= _sz)
+			{
+				destroy(_p + count, _p + _sz);
+				_sz = count;
+				return;
+			}
+
+			if (count > _cap)
+			{
+				// value may be an element of this vector, which reserving moves, so it is copied first.
+				const T copy(value);
+				reserve(count);
+				resize(count, copy);
+				return;
+			}
+
+			for (; _sz < count; ++_sz)
+				construct(_p + _sz, value);
+		}
+
+		// Exchanges the content of the container by the content of x, which is another vector object of the same type. Sizes may differ.
+		void swap(SmallVector& other) noexcept
+		{
+			if (this == &other)
+				return;
+
+			// The elements are parked in a third vector that keeps our allocator, so a heap block always
+			// ends up next to the allocator that owns it. Inline elements are relocated, heap blocks are not.
+			SmallVector tmp(_alloc);
+			tmp.take(*this);
+
+			if constexpr (AllocTraits::propagate_on_container_swap::value)
+			{
+				using std::swap;
+				swap(_alloc, other._alloc);
+			}
+
+			take(other);
+			other.take(tmp);
+		}
+
+		// Assigns new contents to the container, replacing its current contents, and modifying its size accordingly.
+		SmallVector& operator=(SmallVector&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+		{
+			if (this == &other)
+				return *this;
+
+			clear();
+
+			if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value)
+			{
+				// A heap block of other can only be adopted if our allocator is able to free it.
+				if (_alloc != other._alloc && !other.is_inline())
+				{
+					reserve(other.size());
+
+					for (; _sz < other.size(); ++_sz)
+						construct(_p + _sz, std::move(other[_sz]));
+
+					other.clear();
+					return *this;
+				}
+			}
+
+			release_heap();
+
+			if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+				_alloc = std::move(other._alloc);
+
+			take(other);
+			return *this;
+		}
+
+		// Assigns new contents to the container, replacing its current contents, and modifying its size accordingly.
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if (this == &other)
+				return *this;
+
+			clear();
+
+			if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+			{
+				if (_alloc != other._alloc)
+					release_heap();
+				_alloc = other._alloc;
+			}
+
+			reserve(other.size());
+
+			for (; _sz < other.size(); ++_sz)
+				construct(_p + _sz, other[_sz]);
+
+			return *this;
+		}
+
+		using ConstIterator = Iterator<SmallVector, T const>;
+		using It = Iterator<SmallVector, T>;
+
+		ConstIterator begin() const noexcept
+		{
+			return ConstIterator(_p);
+		}
+
+		It begin() noexcept
+		{
+			return It(_p);
+		}
+
+		ConstIterator end() const noexcept
+		{
+			return ConstIterator(_p + _sz);
+		}
+
+		It end() noexcept
+		{
+			return It(_p + _sz);
+		}
+
+	private:
+		T* inline_data() noexcept
+		{
+			return reinterpret_cast<T*>(_inline);
+		}
+
+		const T* inline_data() const noexcept
+		{
+			return reinterpret_cast<const T*>(_inline);
+		}
+
+		// Constructs an element at p through the allocator.
+		template<typename... Args>
+		void construct(T* p, Args&&... args)
+		{
+			AllocTraits::construct(_alloc, p, std::forward<Args>(args)...);
+		}
+
+		// Destroys the elements in [first, last) through the allocator.
+		void destroy(T* first, T* last)
+		{
+			for (; first != last; ++first)
+				AllocTraits::destroy(_alloc, first);
+		}
+
+		// Releases the heap block, if any, and goes back to the empty inline storage.
+		// The elements must already be destroyed.
+		void release_heap()
+		{
+			if (!is_inline())
+				AllocTraits::deallocate(_alloc, _p, _cap);
+
+			_p = inline_data();
+			_cap = N;
+		}
+
+		// Takes over the elements of other, which must be allocator-compatible, while this vector is empty
+		// and inline. Other is left empty and inline.
+		void take(SmallVector& other) noexcept
+		{
+			if (other.is_inline())
+			{
+				relocate(other._p, other._sz, _p);
+			}
+			else
+			{
+				_p = other._p;
+				_cap = other._cap;
+				other._p = other.inline_data();
+				other._cap = N;
+			}
+
+			_sz = std::exchange(other._sz, 0);
+		}
+
+		// Moves the live elements into a heap block of exactly new_capacity elements and releases the old block.
+		void reallocate(const size_t new_capacity)
+		{
+			auto block = AllocTraits::allocate(_alloc, new_capacity);
+
+			try
+			{
+				relocate(_p, _sz, block);
+			}
+			catch (...)
+			{
+				AllocTraits::deallocate(_alloc, block, new_capacity);
+				throw;
+			}
+
+			release_heap();
+
+			_p = block;
+			_cap = new_capacity;
+		}
+
+		// Slow path of emplace_back(): the new element is constructed in the grown block before the old
+		// elements are relocated, so args may safely refer to an element of this vector.
+		template<typename... Args>
+		T& grow_emplace_back(Args&&... args)
+		{
+			const auto new_capacity = 1 + _sz * 2;
+			auto block = AllocTraits::allocate(_alloc, new_capacity);
+
+			try
+			{
+				construct(block + _sz, std::forward<Args>(args)...);
+				try
+				{
+					relocate(_p, _sz, block);
+				}
+				catch (...)
+				{
+					destroy(block + _sz, block + _sz + 1);
+					throw;
+				}
+			}
+			catch (...)
+			{
+				AllocTraits::deallocate(_alloc, block, new_capacity);
+				throw;
+			}
+
+			release_heap();
+
+			_p = block;
+			_cap = new_capacity;
+			return _p[_sz++];
+		}
+
+		[[no_unique_address]] Allocator _alloc{};
+		T* _p = inline_data();
+		size_t _sz = 0;
+		size_t _cap = N;
+
+		// Uninitialized room for N elements; only the first _sz are alive while the vector is inline.
+		alignas(T) std::byte _inline[N * sizeof(T)];
+	};
+
+	namespace pmr
+	{
+		// A SmallVector whose heap block comes from a std::pmr::memory_resource.
+		template<typename T, size_t N>
+		using SmallVector = cpp::SmallVector<T, N, std::pmr::polymorphic_allocator<T>>;
+	}// namespace pmr
+}// namespace cpp
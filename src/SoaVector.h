@@ -0,0 +1,552 @@
+#pragma once
+
+#include "pch.h"
+
+#include "GrowthPolicy.h"
+#include "Memory.h"
+#include <array>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+
+namespace cpp
+{
+	// A vector of records stored as a structure of arrays: one contiguous column per field.
+	//
+	// A scan over one field reads only that field's column, so every byte fetched from memory is used,
+	// where a Vector of structs would drag the neighbouring fields through the cache as well. All columns
+	// share one size and one capacity, and live in a single block that is allocated, grown and freed in
+	// one step. Every column starts on its own cache line, which suits vectorized loops over column<I>().
+	//
+	// Rows are accessed through proxy references, std::tuple<Ts&...>, so row-wise code keeps working:
+	//     for (auto [id, x, y] : points) x += 1;
+	template<typename... Ts>
+	class SoaVector
+	{
+		static_assert(sizeof...(Ts) > 0, "a SoaVector needs at least one column");
+
+		static constexpr size_t block_alignment = std::max({ cache_line_size, alignof(Ts)... });
+
+		using Columns = std::tuple<Ts*...>;
+
+		template<bool Const>
+		class RowIterator;
+
+	public:
+		using value_type = std::tuple<Ts...>;
+		using reference = std::tuple<Ts&...>;
+		using const_reference = std::tuple<const Ts&...>;
+		using iterator = RowIterator<false>;
+		using const_iterator = RowIterator<true>;
+
+		// The number of columns (fields per row).
+		static constexpr size_t column_count = sizeof...(Ts);
+
+		template<size_t I>
+		using column_type = std::tuple_element_t<I, value_type>;
+
+		// Constructs an empty container, with no rows.
+		SoaVector() noexcept = default;
+
+		// Constructs a container with a copy of each of the rows in list, in the same order.
+		SoaVector(const std::initializer_list<value_type> list)
+		{
+			reserve(list.size());
+			for (const auto& row : list)
+				std::apply([this](const auto&... fields) { emplace_back(fields...); }, row);
+		}
+
+		// Constructs a container with a copy of each of the rows in other, in the same order.
+		SoaVector(const SoaVector& other)
+			: m_columns(allocate(other.m_size)), m_capacity(other.m_size)
+		{
+			try
+			{
+				apply_to_columns(
+					[&](auto column) { std::uninitialized_copy_n(other.template data<column>(), other.m_size, data<column>()); },
+					[&](auto column) { std::destroy_n(data<column>(), other.m_size); });
+			}
+			catch (...)
+			{
+				deallocate(m_columns, m_capacity);
+				throw;
+			}
+
+			m_size = other.m_size;
+		}
+
+		// Constructs a container that acquires the rows of other.
+		SoaVector(SoaVector&& other) noexcept
+			: m_columns(std::exchange(other.m_columns, {})), m_size(std::exchange(other.m_size, 0)), m_capacity(std::exchange(other.m_capacity, 0))
+		{
+		}
+
+		// Destroys the rows and frees the block.
+		~SoaVector()
+		{
+			clear();
+			deallocate(m_columns, m_capacity);
+		}
+
+		// Replaces the rows with copies of those of other.
+		SoaVector& operator=(const SoaVector& other)
+		{
+			if (this != &other)
+				SoaVector(other).swap(*this);
+
+			return *this;
+		}
+
+		// Replaces the rows with those of other, which is left empty.
+		SoaVector& operator=(SoaVector&& other) noexcept
+		{
+			if (this != &other)
+			{
+				SoaVector(std::move(other)).swap(*this);
+			}
+
+			return *this;
+		}
+
+		// Returns the number of rows.
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		// Returns the number of rows the columns have room for.
+		[[nodiscard]] size_t capacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		// Returns whether the container holds no rows.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		// Returns a pointer to the first element of column I.
+		template<size_t I>
+		[[nodiscard]] column_type<I>* data() noexcept
+		{
+			return std::get<I>(m_columns);
+		}
+
+		// Returns a pointer to the first element of column I.
+		template<size_t I>
+		[[nodiscard]] const column_type<I>* data() const noexcept
+		{
+			return std::get<I>(m_columns);
+		}
+
+		// Returns the elements of column I, one per row.
+		template<size_t I>
+		[[nodiscard]] std::span<column_type<I>> column() noexcept
+		{
+			return { data<I>(), m_size };
+		}
+
+		// Returns the elements of column I, one per row.
+		template<size_t I>
+		[[nodiscard]] std::span<const column_type<I>> column() const noexcept
+		{
+			return { data<I>(), m_size };
+		}
+
+		// Returns the fields of the row at position index.
+		reference operator[](const size_t index) noexcept
+		{
+			return row<reference>(index, std::index_sequence_for<Ts...>());
+		}
+
+		// Returns the fields of the row at position index.
+		const_reference operator[](const size_t index) const noexcept
+		{
+			return row<const_reference>(index, std::index_sequence_for<Ts...>());
+		}
+
+		// Returns the fields of the row at position index,
+		// throwing an out_of_range exception if index is not less than the size.
+		reference at(const size_t index)
+		{
+			if (index >= m_size)
+				throw std::out_of_range("SoaVector subscript out of range");
+
+			return (*this)[index];
+		}
+
+		// Returns the fields of the row at position index,
+		// throwing an out_of_range exception if index is not less than the size.
+		const_reference at(const size_t index) const
+		{
+			if (index >= m_size)
+				throw std::out_of_range("SoaVector subscript out of range");
+
+			return (*this)[index];
+		}
+
+		// Returns the fields of the first row.
+		reference front() noexcept
+		{
+			return (*this)[0];
+		}
+
+		// Returns the fields of the first row.
+		const_reference front() const noexcept
+		{
+			return (*this)[0];
+		}
+
+		// Returns the fields of the last row.
+		reference back() noexcept
+		{
+			return (*this)[m_size - 1];
+		}
+
+		// Returns the fields of the last row.
+		const_reference back() const noexcept
+		{
+			return (*this)[m_size - 1];
+		}
+
+		// Requests that the columns have room for at least new_capacity rows.
+		void reserve(const size_t new_capacity)
+		{
+			if (new_capacity > m_capacity)
+				reallocate(new_capacity);
+		}
+
+		// Requests the container to reduce its capacity to fit its size.
+		void shrink_to_fit()
+		{
+			if (m_capacity != m_size)
+				reallocate(m_size);
+		}
+
+		// Removes all rows, leaving the capacity unchanged.
+		void clear() noexcept
+		{
+			for_each_column([&](auto column) { std::destroy_n(data<column>(), m_size); });
+			m_size = 0;
+		}
+
+		// Appends a row made of copies of values, one per column.
+		void push_back(const Ts&... values)
+		{
+			emplace_back(values...);
+		}
+
+		// Appends a row whose fields are constructed from args, one argument per column.
+		template<typename... Args>
+		requires(sizeof...(Args) == sizeof...(Ts))
+		void emplace_back(Args&&... args)
+		{
+			if (m_size == m_capacity)
+			{
+				// The fields are built before the columns move, in case args refer to fields of this container.
+				value_type row(std::forward<Args>(args)...);
+				reallocate(growth::Doubling::next_capacity(m_capacity, m_size + 1));
+				std::apply([this](auto&&... fields) { construct_row(m_size, std::move(fields)...); }, row);
+			}
+			else
+			{
+				construct_row(m_size, std::forward<Args>(args)...);
+			}
+
+			++m_size;
+		}
+
+		// Removes the last row.
+		void pop_back() noexcept
+		{
+			--m_size;
+			for_each_column([&](auto column) { std::destroy_at(data<column>() + m_size); });
+		}
+
+		// Resizes the container to count rows, appending value-initialized rows or removing rows from the end.
+		void resize(const size_t count)
+		{
+			if (count <= m_size)
+			{
+				for_each_column([&](auto column) { std::destroy(data<column>() + count, data<column>() + m_size); });
+				m_size = count;
+				return;
+			}
+
+			reserve(count);
+			apply_to_columns(
+				[&](auto column) { std::uninitialized_value_construct_n(data<column>() + m_size, count - m_size); },
+				[&](auto column) { std::destroy_n(data<column>() + m_size, count - m_size); });
+
+			m_size = count;
+		}
+
+		// Exchanges the rows of the two containers.
+		void swap(SoaVector& other) noexcept
+		{
+			std::swap(m_columns, other.m_columns);
+			std::swap(m_size, other.m_size);
+			std::swap(m_capacity, other.m_capacity);
+		}
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return { this, 0 };
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return { this, m_size };
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return { this, 0 };
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return { this, m_size };
+		}
+
+	private:
+		// A random access iterator over the rows, whose reference is the proxy tuple of the row's fields.
+		template<bool Const>
+		class RowIterator
+		{
+			using Container = std::conditional_t<Const, const SoaVector, SoaVector>;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = SoaVector::value_type;
+			using difference_type = std::ptrdiff_t;
+			using reference = std::conditional_t<Const, SoaVector::const_reference, SoaVector::reference>;
+			using pointer = void;
+
+			RowIterator() = default;
+
+			// Converts an iterator into a const iterator over the same rows.
+			template<bool OtherConst>
+			requires(Const && !OtherConst)
+			RowIterator(const RowIterator<OtherConst>& other) noexcept
+				: m_container(other.m_container), m_index(other.m_index)
+			{
+			}
+
+			reference operator*() const noexcept
+			{
+				return (*m_container)[m_index];
+			}
+
+			reference operator[](const difference_type n) const noexcept
+			{
+				return (*m_container)[m_index + n];
+			}
+
+			RowIterator& operator++() noexcept
+			{
+				++m_index;
+				return *this;
+			}
+
+			RowIterator operator++(int) noexcept
+			{
+				auto copy = *this;
+				++m_index;
+				return copy;
+			}
+
+			RowIterator& operator--() noexcept
+			{
+				--m_index;
+				return *this;
+			}
+
+			RowIterator operator--(int) noexcept
+			{
+				auto copy = *this;
+				--m_index;
+				return copy;
+			}
+
+			RowIterator& operator+=(const difference_type n) noexcept
+			{
+				m_index += n;
+				return *this;
+			}
+
+			RowIterator& operator-=(const difference_type n) noexcept
+			{
+				m_index -= n;
+				return *this;
+			}
+
+			friend RowIterator operator+(RowIterator it, const difference_type n) noexcept
+			{
+				return it += n;
+			}
+
+			friend RowIterator operator+(const difference_type n, RowIterator it) noexcept
+			{
+				return it += n;
+			}
+
+			friend RowIterator operator-(RowIterator it, const difference_type n) noexcept
+			{
+				return it -= n;
+			}
+
+			friend difference_type operator-(const RowIterator& lhs, const RowIterator& rhs) noexcept
+			{
+				return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+			}
+
+			friend bool operator==(const RowIterator& lhs, const RowIterator& rhs) noexcept
+			{
+				return lhs.m_index == rhs.m_index;
+			}
+
+			friend auto operator<=>(const RowIterator& lhs, const RowIterator& rhs) noexcept
+			{
+				return lhs.m_index <=> rhs.m_index;
+			}
+
+		private:
+			friend class SoaVector;
+			friend class RowIterator<true>;
+
+			RowIterator(Container* container, const size_t index) noexcept
+				: m_container(container), m_index(index)
+			{
+			}
+
+			Container* m_container = nullptr;
+			size_t m_index = 0;
+		};
+
+		template<typename Row, size_t... I>
+		Row row(const size_t index, std::index_sequence<I...>) const noexcept
+		{
+			return Row(std::get<I>(m_columns)[index]...);
+		}
+
+		// Calls f(std::integral_constant<size_t, I>()) for every column I, in order.
+		template<typename F>
+		static void for_each_column(F&& f)
+		{
+			[&]<size_t... I>(std::index_sequence<I...>) {
+				(f(std::integral_constant<size_t, I>()), ...);
+			}(std::index_sequence_for<Ts...>());
+		}
+
+		// Calls step for every column in order. If a step throws, calls undo for the columns whose step
+		// completed, then rethrows, so a row or a range of rows is either built in every column or in none.
+		template<typename Step, typename Undo>
+		static void apply_to_columns(Step&& step, Undo&& undo)
+		{
+			size_t done = 0;
+
+			try
+			{
+				for_each_column([&](auto column) {
+					step(column);
+					++done;
+				});
+			}
+			catch (...)
+			{
+				for_each_column([&](auto column) {
+					if (column < done)
+						undo(column);
+				});
+				throw;
+			}
+		}
+
+		template<typename... Args>
+		void construct_row(const size_t index, Args&&... args)
+		{
+			auto fields = std::forward_as_tuple(std::forward<Args>(args)...);
+
+			apply_to_columns(
+				[&](auto column) { std::construct_at(data<column>() + index, std::forward<std::tuple_element_t<column, decltype(fields)>>(std::get<column>(fields))); },
+				[&](auto column) { std::destroy_at(data<column>() + index); });
+		}
+
+		// Returns the offsets of the columns in a block for capacity rows, followed by the size of the block.
+		// Every column is padded to a multiple of the block alignment, so the next one starts as aligned as the block.
+		static std::array<size_t, sizeof...(Ts) + 1> layout(const size_t capacity) noexcept
+		{
+			std::array<size_t, sizeof...(Ts) + 1> offsets{};
+			size_t offset = 0;
+
+			for_each_column([&](auto column) {
+				offsets[column] = offset;
+				offset += (capacity * sizeof(column_type<column>) + block_alignment - 1) / block_alignment * block_alignment;
+			});
+
+			offsets.back() = offset;
+			return offsets;
+		}
+
+		static Columns allocate(const size_t capacity)
+		{
+			if (capacity == 0)
+				return {};
+
+			const auto offsets = layout(capacity);
+			auto block = static_cast<std::byte*>(::operator new(offsets.back(), std::align_val_t{ block_alignment }));
+
+			Columns columns;
+			for_each_column([&](auto column) { std::get<column>(columns) = reinterpret_cast<column_type<column>*>(block + offsets[column]); });
+			return columns;
+		}
+
+		// The first column starts at the beginning of the block.
+		static void deallocate(const Columns& columns, const size_t capacity) noexcept
+		{
+			if (capacity != 0)
+				::operator delete(std::get<0>(columns), layout(capacity).back(), std::align_val_t{ block_alignment });
+		}
+
+		// Moves the rows into a block for new_capacity rows, which must be at least the size, and frees the old one.
+		// If a column cannot be moved without the risk of a throw, every column is copied before any old row is
+		// destroyed, so a throwing copy leaves the vector as it was.
+		void reallocate(const size_t new_capacity)
+		{
+			auto columns = allocate(new_capacity);
+
+			if constexpr ((std::is_nothrow_move_constructible_v<Ts> && ...))
+			{
+				for_each_column([&](auto column) { relocate(data<column>(), m_size, std::get<column>(columns)); });
+			}
+			else
+			{
+				try
+				{
+					apply_to_columns(
+						[&](auto column) { uninitialized_move_if_noexcept(data<column>(), m_size, std::get<column>(columns)); },
+						[&](auto column) { std::destroy_n(std::get<column>(columns), m_size); });
+				}
+				catch (...)
+				{
+					deallocate(columns, new_capacity);
+					throw;
+				}
+
+				for_each_column([&](auto column) { std::destroy_n(data<column>(), m_size); });
+			}
+
+			deallocate(m_columns, m_capacity);
+			m_columns = columns;
+			m_capacity = new_capacity;
+		}
+
+		Columns m_columns{};
+		size_t m_size = 0;
+		size_t m_capacity = 0;
+	};
+}// namespace cpp
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Array.h"
+#include "Memory.h"
+#include <atomic>
+
+namespace cpp
+{
+	// A bounded, lock-free queue between exactly one producer thread and one consumer thread.
+	//
+	// The elements live in an Array of N slots, so the ring never allocates. head and tail count every
+	// element ever popped and pushed; the slot of an index is index % N, which is a mask since N is a
+	// power of two. Each side writes only its own index and keeps a cached copy of the other one, so it
+	// touches the other side's cache line only when the ring looks full (or empty) to it.
+	//
+	// T must be default constructible, since the slots are always alive, and move assignable.
+	template<typename T, size_t N>
+	class SpscRing
+	{
+		static_assert(N >= 2 && (N & (N - 1)) == 0, "The capacity of a SpscRing must be a power of two");
+		static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>);
+
+	public:
+		using value_type = T;
+
+		SpscRing() = default;
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		// Returns the number of elements the ring can hold.
+		static constexpr size_t capacity() noexcept
+		{
+			return N;
+		}
+
+		// Producer: copies value into the ring. Returns false if the ring is full.
+		bool try_push(const T& value)
+		{
+			const auto tail = m_producer.tail.load(std::memory_order_relaxed);
+			if (!has_room(tail))
+				return false;
+
+			slots()[tail & mask] = value;
+			m_producer.tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Producer: moves value into the ring. Returns false if the ring is full, in which case value is left untouched.
+		bool try_push(T&& value)
+		{
+			const auto tail = m_producer.tail.load(std::memory_order_relaxed);
+			if (!has_room(tail))
+				return false;
+
+			slots()[tail & mask] = std::move(value);
+			m_producer.tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Producer: assigns T(args...) to the next slot. Returns false if the ring is full.
+		template<typename... Args>
+		bool try_emplace(Args&&... args)
+		{
+			const auto tail = m_producer.tail.load(std::memory_order_relaxed);
+			if (!has_room(tail))
+				return false;
+
+			slots()[tail & mask] = T(std::forward<Args>(args)...);
+			m_producer.tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Producer: copies up to n elements from items into the ring, as at most two contiguous blocks.
+		// Returns the number of elements pushed, which is less than n when the ring fills up.
+		size_t try_push_n(const T* items, const size_t n)
+		{
+			const auto tail = m_producer.tail.load(std::memory_order_relaxed);
+			if (N - (tail - m_producer.cached_head) < n)
+				m_producer.cached_head = m_consumer.head.load(std::memory_order_acquire);
+
+			const auto count = std::min(n, N - (tail - m_producer.cached_head));
+			if (count == 0)
+				return 0;
+
+			const auto first = tail & mask;
+			const auto until_wrap = std::min(count, N - first);
+			std::copy(items, items + until_wrap, slots() + first);
+			std::copy(items + until_wrap, items + count, slots());
+
+			m_producer.tail.store(tail + count, std::memory_order_release);
+			return count;
+		}
+
+		// Consumer: moves the oldest element into out. Returns false if the ring is empty.
+		bool try_pop(T& out)
+		{
+			const auto head = m_consumer.head.load(std::memory_order_relaxed);
+			if (head == m_consumer.cached_tail)
+			{
+				m_consumer.cached_tail = m_producer.tail.load(std::memory_order_acquire);
+				if (head == m_consumer.cached_tail)
+					return false;
+			}
+
+			out = std::move(slots()[head & mask]);
+
+			m_consumer.head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer: moves up to n of the oldest elements into out, as at most two contiguous blocks.
+		// Returns the number of elements popped, which is less than n when the ring runs empty.
+		size_t try_pop_n(T* out, const size_t n)
+		{
+			const auto head = m_consumer.head.load(std::memory_order_relaxed);
+			if (m_consumer.cached_tail - head < n)
+				m_consumer.cached_tail = m_producer.tail.load(std::memory_order_acquire);
+
+			const auto count = std::min(n, m_consumer.cached_tail - head);
+			if (count == 0)
+				return 0;
+
+			const auto first = head & mask;
+			const auto until_wrap = std::min(count, N - first);
+			std::move(slots() + first, slots() + first + until_wrap, out);
+			std::move(slots(), slots() + (count - until_wrap), out + until_wrap);
+
+			m_consumer.head.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		// Returns the number of elements in the ring. The value is exact only while neither side is running.
+		[[nodiscard]] size_t size_approx() const noexcept
+		{
+			const auto head = m_consumer.head.load(std::memory_order_acquire);
+			const auto tail = m_producer.tail.load(std::memory_order_acquire);
+			return tail - head;
+		}
+
+		// Returns whether the ring is empty. The value is exact only while neither side is running.
+		[[nodiscard]] bool empty_approx() const noexcept
+		{
+			return size_approx() == 0;
+		}
+
+	private:
+		static constexpr size_t mask = N - 1;
+
+		T* slots() noexcept
+		{
+			return m_slots.data();
+		}
+
+		// Producer: returns whether the slot of tail is free, reloading the consumer's head only when the
+		// cached copy says the ring is full.
+		bool has_room(const size_t tail) noexcept
+		{
+			if (tail - m_producer.cached_head < N)
+				return true;
+
+			m_producer.cached_head = m_consumer.head.load(std::memory_order_acquire);
+			return tail - m_producer.cached_head < N;
+		}
+
+		// Written by the producer only; the consumer reads tail.
+		struct alignas(cache_line_size) ProducerSide {
+			std::atomic<size_t> tail = 0;
+			size_t cached_head = 0;
+		};
+
+		// Written by the consumer only; the producer reads head.
+		struct alignas(cache_line_size) ConsumerSide {
+			std::atomic<size_t> head = 0;
+			size_t cached_tail = 0;
+		};
+
+		ProducerSide m_producer;
+		ConsumerSide m_consumer;
+		alignas(cache_line_size) Array<T, N> m_slots;
+	};
+}// namespace cpp
@@ -2,180 +2,255 @@
 
 #include "pch.h"
 
+#include "AllocationStats.h"
+#include "GrowthPolicy.h"
 #include "Iterator.h"
-#include <cstring>
+#include "Memory.h"
+#include "StringView.h"
+#include <memory_resource>
+#include <string>
 
 namespace cpp
 {
-	class String
+	// A string of chars with the small-string optimization: up to sso_capacity characters are kept
+	// inside the object itself, longer strings live in a buffer obtained from the allocator.
+	//
+	// With an empty allocator such as std::allocator, sizeof(String) is four pointers (32 bytes on
+	// 64-bit targets): 24 bytes that hold either the heap pointer, size and capacity or the inline
+	// characters with their terminator, one byte with the inline length, and padding.
+	//
+	// Appends that outgrow the buffer move to one whose capacity GrowthPolicy picks (growth::Doubling by default).
+	template<typename Allocator = std::allocator<char>, growth::GrowthPolicy GrowthPolicy = growth::Doubling>
+	class BasicString
 	{
+		using AllocTraits = std::allocator_traits<Allocator>;
+		using Traits = std::char_traits<char>;
+
+		static_assert(!GrowthPolicy::round_to_size_class || SizeReportingAllocator<Allocator, char>,
+					  "growth::SizeClass needs an allocator that reports usable sizes, such as MallocAllocator");
+
 	public:
+		using value_type = char;
+		using allocator_type = Allocator;
+
 		// npos is a static member constant value with the greatest possible value for an element of type size_t.
 		// This constant is defined with a value of -1, which because size_t is an unsigned integral type,
 		// it is the largest possible representable value for this type.
 		static constexpr size_t npos = -1;
 
+		// The longest string that is stored without allocating.
+		static constexpr size_t sso_capacity = 3 * sizeof(size_t) - 1;
+
 		// Constructs an empty string, with a length of zero characters.
-		String() = default;
+		constexpr BasicString() = default;
+
+		// Constructs an empty string that allocates through alloc.
+		constexpr explicit BasicString(const Allocator& alloc)
+			: m_alloc(alloc)
+		{
+		}
 
 		// Destroys the string object.
-		~String() = default;
+		constexpr ~BasicString()
+		{
+			if (is_heap())
+				deallocate(m_data.heap.buf, m_data.heap.capacity + 1);
+		}
 
 		// Copies the null-terminated character sequence (C-string) pointed by s.
-		String(const char* other)
+		constexpr BasicString(const char* other, const Allocator& alloc = Allocator())
+			: BasicString(other, Traits::length(other), alloc)
 		{
-			auto length = strlen(other) + 1;
-			auto buffer = new char[length];
+		}
 
-			strcpy_s(buffer, length, other);
-			m_data = {buffer, length - 1, length};
+		// Copies the first n characters from the array of characters pointed by s.
+		constexpr BasicString(const char* other, const size_t n, const Allocator& alloc = Allocator())
+			: m_alloc(alloc)
+		{
+			if (n > sso_capacity)
+				make_heap(allocate(n + 1), n);
+
+			Traits::copy(data(), other, n);
+			set_length(n);
+		}
+
+		// Copies the characters of the view sv.
+		constexpr explicit BasicString(const StringView sv, const Allocator& alloc = Allocator())
+			: BasicString(sv.data(), sv.size(), alloc)
+		{
 		}
 
 		// Constructs a copy of str.
-		String(const String& other)
+		constexpr BasicString(const BasicString& other)
+			: BasicString(other, AllocTraits::select_on_container_copy_construction(other.m_alloc))
+		{
+		}
+
+		// Constructs a copy of str that allocates through alloc.
+		constexpr BasicString(const BasicString& other, const Allocator& alloc)
+			: BasicString(other.c_str(), other.size(), alloc)
 		{
-			auto buffer = new char[other.capacity()];
-			strcpy_s(buffer, other.capacity(), other.m_data.buf);
-			m_data = {buffer, other.size(), other.capacity()};
+			stats::on_copy<BasicString>(other.size(), other.size());
 		}
 
 		// Acquires the contents of str.
-		String(String&& other) noexcept
+		constexpr BasicString(BasicString&& other) noexcept
+			: m_alloc(std::move(other.m_alloc)), m_data(std::exchange(other.m_data, {}))
 		{
-			m_data = other.m_data;
+		}
+
+		// Acquires the contents of str if alloc can free its buffer, otherwise copies them.
+		constexpr BasicString(BasicString&& other, const Allocator& alloc)
+			: m_alloc(alloc)
+		{
+			if (!other.is_heap() || m_alloc == other.m_alloc)
+				m_data = std::exchange(other.m_data, {});
+			else
+				assign(other.c_str(), other.size());
+		}
+
+		// Returns a copy of the allocator object associated with the string.
+		[[nodiscard]] constexpr allocator_type get_allocator() const noexcept
+		{
+			return m_alloc;
 		}
 
 		// Returns a reference to the character at position pos in the string.
 		// The function automatically checks whether pos is the valid position of a
 		// character in the string (i.e., whether pos is less than the string length),
 		// throwing an out_of_range exception if it is not.
-		char& at(const size_t pos)
+		constexpr char& at(const size_t pos)
 		{
 			if (pos > length())
 			{
 				throw std::out_of_range("Position outside of string");
 			}
-			return m_data.buf[pos];
+			return data()[pos];
 		}
 
 		// Returns a reference to the character at position pos in the string.
 		// The function automatically checks whether pos is the valid position of a
 		// character in the string (i.e., whether pos is less than the string length),
 		// throwing an out_of_range exception if it is not.
-		[[nodiscard]] const char& at(const size_t pos) const
+		[[nodiscard]] constexpr const char& at(const size_t pos) const
 		{
 			if (pos > length())
 			{
 				throw std::out_of_range("Position outside of string");
 			}
-			return m_data.buf[pos];
+			return data()[pos];
 		}
 
 		// Returns a reference to the last character of the string.
 		// This function shall not be called on empty strings.
-		[[nodiscard]] char& back()
+		[[nodiscard]] constexpr char& back()
 		{
-			return m_data.buf[size() - 1];
+			return data()[size() - 1];
 		}
 
 		// Returns a reference to the last character of the string.
 		// This function shall not be called on empty strings.
-		[[nodiscard]] char& back() const
+		[[nodiscard]] constexpr const char& back() const
 		{
-			return m_data.buf[size() - 1];
+			return data()[size() - 1];
 		}
 
 		// Returns a reference to the first character of the string.
 		// This function shall not be called on empty strings.
-		[[nodiscard]] char& front() const
+		[[nodiscard]] constexpr const char& front() const
 		{
-			return m_data.buf[0];
+			return data()[0];
 		}
 
 		// Returns a reference to the first character of the string.
 		// This function shall not be called on empty strings.
-		[[nodiscard]] char& front()
+		[[nodiscard]] constexpr char& front()
 		{
-			return m_data.buf[0];
+			return data()[0];
 		}
 
 		// Appends a copy of str.
-		String& append(const String& str)
+		constexpr BasicString& append(const BasicString& str)
 		{
-			return this->append(str.c_str());
+			return this->append(str.c_str(), str.size());
 		}
 
 		// Appends a copy of the string formed by the null-terminated
 		// character sequence (C-string) pointed by s.
-		String& append(const char* str)
+		constexpr BasicString& append(const char* str)
 		{
-			auto sz = length() + strlen(str) + 1;
-			auto buffer = new char[sz];
-
-			strcpy_s(buffer, sz, c_str());
-			strcat_s(buffer, sz, str);
-
-			m_data.move(buffer);
-			m_data.size = sz - 1;
-			m_data.capacity = sz;
+			return this->append(str, Traits::length(str));
+		}
 
-			return *this;
+		// Appends a copy of the characters of the view sv.
+		constexpr BasicString& append(const StringView sv)
+		{
+			return this->append(sv.data(), sv.size());
 		}
 
 		// Appends a copy of a substring of str. The substring is the portion of str that
 		// begins at the character position subpos and spans sublen characters
 		// (or until the end of str, if either str is too short or if sublen is string::npos).
-		String& append(const String& str, const size_t subpos, const size_t sublen = npos)
+		constexpr BasicString& append(const BasicString& str, const size_t subpos, const size_t sublen = npos)
 		{
-			auto sub = str.substr(subpos, sublen);
-			return this->append(sub.c_str());
+			return this->append(str.view(subpos, sublen));
 		}
 
 		// Appends a copy of the first n characters in the array of characters pointed by s.
-		String& append(const char* s, const size_t n)
+		// When the string is full its capacity grows geometrically, so appends are amortized O(n).
+		constexpr BasicString& append(const char* s, const size_t n)
 		{
-			auto buffer = new char[n + 1];
-			strncpy_s(buffer, sizeof(buffer), s, n);
-			this->append(buffer);
-			delete[] buffer;
+			const auto sz = length() + n;
+
+			if (sz > capacity())
+			{
+				// s may point into our own buffer, so it is read before that buffer is released.
+				auto new_capacity = grown_capacity(sz);
+				auto buffer = allocate_buffer(new_capacity);
+				stats::on_grow<BasicString>(sz + 1, new_capacity + 1);
+				stats::on_relocate<BasicString>(length(), length());
+				Traits::copy(buffer, data(), length());
+				Traits::copy(buffer + length(), s, n);
+
+				adopt_buffer(buffer, new_capacity);
+			}
+			else
+			{
+				Traits::copy(data() + length(), s, n);
+			}
 
+			set_length(sz);
 			return *this;
 		}
 
 		// Appends n consecutive copies of character c.
-		String& append(const size_t n, const char c)
+		constexpr BasicString& append(const size_t n, const char c)
 		{
-			auto sz = length() + n + 1;
-			auto buffer = new char[sz];
-
-			auto copy_buffer = new char[n + 1];
-			for (size_t i = 0; i < n; ++i)
+			const auto sz = length() + n;
+			if (sz > capacity())
 			{
-				copy_buffer[i] = c;
+				auto new_capacity = grown_capacity(sz);
+				auto buffer = allocate_buffer(new_capacity);
+				stats::on_grow<BasicString>(sz + 1, new_capacity + 1);
+				replace_buffer(buffer, new_capacity);
 			}
-			copy_buffer[n] = '\0';
-
-			strcpy_s(buffer, sz, c_str());
-			strcat_s(buffer, sz, copy_buffer);
 
-			m_data.move(buffer);
-			m_data.capacity = sz;
-			m_data.size = sz - 1;
+			Traits::assign(data() + length(), n, c);
+			set_length(sz);
 
-			delete[] copy_buffer;
 			return *this;
 		}
 
 		// Returns whether the string is empty (i.e. whether its length is 0).
-		[[nodiscard]] bool empty() const
+		[[nodiscard]] constexpr bool empty() const
 		{
 			return length() == 0;
 		}
 
 		// Erases the contents of the string, which becomes an empty string (with a length of 0 characters).
-		void clear()
+		constexpr void clear()
 		{
-			m_data.size = 0;
+			set_length(0);
 		}
 
 		// Returns a pointer to an array that contains a null-terminated sequence of characters
@@ -183,62 +258,95 @@ namespace cpp
 		//
 		// This array includes the same sequence of characters that make up the value of the string
 		// object plus an additional terminating null-character ('\0') at the end.
-		[[nodiscard]] const char* c_str() const
+		[[nodiscard]] constexpr const char* c_str() const
+		{
+			return data();
+		}
+
+		// Returns a pointer to the characters of the string, which are followed by a null-character.
+		[[nodiscard]] constexpr const char* data() const
 		{
-			return m_data.buf;
+			return is_heap() ? m_data.heap.buf : m_data.local;
 		}
 
-		// Returns the size of the storage space currently allocated for the string, expressed in terms of bytes.
-		[[nodiscard]] size_t capacity() const
+		// Returns a pointer to the characters of the string, which are followed by a null-character.
+		[[nodiscard]] constexpr char* data()
 		{
-			return m_data.capacity;
+			return is_heap() ? m_data.heap.buf : m_data.local;
 		}
 
-		// Returns the size of the storage space currently allocated for the string, expressed in terms of bytes.
-		[[nodiscard]] size_t capacity()
+		// Returns the number of characters the string can hold without reallocating,
+		// which is sso_capacity while the characters are stored inline.
+		[[nodiscard]] constexpr size_t capacity() const
 		{
-			return m_data.capacity;
+			return is_heap() ? m_data.heap.capacity : sso_capacity;
+		}
+
+		// Returns the number of characters the string can hold without reallocating,
+		// which is sso_capacity while the characters are stored inline.
+		[[nodiscard]] constexpr size_t capacity()
+		{
+			return is_heap() ? m_data.heap.capacity : sso_capacity;
 		}
 
 		// Returns the length of the string, in terms of bytes.
-		[[nodiscard]] size_t size() const
+		[[nodiscard]] constexpr size_t size() const
 		{
-			return m_data.size;
+			return is_heap() ? m_data.heap.size : m_data.control;
 		}
 
 		// Returns the length of the string, in terms of bytes.
-		[[nodiscard]] size_t size()
+		[[nodiscard]] constexpr size_t size()
 		{
-			return m_data.size;
+			return is_heap() ? m_data.heap.size : m_data.control;
 		}
 
 		// Returns the length of the string, in terms of bytes.
-		[[nodiscard]] size_t length() const
+		[[nodiscard]] constexpr size_t length() const
 		{
-			return m_data.size;
+			return size();
 		}
 
 		// Returns the length of the string, in terms of bytes.
-		[[nodiscard]] size_t length()
+		[[nodiscard]] constexpr size_t length()
 		{
-			return m_data.size;
+			return size();
+		}
+
+		// Returns whether the characters live in a heap buffer rather than inside the object.
+		[[nodiscard]] constexpr bool is_heap() const
+		{
+			return m_data.control == heap_tag;
 		}
 
 		// Requests the string to reduce its capacity to fit its size.
-		void shrink_to_fit()
+		// A string that fits into the object moves back inline and releases its buffer.
+		constexpr void shrink_to_fit()
 		{
-			if (size() == capacity())
+			if (!is_heap() || size() == capacity())
 				return;
 
-			auto buffer = new char[size()];
-			strcpy_s(buffer, sizeof(buffer), this->m_data.buf);
+			const auto heap = m_data.heap;
+			stats::on_relocate<BasicString>(heap.size, heap.size);
 
-			m_data.move(buffer);
-			m_data.capacity = size();
+			if (heap.size <= sso_capacity)
+			{
+				// Assigning a fresh StringData makes the inline characters the active member of the union again.
+				m_data = {};
+				Traits::copy(m_data.local, heap.buf, heap.size);
+				set_length(heap.size);
+				deallocate(heap.buf, heap.capacity + 1);
+				return;
+			}
+
+			auto buffer = allocate(heap.size + 1);
+			Traits::copy(buffer, heap.buf, heap.size + 1);
+
+			adopt_buffer(buffer, heap.size);
 		}
 
 		// Returns the maximum length the string can reach.
-		static size_t max_size()
+		static constexpr size_t max_size()
 		{
 			return npos;
 		}
@@ -254,25 +362,15 @@ namespace cpp
 		// as needed to reach a size of n. If c is specified, the new
 		// elements are initialized as copies of c, otherwise,
 		// they are value-initialized characters (null characters).
-		void resize(const size_t n, const char c = '\0')
+		constexpr void resize(const size_t n, const char c = '\0')
 		{
-			size_t sz;
-			char* buffer;
-			if (n < length())
+			if (n <= length())
 			{
-				sz = n + 1;
-				buffer = new char[sz];
-				strncpy_s(buffer, sz, c_str(), n);
-			}
-			else
-			{
-				sz = length() + n + 1;
-				buffer = new char[sz];
-				strcpy_s(buffer, sz, this->m_data.buf);
-				strncpy_s(buffer + length(), sz, &c, n);
+				set_length(n);
+				return;
 			}
-			m_data.move(buffer);
-			m_data.size = sz;
+
+			append(n - length(), c);
 		}
 
 		// Requests that the string capacity be adapted to a planned change in
@@ -286,275 +384,474 @@ namespace cpp
 		// otherwise and leave the string with a capacity greater than n.
 		//
 		// This function has no effect on the string length and cannot alter its content.
-		void reserve(const size_t n = 0)
+		constexpr void reserve(const size_t n = 0)
 		{
-			if (capacity() == n)
+			if (capacity() >= n)
 				return;
 
-			if (length() > n)
+			replace_buffer(allocate(n + 1), n);
+		}
+
+		// Appends character c to the end of the string, increasing its length by one.
+		constexpr void push_back(const char c)
+		{
+			const auto sz = length();
+			if (sz == capacity())
 			{
-				shrink_to_fit();
+				this->append(&c, 1);
 				return;
 			}
 
-			auto buffer = new char[n];
-			strcpy_s(buffer, n, m_data.buf);
-			m_data.move(buffer);
-			m_data.capacity = n;
+			data()[sz] = c;
+			set_length(sz + 1);
 		}
 
-		// Appends character c to the end of the string, increasing its length by one.
-		void push_back(const char c)
+		// Replaces the portion of the string that begins at character pos and spans len characters
+		// (or the part of the string in the range between [pos, pos + len)) by a copy of substr.
+		constexpr BasicString& replace(const size_t pos, size_t len, const StringView substr)
 		{
-			this->append(&c);
+			if (pos > size())
+				throw std::out_of_range("Position outside of string");
+
+			len = std::min(len, size() - pos);
+
+			BasicString result(m_alloc);
+			result.reserve(size() - len + substr.size());
+			result.append(c_str(), pos);
+			result.append(substr);
+			result.append(c_str() + pos + len, size() - pos - len);
+
+			return *this = std::move(result);
 		}
 
-		// Copies str.
-		String& replace(const size_t pos, size_t len, const char* substr)
+		// Searches the string for the first occurrence of the sequence specified by its arguments.
+		[[nodiscard]] size_t find(const StringView sv, const size_t pos = 0) const
 		{
-			auto sz = size() + strlen(substr);
-			auto buffer = new char[sz + 1];
+			return view().find(sv, pos);
+		}
 
-			strcpy_s(buffer, sz, c_str());
-			strcat_s(buffer, sz, substr);
+		// Searches the string for the first occurrence of the sequence specified by its arguments.
+		[[nodiscard]] size_t find(const char* s, const size_t pos = 0) const
+		{
+			return view().find(s, pos);
+		}
 
-			m_data.move(buffer);
-			m_data.size = sz;
-			m_data.capacity = sz;
+		// Searches the string for the first occurrence of the sequence specified by its arguments.
+		// n - Length of sequence of characters to match.
+		[[nodiscard]] size_t find(const char* s, const size_t pos, const size_t n) const
+		{
+			return view().find(StringView(s, n), pos);
+		}
 
-			return *this;
+		// Searches the string for the first occurrence of the sequence specified by its arguments.
+		// Individual character to be searched for.
+		[[nodiscard]] size_t find(const char c, const size_t pos = 0) const
+		{
+			return view().find(c, pos);
 		}
 
-		[[nodiscard]] size_t find(const String& str, size_t pos = 0) const
+		// Searches the string for the last occurrence of the sequence specified by its arguments
+		// that begins at or before pos.
+		[[nodiscard]] size_t rfind(const StringView sv, const size_t pos = npos) const
 		{
-			const auto result = strstr(c_str(), str.c_str());
+			return view().rfind(sv, pos);
+		}
 
-			const size_t index = result - c_str();
-			if (result == nullptr)
-				return npos;
+		// Searches the string for the last occurrence of the sequence specified by its arguments
+		// that begins at or before pos.
+		[[nodiscard]] size_t rfind(const char* s, const size_t pos = npos) const
+		{
+			return view().rfind(s, pos);
+		}
 
-			return index;
+		// Searches the string for the last occurrence of the sequence specified by its arguments
+		// that begins at or before pos.
+		// n - Length of sequence of characters to match.
+		[[nodiscard]] size_t rfind(const char* s, const size_t pos, const size_t n) const
+		{
+			return view().rfind(StringView(s, n), pos);
 		}
 
-		// Searches the string for the first occurrence of the sequence specified by its arguments.
-		[[nodiscard]] size_t find(const char* s, size_t pos = 0) const
+		// Searches the string for the last occurrence of character c at or before pos.
+		[[nodiscard]] size_t rfind(const char c, const size_t pos = npos) const
 		{
-			const auto result = strstr(c_str(), s);
+			return view().rfind(c, pos);
+		}
 
-			const size_t index = result - c_str();
-			if (result == nullptr)
-				return npos;
+		// Searches the string for the first character at or after pos that matches any of the characters in sv.
+		[[nodiscard]] size_t find_first_of(const StringView sv, const size_t pos = 0) const
+		{
+			return view().find_first_of(sv, pos);
+		}
 
-			return index;
+		// Searches the string for the first character at or after pos that matches any of the characters in s.
+		[[nodiscard]] size_t find_first_of(const char* s, const size_t pos = 0) const
+		{
+			return view().find_first_of(s, pos);
 		}
 
-		// Searches the string for the first occurrence of the sequence specified by its arguments.
-		// n - Length of sequence of characters to match.
-		[[nodiscard]] size_t find(const char* s, size_t pos, size_t n) const
+		// Searches the string for the first character at or after pos that matches any of the first n characters in s.
+		[[nodiscard]] size_t find_first_of(const char* s, const size_t pos, const size_t n) const
 		{
-			const auto temp = new char[n + 1];
+			return view().find_first_of(StringView(s, n), pos);
+		}
 
-			for (size_t i = 0; i < n; ++i)
-				temp[i] = s[i];
+		// Searches the string for the first occurrence of character c at or after pos.
+		[[nodiscard]] size_t find_first_of(const char c, const size_t pos = 0) const
+		{
+			return view().find_first_of(c, pos);
+		}
 
-			const auto result = strstr(c_str(), temp);
+		// Searches the string for the last character at or before pos that matches any of the characters in sv.
+		[[nodiscard]] size_t find_last_of(const StringView sv, const size_t pos = npos) const
+		{
+			return view().find_last_of(sv, pos);
+		}
 
-			const size_t index = result - c_str();
-			delete[] temp;
+		// Searches the string for the last character at or before pos that matches any of the characters in s.
+		[[nodiscard]] size_t find_last_of(const char* s, const size_t pos = npos) const
+		{
+			return view().find_last_of(s, pos);
+		}
 
-			if (result == nullptr)
-				return npos;
+		// Searches the string for the last character at or before pos that matches any of the first n characters in s.
+		[[nodiscard]] size_t find_last_of(const char* s, const size_t pos, const size_t n) const
+		{
+			return view().find_last_of(StringView(s, n), pos);
+		}
 
-			return index;
+		// Searches the string for the last occurrence of character c at or before pos.
+		[[nodiscard]] size_t find_last_of(const char c, const size_t pos = npos) const
+		{
+			return view().find_last_of(c, pos);
 		}
 
-		// Searches the string for the first occurrence of the sequence specified by its arguments.
-		// Individual character to be searched for.
-		[[nodiscard]] size_t find(const char c, const size_t pos = 0) const
+		// Returns the number of non-overlapping occurrences of sv in the string.
+		// An empty sequence is not counted.
+		[[nodiscard]] size_t count(const StringView sv) const
 		{
-			for (auto i = pos; i < length(); ++i)
-				if (m_data.buf[i] == c)
-					return i;
+			return view().count(sv);
+		}
 
-			return npos;
+		// Returns the number of non-overlapping occurrences of the null-terminated character sequence s in the string.
+		[[nodiscard]] size_t count(const char* s) const
+		{
+			return view().count(s);
 		}
 
-		// Returns a newly constructed string object with its value initialized to a copy of a substring of this object.
-		[[nodiscard]] String substr(size_t pos = 0, size_t len = npos) const
+		// Returns the number of non-overlapping occurrences of the first n characters of s in the string.
+		// An empty sequence is not counted.
+		[[nodiscard]] size_t count(const char* s, const size_t n) const
 		{
-			if (pos > length() || pos + len > length())
-			{
-				return {};
-			}
+			return view().count(StringView(s, n));
+		}
+
+		// Returns the number of occurrences of character c in the string.
+		[[nodiscard]] size_t count(const char c) const
+		{
+			return view().count(c);
+		}
 
-			size_t sz = 0;
+		// Returns a view of the len characters starting at pos (or until the end of the string, if it is too short),
+		// without copying them. The view is invalidated by any change to the string.
+		// Like substr(), returns an empty view if pos is past the end.
+		[[nodiscard]] constexpr StringView view(const size_t pos = 0, const size_t len = npos) const noexcept
+		{
+			return StringView(data(), size()).substr(pos, len);
+		}
 
-			if (len == npos)
-			{
-				sz = length() - pos;
-			}
-			else
+		// Returns a view of all the characters of the string, see view().
+		constexpr operator StringView() const noexcept
+		{
+			return view();
+		}
+
+		// Returns a newly constructed string object with its value initialized to a copy of a substring of this object.
+		// The new string allocates through the same allocator as this one; use view() to avoid the copy.
+		[[nodiscard]] constexpr BasicString substr(size_t pos = 0, size_t len = npos) const
+		{
+			if (pos > length())
 			{
-				sz = len + 1;
+				return BasicString(m_alloc);
 			}
 
-			auto buffer = new char[sz];
-			memcpy(buffer, &c_str()[pos], len);
-			buffer[sz - 1] = '\0';
-
-			return {buffer};
+			return BasicString(c_str() + pos, std::min(len, length() - pos), m_alloc);
 		}
 
 		// Assigns a new value to the string, replacing its current contents.
-		String& operator=(const String& other)
+		constexpr BasicString& operator=(const BasicString& other)
 		{
 			if (this == &other)
 				return *this;
 
-			if (capacity() < other.length())
+			if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
 			{
-				*this = String(other.c_str());
-				return *this;
+				if (m_alloc != other.m_alloc && is_heap())
+				{
+					deallocate(m_data.heap.buf, m_data.heap.capacity + 1);
+					m_data = {};
+				}
+				m_alloc = other.m_alloc;
 			}
 
-			memset(m_data.buf, '\0', length());
-			strcpy_s(m_data.buf, capacity(), other.c_str());
-			m_data.size = other.size();
-
-			return *this;
+			stats::on_copy<BasicString>(other.size(), other.size());
+			return assign(other.c_str(), other.size());
 		}
 
 		// Assigns a new value to the string, replacing its current contents.
-		String& operator=(const char* str)
+		constexpr BasicString& operator=(const char* str)
 		{
-			if (m_data.buf == str)
+			if (data() == str)
 				return *this;
 
-			auto len = strlen(str);
-
-			if (capacity() < len + 1)
-			{
-				*this = String(str);
-				return *this;
-			}
-
-			memset(m_data.buf, '\0', length());
-			strcpy_s(m_data.buf, capacity(), str);
-			m_data.size = len + 1;
-
-			return *this;
+			return assign(str, Traits::length(str));
 		}
 
 		// Assigns a new value to the string, replacing its current contents.
-		constexpr String& operator=(String&& other) noexcept
+		constexpr BasicString& operator=(BasicString&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
 		{
 			if (this == &other)
 				return *this;
 
-			this->m_data = other.m_data;
+			if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value)
+			{
+				// The buffer of other can only be adopted if our allocator is able to free it.
+				if (m_alloc != other.m_alloc)
+					return assign(other.c_str(), other.size());
+			}
+
+			if (is_heap())
+				deallocate(m_data.heap.buf, m_data.heap.capacity + 1);
+
+			if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+				m_alloc = std::move(other.m_alloc);
+
+			m_data = std::exchange(other.m_data, {});
 			return *this;
 		}
 
 		// Returns a reference to the character at position `index` in the string.
-		char& operator[](const size_t index) const
+		constexpr const char& operator[](const size_t index) const
 		{
-			return m_data.buf[index];
+			return data()[index];
 		}
 
 		// Returns a reference to the character at position `index` in the string.
-		char& operator[](const size_t index)
+		constexpr char& operator[](const size_t index)
+		{
+			return data()[index];
+		}
+
+		// This function performs a binary comparison of the characters inside the strings.
+		constexpr bool operator==(const BasicString& rhs) const
 		{
-			return m_data.buf[index];
+			return size() == rhs.size() && Traits::compare(c_str(), rhs.c_str(), size()) == 0;
 		}
 
 		// This function performs a binary comparison of the characters inside the strings.
-		bool operator==(const String& rhs) const
+		constexpr bool operator==(const char* rhs) const
 		{
-			return !strcmp(c_str(), rhs.c_str());
+			return view() == StringView(rhs);
 		}
 
-		// 		// This function performs a binary comparison of the characters inside the strings.
-		bool operator==(const char* rhs) const
+		// This function performs a binary comparison of the characters of the string and of the view.
+		constexpr bool operator==(const StringView rhs) const
 		{
-			return !strcmp(c_str(), rhs);
+			return view() == rhs;
 		}
 
 		// Returns a newly constructed string object with its value being the concatenation
 		// of the characters in lhs followed by those of rhs.
-		String operator+(const String& rhs) const
+		constexpr BasicString operator+(const BasicString& rhs) const
 		{
-			auto capacity = this->length() + rhs.length() + 1;
-			auto buffer = new char[capacity];
-
-			strcpy_s(buffer, capacity, c_str());
-			strcat_s(buffer, capacity, rhs.c_str());
-
-			return {buffer};
+			return concat(rhs.c_str(), rhs.length());
 		}
 
 		// Returns a newly constructed string object with its value being the concatenation
 		// of the characters in lhs followed by those of rhs.
-		String operator+(const char* rhs) const
+		constexpr BasicString operator+(const char* rhs) const
 		{
-			auto capacity = this->length() + strlen(rhs) + 1;
-			auto buffer = new char[capacity];
-
-			strcpy_s(buffer, capacity, c_str());
-			strcat_s(buffer, capacity, rhs);
+			return concat(rhs, Traits::length(rhs));
+		}
 
-			return {buffer};
+		// Returns a newly constructed string object with its value being the concatenation
+		// of the characters in lhs followed by those of rhs.
+		constexpr BasicString operator+(const StringView rhs) const
+		{
+			return concat(rhs.data(), rhs.size());
 		}
 
 		// Inserts the sequence of characters that conforms value of String into os.
 		std::ostream& operator<<(std::ostream& os) const
 		{
-			return os << m_data.buf;
+			return os << c_str();
 		}
 
-		using It = Iterator<String, const char>;
+		using It = Iterator<BasicString, char>;
 		constexpr It begin()
 		{
-			return It::begin(*this);
+			return It(data());
 		}
 
 		constexpr It end()
 		{
-			return It::end(*this);
+			return It(data() + size());
 		}
 
-		using ConstIt = Iterator<const String, const char>;
+		using ConstIt = Iterator<BasicString, const char>;
 		[[nodiscard]] constexpr ConstIt begin() const
 		{
-			return ConstIt::begin(*this);
+			return ConstIt(data());
 		}
 
 		[[nodiscard]] constexpr ConstIt end() const
 		{
-			return ConstIt::end(*this);
+			return ConstIt(data() + size());
 		}
 
 	private:
-		struct StringData {
-			char* buf;
-			size_t size, capacity;
+		constexpr char* allocate(const size_t n)
+		{
+			stats::on_allocate<BasicString>(n);
+			return AllocTraits::allocate(m_alloc, n);
+		}
 
-			void drop() const
-			{
-				delete[] buf;
-			}
+		// Returns a heap buffer for at least capacity characters and the terminator, and sets capacity to the
+		// number of characters that fit, which the size class growth policy raises to what the allocator handed out.
+		constexpr char* allocate_buffer(size_t& capacity)
+		{
+			auto buffer = allocate(capacity + 1);
+
+			if constexpr (GrowthPolicy::round_to_size_class)
+				capacity = m_alloc.usable_size(buffer, capacity + 1) - 1;
+
+			return buffer;
+		}
+
+		constexpr void deallocate(char* buffer, const size_t n)
+		{
+			if (buffer == nullptr)
+				return;
+
+			stats::on_deallocate<BasicString>(n);
+			AllocTraits::deallocate(m_alloc, buffer, n);
+		}
+
+		// Switches to the heap buffer, which has room for capacity characters and the terminator.
+		// The length is kept; the caller copies the characters and any previous buffer is not released.
+		constexpr void make_heap(char* buffer, const size_t capacity)
+		{
+			const auto length = size();
+			m_data.heap = {buffer, length, capacity};
+			m_data.control = heap_tag;
+		}
+
+		// Switches to buffer, which has room for capacity characters, and releases the previous heap buffer.
+		// The caller has already copied whatever characters it needs into buffer.
+		constexpr void adopt_buffer(char* buffer, const size_t capacity)
+		{
+			if (is_heap())
+				deallocate(m_data.heap.buf, m_data.heap.capacity + 1);
+
+			make_heap(buffer, capacity);
+		}
+
+		// Moves the characters and the terminator into buffer, which has room for capacity characters,
+		// and releases the previous heap buffer.
+		constexpr void replace_buffer(char* buffer, const size_t capacity)
+		{
+			stats::on_relocate<BasicString>(size(), size());
+			Traits::copy(buffer, data(), size() + 1);
+			adopt_buffer(buffer, capacity);
+		}
+
+		// Returns the capacity to grow to when required characters no longer fit. With a geometric
+		// growth policy, a sequence of appends copies each character O(1) times.
+		[[nodiscard]] constexpr size_t grown_capacity(const size_t required) const
+		{
+			return GrowthPolicy::next_capacity(capacity(), required);
+		}
+
+		// Sets the length to n and writes the terminating null-character.
+		constexpr void set_length(const size_t n)
+		{
+			if (is_heap())
+				m_data.heap.size = n;
+			else
+				m_data.control = static_cast<unsigned char>(n);
+
+			data()[n] = '\0';
+		}
 
-			void move(char* buffer)
+		// Replaces the contents with the n characters at s, reusing the buffer when it is large enough.
+		constexpr BasicString& assign(const char* s, const size_t n)
+		{
+			if (capacity() < n)
 			{
-				drop();
-				buf = buffer;
-			}
+				auto buffer = allocate(n + 1);
+				Traits::copy(buffer, s, n);
 
-			~StringData()
+				adopt_buffer(buffer, n);
+			}
+			else
 			{
-				this->drop();
+				Traits::move(data(), s, n);
 			}
+
+			set_length(n);
+			return *this;
+		}
+
+		// Returns a new string holding this string followed by the n characters at s.
+		constexpr BasicString concat(const char* s, const size_t n) const
+		{
+			BasicString result(m_alloc);
+			result.reserve(length() + n);
+
+			Traits::copy(result.data(), c_str(), length());
+			Traits::copy(result.data() + length(), s, n);
+			result.set_length(length() + n);
+
+			return result;
+		}
+
+		// Marks a string whose characters live in m_data.heap.
+		static constexpr unsigned char heap_tag = 0xFF;
+
+		struct HeapData {
+			char* buf;
+			size_t size, capacity;
 		};
 
+		// The inline characters share their storage with the heap description. The control byte sits
+		// outside of that union so that it can always be read: it is the inline length or heap_tag.
+		struct StringData {
+			union {
+				HeapData heap;
+				char local[sizeof(HeapData)] = {};
+			};
+			unsigned char control = 0;
+		};
+
+		static_assert(sso_capacity + 1 == sizeof(HeapData));
+		static_assert(sso_capacity < heap_tag);
+
+		[[no_unique_address]] Allocator m_alloc{};
 		StringData m_data{};
 	};
+
+	// A string holds no pointer into itself, so its bytes may be moved as long as its allocator's may.
+	template<typename Allocator, typename GrowthPolicy>
+	struct is_trivially_relocatable<BasicString<Allocator, GrowthPolicy>> : is_trivially_relocatable<Allocator> {
+	};
+
+	using String = BasicString<>;
+
+	static_assert(sizeof(String) == 4 * sizeof(void*));
+
+	namespace pmr
+	{
+		// A String whose buffer comes from a std::pmr::memory_resource.
+		using String = BasicString<std::pmr::polymorphic_allocator<char>>;
+	}// namespace pmr
 }// namespace cpp
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "pch.h"
+
+#include "String.h"
+#include <charconv>
+#include <concepts>
+#include <limits>
+
+namespace cpp
+{
+	// Assembles a string from many pieces in a single growing buffer.
+	//
+	// Unlike chaining operator+, which creates a new string for every piece, the builder appends
+	// each piece in place and hands its buffer over to the resulting string without copying it.
+	template<typename Allocator = std::allocator<char>>
+	class BasicStringBuilder
+	{
+	public:
+		using string_type = BasicString<Allocator>;
+
+		// Constructs an empty builder.
+		BasicStringBuilder() = default;
+
+		// Constructs an empty builder that allocates through alloc.
+		explicit BasicStringBuilder(const Allocator& alloc)
+			: m_str(alloc)
+		{
+		}
+
+		// Constructs an empty builder with room for capacity characters.
+		explicit BasicStringBuilder(const size_t capacity, const Allocator& alloc = Allocator())
+			: m_str(alloc)
+		{
+			m_str.reserve(capacity);
+		}
+
+		// Appends the first n characters in the array of characters pointed by s.
+		BasicStringBuilder& append(const char* s, const size_t n)
+		{
+			m_str.append(s, n);
+			return *this;
+		}
+
+		// Appends the null-terminated character sequence (C-string) pointed by s.
+		BasicStringBuilder& append(const char* s)
+		{
+			m_str.append(s);
+			return *this;
+		}
+
+		// Appends a copy of str.
+		BasicStringBuilder& append(const string_type& str)
+		{
+			m_str.append(str);
+			return *this;
+		}
+
+		// Appends the characters of the view sv.
+		BasicStringBuilder& append(const StringView sv)
+		{
+			m_str.append(sv);
+			return *this;
+		}
+
+		// Appends character c.
+		BasicStringBuilder& append(const char c)
+		{
+			m_str.push_back(c);
+			return *this;
+		}
+
+		// Appends n consecutive copies of character c.
+		BasicStringBuilder& append(const size_t n, const char c)
+		{
+			m_str.append(n, c);
+			return *this;
+		}
+
+		// Appends the decimal representation of value, formatted without allocating.
+		template<std::integral T>
+		requires(!std::same_as<T, bool> && !std::same_as<T, char>)
+		BasicStringBuilder& append(const T value)
+		{
+			char digits[std::numeric_limits<T>::digits10 + 2];
+			const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+
+			return append(digits, static_cast<size_t>(result.ptr - digits));
+		}
+
+		// Appends the shortest decimal representation of value that reads back as the same value.
+		template<std::floating_point T>
+		BasicStringBuilder& append(const T value)
+		{
+			// Sign, digits, decimal point and exponent: the shortest form never takes the longer fixed notation.
+			char digits[std::numeric_limits<T>::max_digits10 + 10];
+			const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+
+			return append(digits, static_cast<size_t>(result.ptr - digits));
+		}
+
+		// Appends "true" or "false".
+		BasicStringBuilder& append(const bool value)
+		{
+			return value ? append("true", 4) : append("false", 5);
+		}
+
+		// Appends value, see append(). Only characters, numbers, booleans and strings are accepted, so that no
+		// other type is quietly converted to one of them.
+		template<typename T>
+		requires(std::is_arithmetic_v<T> || std::convertible_to<const T&, StringView>)
+		BasicStringBuilder& operator<<(const T& value)
+		{
+			return append(value);
+		}
+
+		// Requests room for at least n characters in total, so that no further appends reallocate until then.
+		void reserve(const size_t n)
+		{
+			m_str.reserve(n);
+		}
+
+		// Returns the number of characters appended so far.
+		[[nodiscard]] size_t size() const
+		{
+			return m_str.size();
+		}
+
+		// Returns the number of characters the builder can hold without reallocating.
+		[[nodiscard]] size_t capacity() const
+		{
+			return m_str.capacity();
+		}
+
+		// Discards the appended characters but keeps the buffer for reuse.
+		void clear()
+		{
+			m_str.clear();
+		}
+
+		// Returns the characters appended so far as a null-terminated sequence.
+		[[nodiscard]] const char* c_str() const
+		{
+			return m_str.c_str();
+		}
+
+		// Returns the built string, taking over the buffer. The builder is left empty.
+		[[nodiscard]] string_type release()
+		{
+			return std::exchange(m_str, string_type(m_str.get_allocator()));
+		}
+
+	private:
+		string_type m_str;
+	};
+
+	using StringBuilder = BasicStringBuilder<>;
+
+	namespace pmr
+	{
+		// A StringBuilder whose buffer comes from a std::pmr::memory_resource.
+		using StringBuilder = BasicStringBuilder<std::pmr::polymorphic_allocator<char>>;
+	}// namespace pmr
+}// namespace cpp
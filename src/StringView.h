@@ -0,0 +1,271 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Iterator.h"
+#include "Search.h"
+#include <compare>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace cpp
+{
+	// A non-owning view of a sequence of chars: a pointer and a length.
+	//
+	// A view never allocates and never copies the characters it refers to, so slicing a string into
+	// views is free. The characters are not necessarily followed by a null-character, and the view
+	// must not outlive them.
+	class StringView
+	{
+	public:
+		using value_type = char;
+
+		// npos is a static member constant value with the greatest possible value for an element of type size_t.
+		static constexpr size_t npos = -1;
+
+		// Constructs an empty view.
+		constexpr StringView() noexcept = default;
+
+		// Constructs a view of the first n characters in the array of characters pointed by s.
+		constexpr StringView(const char* s, const size_t n) noexcept
+			: m_data(s), m_size(n)
+		{
+		}
+
+		// Constructs a view of the null-terminated character sequence (C-string) pointed by s.
+		constexpr StringView(const char* s) noexcept
+			: StringView(s, std::char_traits<char>::length(s))
+		{
+		}
+
+		// Constructs a view of the characters of a std::string_view.
+		constexpr StringView(const std::string_view sv) noexcept
+			: StringView(sv.data(), sv.size())
+		{
+		}
+
+		// Returns a std::string_view of the same characters.
+		constexpr operator std::string_view() const noexcept
+		{
+			return { m_data, m_size };
+		}
+
+		// Returns a pointer to the first character of the view.
+		[[nodiscard]] constexpr const char* data() const noexcept
+		{
+			return m_data;
+		}
+
+		// Returns the number of characters in the view.
+		[[nodiscard]] constexpr size_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		// Returns the number of characters in the view.
+		[[nodiscard]] constexpr size_t length() const noexcept
+		{
+			return m_size;
+		}
+
+		// Returns whether the view is empty (i.e. whether its length is 0).
+		[[nodiscard]] constexpr bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		// Returns a reference to the character at position index in the view.
+		constexpr const char& operator[](const size_t index) const noexcept
+		{
+			return m_data[index];
+		}
+
+		// Returns a reference to the character at position pos in the view,
+		// throwing an out_of_range exception if pos is not less than the length.
+		[[nodiscard]] constexpr const char& at(const size_t pos) const
+		{
+			if (pos >= m_size)
+				throw std::out_of_range("Position outside of string view");
+
+			return m_data[pos];
+		}
+
+		// Returns a reference to the first character of the view.
+		// This function shall not be called on empty views.
+		[[nodiscard]] constexpr const char& front() const noexcept
+		{
+			return m_data[0];
+		}
+
+		// Returns a reference to the last character of the view.
+		// This function shall not be called on empty views.
+		[[nodiscard]] constexpr const char& back() const noexcept
+		{
+			return m_data[m_size - 1];
+		}
+
+		// Moves the start of the view forward by n characters.
+		constexpr void remove_prefix(const size_t n) noexcept
+		{
+			m_data += n;
+			m_size -= n;
+		}
+
+		// Moves the end of the view back by n characters.
+		constexpr void remove_suffix(const size_t n) noexcept
+		{
+			m_size -= n;
+		}
+
+		// Returns a view of the len characters starting at pos (or until the end of the view, if it is too short).
+		// Like String::substr(), returns an empty view if pos is past the end.
+		[[nodiscard]] constexpr StringView substr(const size_t pos = 0, const size_t len = npos) const noexcept
+		{
+			if (pos > m_size)
+				return {};
+
+			return { m_data + pos, std::min(len, m_size - pos) };
+		}
+
+		// Compares the view with sv: returns a negative value, zero or a positive value if the view sorts
+		// before, equal to or after sv.
+		[[nodiscard]] constexpr int compare(const StringView sv) const noexcept
+		{
+			const auto common = std::char_traits<char>::compare(m_data, sv.m_data, std::min(m_size, sv.m_size));
+			if (common != 0)
+				return common;
+
+			return m_size == sv.m_size ? 0 : (m_size < sv.m_size ? -1 : 1);
+		}
+
+		// Returns whether the view begins with the characters of sv.
+		[[nodiscard]] constexpr bool starts_with(const StringView sv) const noexcept
+		{
+			return m_size >= sv.m_size && substr(0, sv.m_size) == sv;
+		}
+
+		// Returns whether the view ends with the characters of sv.
+		[[nodiscard]] constexpr bool ends_with(const StringView sv) const noexcept
+		{
+			return m_size >= sv.m_size && substr(m_size - sv.m_size) == sv;
+		}
+
+		// Searches the view for the first occurrence of sv that begins at or after pos.
+		[[nodiscard]] size_t find(const StringView sv, const size_t pos = 0) const noexcept
+		{
+			if (pos > m_size)
+				return npos;
+
+			return offset_result(pos, search::find(m_data + pos, m_size - pos, sv.m_data, sv.m_size));
+		}
+
+		// Searches the view for the first occurrence of character c at or after pos.
+		[[nodiscard]] size_t find(const char c, const size_t pos = 0) const noexcept
+		{
+			if (pos >= m_size)
+				return npos;
+
+			return offset_result(pos, search::find_char(m_data + pos, m_size - pos, c));
+		}
+
+		// Searches the view for the last occurrence of sv that begins at or before pos.
+		[[nodiscard]] size_t rfind(const StringView sv, const size_t pos = npos) const noexcept
+		{
+			if (sv.m_size > m_size)
+				return npos;
+
+			return search::rfind(m_data, std::min(pos, m_size - sv.m_size) + sv.m_size, sv.m_data, sv.m_size);
+		}
+
+		// Searches the view for the last occurrence of character c at or before pos.
+		[[nodiscard]] size_t rfind(const char c, const size_t pos = npos) const noexcept
+		{
+			if (empty())
+				return npos;
+
+			return search::rfind_char(m_data, std::min(pos, m_size - 1) + 1, c);
+		}
+
+		// Searches the view for the first character at or after pos that matches any of the characters in sv.
+		[[nodiscard]] size_t find_first_of(const StringView sv, const size_t pos = 0) const noexcept
+		{
+			if (pos >= m_size)
+				return npos;
+
+			return offset_result(pos, search::find_first_of(m_data + pos, m_size - pos, sv.m_data, sv.m_size));
+		}
+
+		// Searches the view for the first occurrence of character c at or after pos.
+		[[nodiscard]] size_t find_first_of(const char c, const size_t pos = 0) const noexcept
+		{
+			return find(c, pos);
+		}
+
+		// Searches the view for the last character at or before pos that matches any of the characters in sv.
+		[[nodiscard]] size_t find_last_of(const StringView sv, const size_t pos = npos) const noexcept
+		{
+			if (empty())
+				return npos;
+
+			return search::find_last_of(m_data, std::min(pos, m_size - 1) + 1, sv.m_data, sv.m_size);
+		}
+
+		// Searches the view for the last occurrence of character c at or before pos.
+		[[nodiscard]] size_t find_last_of(const char c, const size_t pos = npos) const noexcept
+		{
+			return rfind(c, pos);
+		}
+
+		// Returns the number of non-overlapping occurrences of sv in the view. An empty sequence is not counted.
+		[[nodiscard]] size_t count(const StringView sv) const noexcept
+		{
+			return sv.empty() ? 0 : search::count(m_data, m_size, sv.m_data, sv.m_size);
+		}
+
+		// Returns the number of occurrences of character c in the view.
+		[[nodiscard]] size_t count(const char c) const noexcept
+		{
+			return search::count_char(m_data, m_size, c);
+		}
+
+		// This function performs a binary comparison of the characters inside the views.
+		friend constexpr bool operator==(const StringView lhs, const StringView rhs) noexcept
+		{
+			return lhs.m_size == rhs.m_size && std::char_traits<char>::compare(lhs.m_data, rhs.m_data, lhs.m_size) == 0;
+		}
+
+		// Orders the views lexicographically, by the unsigned value of their characters.
+		friend constexpr std::strong_ordering operator<=>(const StringView lhs, const StringView rhs) noexcept
+		{
+			return lhs.compare(rhs) <=> 0;
+		}
+
+		// Inserts the characters of sv into os.
+		friend std::ostream& operator<<(std::ostream& os, const StringView sv)
+		{
+			return os.write(sv.m_data, static_cast<std::streamsize>(sv.m_size));
+		}
+
+		using ConstIt = Iterator<StringView, const char>;
+		[[nodiscard]] constexpr ConstIt begin() const noexcept
+		{
+			return ConstIt(m_data);
+		}
+
+		[[nodiscard]] constexpr ConstIt end() const noexcept
+		{
+			return ConstIt(m_data + m_size);
+		}
+
+	private:
+		// Turns an index found in the part of the view starting at pos into an index into the whole view.
+		static constexpr size_t offset_result(const size_t pos, const size_t index) noexcept
+		{
+			return index == search::npos ? npos : pos + index;
+		}
+
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+	};
+}// namespace cpp
@@ -1,56 +1,115 @@
 #pragma once
 
+#include "AllocationStats.h"
+#include "GrowthPolicy.h"
 #include "Iterator.h"
+#include "Memory.h"
 #include "pch.h"
 
 #include <cstring>
+#include <memory_resource>
+#include <ranges>
 
 namespace cpp
 {
-	template<typename T>
+	// A sequence container that stores its elements contiguously in a block obtained from Allocator.
+	//
+	// When the block is full it is replaced by a larger one whose capacity GrowthPolicy picks
+	// (growth::Doubling by default). With an allocator that can reallocate blocks, such as MallocAllocator,
+	// trivially relocatable elements are grown with realloc, which often extends the block in place.
+	template<typename T, typename Allocator = std::allocator<T>, growth::GrowthPolicy GrowthPolicy = growth::Doubling>
 	class Vector
 	{
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+		static_assert(!GrowthPolicy::round_to_size_class || SizeReportingAllocator<Allocator, T>,
+					  "growth::SizeClass needs an allocator that reports usable sizes, such as MallocAllocator");
+
+		// Whether the block is grown with the allocator's reallocate(), which moves the bytes of the elements.
+		static constexpr bool grows_in_place = is_trivially_relocatable_v<T> && ReallocatingAllocator<Allocator, T>;
+
 	public:
+		using value_type = T;
+		using allocator_type = Allocator;
+		using ConstIterator = Iterator<Vector, T const>;
+		using It = Iterator<Vector, T>;
+
 		// Constructs an empty container, with no elements.
 		constexpr Vector() = default;
 
+		// Constructs an empty container, with no elements, that allocates through alloc.
+		constexpr explicit Vector(const Allocator& alloc)
+			: _alloc(alloc)
+		{
+		}
+
 		// Constructs an empty container, with no elements and required cap.
-		constexpr explicit Vector(const size_t capacity)
-			: _data({new T[capacity], 0, capacity})
+		constexpr explicit Vector(const size_t capacity, const Allocator& alloc = Allocator())
+			: _alloc(alloc)
 		{
+			_data = {allocate(capacity), 0, capacity};
 		}
 
 		// Constructs a container with a copy of each of the elements in x, in the same order.
 		constexpr Vector(const Vector& other)
+			: Vector(other, AllocTraits::select_on_container_copy_construction(other._alloc))
 		{
-			this->reserve(other.capacity());
+		}
+
+		// Constructs a container with a copy of each of the elements in x, in the same order, using alloc.
+		constexpr Vector(const Vector& other, const Allocator& alloc)
+			: _alloc(alloc)
+		{
+			stats::on_copy<Vector>(other.size(), other.size() * sizeof(T));
+			reserve(other.capacity());
 
-			for (auto const& e : other)
-				this->push_back(e);
+			construct_copies(_data.p, other._data.p, other.size());
+			_data.sz = other.size();
 		}
 
 		// Constructs a container that acquires the elements of x.
 		constexpr Vector(Vector&& other) noexcept
-			: _data(std::move(other._data))
+			: _alloc(std::move(other._alloc)), _data(std::exchange(other._data, {}))
 		{
 		}
 
-		// Constructs a container with a copy of each of the elements in il, in the same order.
-		constexpr Vector(const std::initializer_list<T>& list)
+		// Constructs a container that acquires the elements of x if alloc can free its storage,
+		// otherwise moves each element into storage obtained from alloc.
+		constexpr Vector(Vector&& other, const Allocator& alloc)
+			: _alloc(alloc)
 		{
-			auto const& list_data = std::data(list);
-			const auto list_size = list.size();
+			if (_alloc == other._alloc)
+			{
+				_data = std::exchange(other._data, {});
+				return;
+			}
 
-			_data = {new T[list_size], list_size, list_size};
+			reserve(other.size());
+			for (; _data.sz < other.size(); ++_data.sz)
+				construct(_data.p + _data.sz, std::move(other[_data.sz]));
+		}
+
+		// Constructs a container with a copy of each of the elements in il, in the same order.
+		constexpr Vector(const std::initializer_list<T>& list, const Allocator& alloc = Allocator())
+			: _alloc(alloc)
+		{
+			_data = {allocate(list.size()), 0, list.size()};
 
-			for (size_t i = 0; i < list_size; ++i)
-				_data.p[i] = list_data[i];
+			construct_copies(_data.p, list.begin(), list.size());
+			_data.sz = list.size();
 		}
 
 		// Destroys the container object.
-		~Vector()
+		constexpr ~Vector()
+		{
+			clear();
+			deallocate(_data.p, _data.cap);
+		}
+
+		// Returns a copy of the allocator object associated with the vector.
+		constexpr allocator_type get_allocator() const noexcept
 		{
-			delete[] _data.p;
+			return _alloc;
 		}
 
 		// Returns a reference to the element at position n in the vector.
@@ -138,16 +197,10 @@ namespace cpp
 		// Requests that the vector cap be at least enough to contain n elements.
 		constexpr void reserve(const size_t new_capacity)
 		{
-			if (_data.cap > new_capacity)
+			if (_data.cap >= new_capacity)
 				return;
 
-			auto block = new T[new_capacity];
-
-			for (size_t i = 0; i < _data.sz; ++i)
-				block[i] = std::move(_data.p[i]);
-
-			delete[] _data.p;
-			_data = {block, _data.sz, new_capacity};
+			reallocate(new_capacity);
 		}
 
 		// Returns the size of the storage space currently allocated for the vector, expressed in terms of elements.
@@ -159,42 +212,29 @@ namespace cpp
 		// Requests the container to reduce its cap to fit its size.
 		constexpr void shrink_to_fit()
 		{
-			if (_data.cap < _data.sz)
+			if (_data.cap == _data.sz)
 				return;
 
-			auto block = new T[_data.sz];
-			for (size_t i = 0; i < _data.sz; ++i)
-				block[i] = std::move(_data.p[i]);
-
-			delete[] _data.p;
-			_data = {block, _data.sz, _data.sz};
+			reallocate(_data.sz);
 		}
 
 		// Removes all elements from the vector (which are destroyed), leaving the container with a size of 0.
 		constexpr void clear() noexcept
 		{
-			std::for_each(begin(), end(), [&](T& t) {
-				t.~T();
-			});
+			destroy(_data.p, _data.p + _data.sz);
 			_data.sz = 0;
 		}
 
 		// Adds a new element at the end of the vector, after its current last element. The content of val is copied to the new element.
 		constexpr void push_back(const T& value)
 		{
-			if (_data.cap == _data.sz)
-				reserve(1 + _data.sz * 2);
-
-			_data.p[_data.sz++] = value;
+			emplace_back(value);
 		}
 
 		// Adds a new element at the end of the vector, after its current last element. The content of val is moved to the new element.
 		constexpr void push_back(T&& value)
 		{
-			if (_data.cap == _data.sz)
-				reserve(1 + _data.sz * 2);
-
-			_data.p[_data.sz++] = std::move(value);
+			emplace_back(std::move(value));
 		}
 
 		// Inserts a new element at the end of the vector, right after its current last element.
@@ -203,16 +243,126 @@ namespace cpp
 		constexpr T& emplace_back(Args&&... args)
 		{
 			if (_data.cap == _data.sz)
-				reserve(1 + _data.sz * 2);
+				return grow_emplace_back(std::forward<Args>(args)...);
 
-			_data.p[_data.sz] = T(std::forward<Args>(args)...);
+			construct(_data.p + _data.sz, std::forward<Args>(args)...);
 			return _data.p[_data.sz++];
 		}
 
+		// Appends copies of the elements of range, which must not be part of this vector, after the last element.
+		// The block grows at most once, and trivially copyable elements in contiguous memory are copied with memcpy.
+		template<std::ranges::input_range R>
+		constexpr void append_range(R&& range)
+		{
+			insert_range(end(), std::forward<R>(range));
+		}
+
 		// Removes the last element in the vector, effectively reducing the container size by one.
 		constexpr void pop_back()
 		{
-			_data.p[_data.sz--].~T();
+			--_data.sz;
+			AllocTraits::destroy(_alloc, _data.p + _data.sz);
+		}
+
+		// Inserts a copy of value before pos and returns an iterator to it.
+		constexpr It insert(const ConstIterator pos, const T& value)
+		{
+			return emplace(pos, value);
+		}
+
+		// Inserts value, moved, before pos and returns an iterator to it.
+		constexpr It insert(const ConstIterator pos, T&& value)
+		{
+			return emplace(pos, std::move(value));
+		}
+
+		// Inserts count copies of value before pos and returns an iterator to the first of them.
+		constexpr It insert(const ConstIterator pos, const size_t count, const T& value)
+		{
+			// value may be one of the elements the gap moves.
+			T copy(value);
+
+			return insert_gap(index_of(pos), count, [&](T* gap) { construct_fill(gap, count, copy); });
+		}
+
+		// Inserts copies of the elements in [first, last), which must not be part of this vector, before pos,
+		// and returns an iterator to the first of them.
+		template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+		constexpr It insert(const ConstIterator pos, InputIt first, Sentinel last)
+		{
+			return insert_range(pos, std::ranges::subrange(std::move(first), std::move(last)));
+		}
+
+		// Inserts copies of the elements in list before pos and returns an iterator to the first of them.
+		constexpr It insert(const ConstIterator pos, const std::initializer_list<T> list)
+		{
+			return insert_range(pos, list);
+		}
+
+		// Inserts the elements of range, which must not be part of this vector, before pos, and returns an
+		// iterator to the first of them. When the size of range is known up front, the elements after pos are
+		// shifted once (with memmove when they are trivially relocatable) and the block grows at most once.
+		template<std::ranges::input_range R>
+		constexpr It insert_range(const ConstIterator pos, R&& range)
+		{
+			const auto index = index_of(pos);
+
+			if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>)
+			{
+				const auto count = static_cast<size_t>(std::ranges::distance(range));
+				return insert_gap(index, count, [&](T* gap) { construct_copies(gap, std::ranges::begin(range), count); });
+			}
+			else
+			{
+				// The count is only known once the range is consumed: append, then rotate into place.
+				const auto old_size = _data.sz;
+				for (auto&& e : range)
+					emplace_back(std::forward<decltype(e)>(e));
+
+				std::rotate(_data.p + index, _data.p + old_size, _data.p + _data.sz);
+				return It(_data.p + index);
+			}
+		}
+
+		// Inserts an element constructed from args before pos and returns an iterator to it.
+		template<typename... Args>
+		constexpr It emplace(const ConstIterator pos, Args&&... args)
+		{
+			const auto index = index_of(pos);
+
+			if (index == _data.sz)
+			{
+				emplace_back(std::forward<Args>(args)...);
+				return It(_data.p + index);
+			}
+
+			// args may refer to one of the elements the gap moves, so the element is built first.
+			T value(std::forward<Args>(args)...);
+
+			return insert_gap(index, 1, [&](T* gap) { construct(gap, std::move(value)); });
+		}
+
+		// Removes the element at pos and returns an iterator to the element that followed it.
+		constexpr It erase(const ConstIterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		// Removes the elements in [first, last) and returns an iterator to the element that followed them.
+		// The elements after last are shifted down once, with memmove when they are trivially relocatable.
+		constexpr It erase(const ConstIterator first, const ConstIterator last)
+		{
+			const auto index = index_of(first);
+			const auto count = static_cast<size_t>(last - first);
+
+			if (count != 0)
+			{
+				destroy(_data.p + index, _data.p + index + count);
+				shift(_data.p + index + count, _data.sz - index - count, _data.p + index, index);
+				_data.sz -= count;
+			}
+
+			return It(_data.p + index);
 		}
 
 		// Resizes the container so that it contains n elements.
@@ -222,42 +372,69 @@ namespace cpp
 			if (count == _data.sz)
 				return;
 
-			auto buffer = new T[count];
-
-			if (count > _data.sz)
+			if (count < _data.sz)
 			{
-				for (size_t i = 0; i < _data.sz; ++i)
-					buffer[i] = std::move(_data.p[i]);
-
-				for (size_t i = _data.sz; i < count; ++i)
-					buffer[i] = value;
+				destroy(_data.p + count, _data.p + _data.sz);
+				_data.sz = count;
+				reallocate(count);
+				return;
 			}
-			else
+
+			if (_data.cap < count)
 			{
-				for (size_t i = 0; i < count; ++i)
-					buffer[i] = std::move(_data.p[i]);
+				// value may be an element of this vector, which reallocating frees, so it is copied first.
+				const T copy(value);
+				reallocate(count);
+				resize(count, copy);
+				return;
 			}
 
-			delete[] _data.p;
-
-			_data = {buffer, count, count};
+			for (; _data.sz < count; ++_data.sz)
+				construct(_data.p + _data.sz, value);
 		}
 
 		// Exchanges the content of the container by the content of x, which is another vector object of the same type. Sizes may differ.
+		// The allocators are exchanged only if the allocator type propagates on swap.
 		constexpr void swap(Vector& other) noexcept
 		{
+			if constexpr (AllocTraits::propagate_on_container_swap::value)
+			{
+				using std::swap;
+				swap(_alloc, other._alloc);
+			}
+
 			std::swap(this->_data, other._data);
 		}
 
 		// Assigns new contents to the container, replacing its current contents, and modifying its size accordingly.
-		constexpr Vector& operator=(Vector&& other) noexcept
+		constexpr Vector& operator=(Vector&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
 		{
 			if (this == &other)
 				return *this;
 
-			delete[] _data.p;
+			if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value)
+			{
+				// The block of other can only be adopted if our allocator is able to free it.
+				if (_alloc != other._alloc)
+				{
+					clear();
+					reserve(other.size());
+
+					for (; _data.sz < other.size(); ++_data.sz)
+						construct(_data.p + _data.sz, std::move(other[_data.sz]));
+
+					other.clear();
+					return *this;
+				}
+			}
+
+			clear();
+			deallocate(_data.p, _data.cap);
 
-			_data = std::move(other._data);
+			if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+				_alloc = std::move(other._alloc);
+
+			_data = std::exchange(other._data, {});
 			return *this;
 		}
 
@@ -267,44 +444,442 @@ namespace cpp
 			if (this == &other)
 				return *this;
 
-			reserve(other.m_capacity);
-			_data.sz = other.m_size;
-			_data.cap = other.m_capacity;
+			clear();
+
+			if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+			{
+				if (_alloc != other._alloc)
+				{
+					deallocate(_data.p, _data.cap);
+					_data = {};
+				}
+				_alloc = other._alloc;
+			}
+
+			stats::on_copy<Vector>(other.size(), other.size() * sizeof(T));
+			reserve_cleared(other.size());
 
-			std::copy(other.begin(), other.end(), _data.p);
+			construct_copies(_data.p, other._data.p, other.size());
+			_data.sz = other.size();
 
 			return *this;
 		}
 
-		using ConstIterator = Iterator<Vector const, T const>;
-		using It = Iterator<Vector, T>;
+		// Replaces the contents with count copies of value.
+		constexpr void assign(const size_t count, const T& value)
+		{
+			// value may be one of the elements about to be destroyed.
+			T copy(value);
+
+			clear();
+			reserve_cleared(count);
+
+			construct_fill(_data.p, count, copy);
+			_data.sz = count;
+		}
 
-		ConstIterator begin() const
+		// Replaces the contents with copies of the elements in [first, last), which must not be part of this vector.
+		template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+		constexpr void assign(InputIt first, Sentinel last)
 		{
-			return ConstIterator::begin(*this);
+			assign_range(std::ranges::subrange(std::move(first), std::move(last)));
 		}
 
-		It begin()
+		// Replaces the contents with copies of the elements in list.
+		constexpr void assign(const std::initializer_list<T> list)
 		{
-			return It::begin(*this);
+			assign_range(list);
 		}
 
-		ConstIterator end() const
+		// Replaces the contents with the elements of range, which must not be part of this vector.
+		// A range whose size is known up front is copied into a block allocated once; a range of trivially
+		// copyable elements in contiguous memory is copied with a single memcpy.
+		template<std::ranges::input_range R>
+		constexpr void assign_range(R&& range)
 		{
-			return ConstIterator::end(*this);
+			clear();
+
+			if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>)
+			{
+				const auto count = static_cast<size_t>(std::ranges::distance(range));
+				reserve_cleared(count);
+
+				construct_copies(_data.p, std::ranges::begin(range), count);
+				_data.sz = count;
+			}
+			else
+			{
+				for (auto&& e : range)
+					emplace_back(std::forward<decltype(e)>(e));
+			}
 		}
 
-		It end()
+		constexpr ConstIterator begin() const noexcept
 		{
-			return It::end(*this);
+			return ConstIterator(_data.p);
+		}
+
+		constexpr It begin() noexcept
+		{
+			return It(_data.p);
+		}
+
+		constexpr ConstIterator end() const noexcept
+		{
+			return ConstIterator(_data.p + _data.sz);
+		}
+
+		constexpr It end() noexcept
+		{
+			return It(_data.p + _data.sz);
 		}
 
 	private:
+		// Returns uninitialized storage for n elements; no constructors are run.
+		constexpr T* allocate(const size_t n)
+		{
+			if (n == 0)
+				return nullptr;
+
+			stats::on_allocate<Vector>(n * sizeof(T));
+			return AllocTraits::allocate(_alloc, n);
+		}
+
+		// Releases storage obtained from allocate(). The elements must already be destroyed.
+		constexpr void deallocate(T* p, const size_t n)
+		{
+			if (p == nullptr)
+				return;
+
+			stats::on_deallocate<Vector>(n * sizeof(T));
+			AllocTraits::deallocate(_alloc, p, n);
+		}
+
+		// Constructs an element at p through the allocator, which lets scoped allocators
+		// such as std::pmr::polymorphic_allocator pass themselves on to the element.
+		template<typename... Args>
+		constexpr void construct(T* p, Args&&... args)
+		{
+			AllocTraits::construct(_alloc, p, std::forward<Args>(args)...);
+		}
+
+		// Copies count elements starting at first into the uninitialized storage at dst. Trivially copyable
+		// elements read from contiguous memory are copied with a single memcpy. If a copy throws, the
+		// elements already copied are destroyed.
+		template<typename InputIt>
+		constexpr void construct_copies(T* dst, InputIt first, const size_t count)
+		{
+			if constexpr (std::is_trivially_copyable_v<T> && std::contiguous_iterator<InputIt> && std::is_same_v<std::iter_value_t<InputIt>, T>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					if (count != 0)
+						std::memcpy(static_cast<void*>(dst), static_cast<const void*>(std::to_address(first)), count * sizeof(T));
+					return;
+				}
+			}
+
+			size_t i = 0;
+			try
+			{
+				for (; i < count; ++i, ++first)
+					construct(dst + i, *first);
+			}
+			catch (...)
+			{
+				destroy(dst, dst + i);
+				throw;
+			}
+		}
+
+		// Constructs count copies of value in the uninitialized storage at dst. If a copy throws, the
+		// elements already copied are destroyed.
+		constexpr void construct_fill(T* dst, const size_t count, const T& value)
+		{
+			size_t i = 0;
+			try
+			{
+				for (; i < count; ++i)
+					construct(dst + i, value);
+			}
+			catch (...)
+			{
+				destroy(dst, dst + i);
+				throw;
+			}
+		}
+
+		// Returns the position of pos in the block.
+		constexpr size_t index_of(const ConstIterator pos) const noexcept
+		{
+			return static_cast<size_t>(pos - begin());
+		}
+
+		// Makes an empty vector able to hold count elements. Unlike reserve(), an outgrown block is
+		// freed before the new one is allocated, since there is nothing to move.
+		constexpr void reserve_cleared(size_t count)
+		{
+			if (count <= _data.cap)
+				return;
+
+			deallocate(_data.p, _data.cap);
+			_data = {};
+
+			_data.p = allocate_at_least(count);
+			_data.cap = count;
+		}
+
+		// Opens a gap of count uninitialized slots at index by shifting the elements after it, growing the block
+		// once if needed, and returns the first slot. The size is left unchanged until the gap is filled.
+		constexpr T* open_gap(const size_t index, const size_t count)
+		{
+			const auto tail = _data.sz - index;
+
+			if (_data.sz + count > _data.cap)
+			{
+				auto new_capacity = GrowthPolicy::next_capacity(_data.cap, _data.sz + count);
+				stats::on_grow<Vector>((_data.sz + count) * sizeof(T), new_capacity * sizeof(T));
+
+				if constexpr (grows_in_place)
+				{
+					if (!std::is_constant_evaluated() && _data.p != nullptr)
+					{
+						_data.p = reallocate_block(new_capacity);
+						_data.cap = new_capacity;
+
+						relocate_overlapping(_data.p + index, tail, _data.p + index + count);
+						return _data.p + index;
+					}
+				}
+
+				auto block = allocate_at_least(new_capacity);
+				stats::on_relocate<Vector>(_data.sz, _data.sz * sizeof(T));
+
+				try
+				{
+					if constexpr (std::is_nothrow_move_constructible_v<T>)
+					{
+						relocate(_data.p, index, block);
+						relocate(_data.p + index, tail, block + index + count);
+					}
+					else
+					{
+						// Both halves are copied before any element is destroyed, so a throwing copy leaves them in place.
+						uninitialized_move_if_noexcept(_data.p, index, block);
+						try
+						{
+							uninitialized_move_if_noexcept(_data.p + index, tail, block + index + count);
+						}
+						catch (...)
+						{
+							destroy(block, block + index);
+							throw;
+						}
+
+						destroy(_data.p, _data.p + _data.sz);
+					}
+				}
+				catch (...)
+				{
+					deallocate(block, new_capacity);
+					throw;
+				}
+
+				deallocate(_data.p, _data.cap);
+
+				_data.p = block;
+				_data.cap = new_capacity;
+				return block + index;
+			}
+
+			shift(_data.p + index, tail, _data.p + index + count, index);
+			return _data.p + index;
+		}
+
+		// Opens a gap of count slots at index and lets fill construct the elements in it. If fill throws, it
+		// must leave the gap empty, and the gap is closed again.
+		template<typename Fill>
+		constexpr It insert_gap(const size_t index, const size_t count, Fill&& fill)
+		{
+			if (count == 0)
+				return It(_data.p + index);
+
+			auto gap = open_gap(index, count);
+
+			try
+			{
+				fill(gap);
+			}
+			catch (...)
+			{
+				shift(gap + count, _data.sz - index, gap, index);
+				throw;
+			}
+
+			_data.sz += count;
+			return It(gap);
+		}
+
+		// Returns uninitialized storage for at least n elements and sets n to the number that fit,
+		// which the size class growth policy raises to what the allocator really handed out.
+		constexpr T* allocate_at_least(size_t& n)
+		{
+			auto block = allocate(n);
+
+			if constexpr (GrowthPolicy::round_to_size_class)
+			{
+				if (!std::is_constant_evaluated() && block != nullptr)
+					n = _alloc.usable_size(block, n);
+			}
+
+			return block;
+		}
+
+		// Resizes the block of the vector, which must exist, to at least new_capacity elements with the allocator's
+		// reallocate(), and sets new_capacity to the number that fit. Only for trivially relocatable elements.
+		T* reallocate_block(size_t& new_capacity)
+		{
+			auto block = _alloc.reallocate(_data.p, _data.cap, new_capacity);
+
+			if constexpr (GrowthPolicy::round_to_size_class)
+				new_capacity = _alloc.usable_size(block, new_capacity);
+
+			stats::on_allocate<Vector>(new_capacity * sizeof(T));
+			stats::on_deallocate<Vector>(_data.cap * sizeof(T));
+			if (block != _data.p)
+				stats::on_relocate<Vector>(_data.sz, _data.sz * sizeof(T));
+
+			return block;
+		}
+
+		// Shifts n elements within the block with relocate_overlapping(). If a move throws, the elements
+		// in both ranges have been destroyed, so the vector is cut back to its first keep elements.
+		constexpr void shift(T* src, const size_t n, T* dst, const size_t keep)
+		{
+			try
+			{
+				relocate_overlapping(src, n, dst);
+			}
+			catch (...)
+			{
+				_data.sz = keep;
+				throw;
+			}
+		}
+
+		// Destroys the elements in [first, last) through the allocator.
+		constexpr void destroy(T* first, T* last)
+		{
+			for (; first != last; ++first)
+				AllocTraits::destroy(_alloc, first);
+		}
+
+		// Moves the live elements into a block of new_capacity elements (or as many as fit in the block
+		// the allocator hands out) and releases the old one.
+		constexpr void reallocate(size_t new_capacity)
+		{
+			if constexpr (grows_in_place)
+			{
+				if (!std::is_constant_evaluated() && _data.p != nullptr && new_capacity != 0)
+				{
+					_data.p = reallocate_block(new_capacity);
+					_data.cap = new_capacity;
+					return;
+				}
+			}
+
+			auto block = allocate_at_least(new_capacity);
+			stats::on_relocate<Vector>(_data.sz, _data.sz * sizeof(T));
+
+			try
+			{
+				relocate(_data.p, _data.sz, block);
+			}
+			catch (...)
+			{
+				deallocate(block, new_capacity);
+				throw;
+			}
+
+			deallocate(_data.p, _data.cap);
+
+			_data.p = block;
+			_data.cap = new_capacity;
+		}
+
+		// Slow path of emplace_back(): the new element is constructed in the grown block before the old
+		// elements are relocated, so args may safely refer to an element of this vector.
+		template<typename... Args>
+		constexpr T& grow_emplace_back(Args&&... args)
+		{
+			auto new_capacity = GrowthPolicy::next_capacity(_data.cap, _data.sz + 1);
+
+			if constexpr (grows_in_place)
+			{
+				if (!std::is_constant_evaluated() && _data.p != nullptr)
+				{
+					// The block may move, so the new element is built first in case args refer to an old one.
+					T value(std::forward<Args>(args)...);
+
+					stats::on_grow<Vector>((_data.sz + 1) * sizeof(T), new_capacity * sizeof(T));
+					_data.p = reallocate_block(new_capacity);
+					_data.cap = new_capacity;
+
+					construct(_data.p + _data.sz, std::move(value));
+					return _data.p[_data.sz++];
+				}
+			}
+
+			auto block = allocate_at_least(new_capacity);
+
+			try
+			{
+				construct(block + _data.sz, std::forward<Args>(args)...);
+				try
+				{
+					relocate(_data.p, _data.sz, block);
+				}
+				catch (...)
+				{
+					destroy(block + _data.sz, block + _data.sz + 1);
+					throw;
+				}
+			}
+			catch (...)
+			{
+				deallocate(block, new_capacity);
+				throw;
+			}
+
+			stats::on_grow<Vector>((_data.sz + 1) * sizeof(T), new_capacity * sizeof(T));
+			stats::on_relocate<Vector>(_data.sz, _data.sz * sizeof(T));
+			deallocate(_data.p, _data.cap);
+
+			_data.p = block;
+			_data.cap = new_capacity;
+			return _data.p[_data.sz++];
+		}
+
 		struct VectorData {
 			T* p = nullptr;
 			size_t sz = 0;
 			size_t cap = 0;
 		};
+		[[no_unique_address]] Allocator _alloc{};
 		VectorData _data{};
 	};
+
+	// A vector only owns a pointer to its block, so moving its bytes elsewhere is a valid move
+	// as long as the same holds for its allocator.
+	template<typename T, typename Allocator, typename GrowthPolicy>
+	struct is_trivially_relocatable<Vector<T, Allocator, GrowthPolicy>> : is_trivially_relocatable<Allocator> {
+	};
+
+	namespace pmr
+	{
+		// A Vector whose storage comes from a std::pmr::memory_resource, e.g. a per-request
+		// std::pmr::monotonic_buffer_resource that releases every container at once.
+		template<typename T>
+		using Vector = cpp::Vector<T, std::pmr::polymorphic_allocator<T>>;
+	}// namespace pmr
 }// namespace cpp
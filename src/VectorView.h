@@ -0,0 +1,110 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Iterator.h"
+#include <ranges>
+
+namespace cpp
+{
+	// A non-owning, read-only view of a contiguous sequence of elements: a pointer and a length.
+	//
+	// The StringView of arbitrary element types. A view never allocates and never copies the elements
+	// it refers to, and must not outlive them.
+	template<typename T>
+	class VectorView
+	{
+	public:
+		using value_type = T;
+
+		// Constructs an empty view.
+		constexpr VectorView() noexcept = default;
+
+		// Constructs a view of the n elements starting at p.
+		constexpr VectorView(const T* p, const size_t n) noexcept
+			: m_data(p), m_size(n)
+		{
+		}
+
+		// Constructs a view of the elements of a contiguous container, such as a Vector or an Array.
+		template<std::ranges::contiguous_range Range>
+		requires(!std::is_same_v<std::remove_cvref_t<Range>, VectorView> && std::is_same_v<std::ranges::range_value_t<Range>, T>)
+		constexpr VectorView(Range&& range) noexcept
+			: VectorView(std::ranges::data(range), std::ranges::size(range))
+		{
+		}
+
+		// Returns a pointer to the first element of the view.
+		[[nodiscard]] constexpr const T* data() const noexcept
+		{
+			return m_data;
+		}
+
+		// Returns the number of elements in the view.
+		[[nodiscard]] constexpr size_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		// Returns whether the view is empty (i.e. whether its size is 0).
+		[[nodiscard]] constexpr bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		// Returns a reference to the element at position index in the view.
+		constexpr const T& operator[](const size_t index) const noexcept
+		{
+			return m_data[index];
+		}
+
+		// Returns a reference to the element at position pos in the view,
+		// throwing an out_of_range exception if pos is not less than the size.
+		[[nodiscard]] constexpr const T& at(const size_t pos) const
+		{
+			if (pos >= m_size)
+				throw std::out_of_range("Position outside of vector view");
+
+			return m_data[pos];
+		}
+
+		// Returns a reference to the first element of the view.
+		// This function shall not be called on empty views.
+		[[nodiscard]] constexpr const T& front() const noexcept
+		{
+			return m_data[0];
+		}
+
+		// Returns a reference to the last element of the view.
+		// This function shall not be called on empty views.
+		[[nodiscard]] constexpr const T& back() const noexcept
+		{
+			return m_data[m_size - 1];
+		}
+
+		// Returns a view of the count elements starting at pos (or until the end of the view, if it is too short).
+		// Returns an empty view if pos is past the end.
+		[[nodiscard]] constexpr VectorView subview(const size_t pos, const size_t count = -1) const noexcept
+		{
+			if (pos > m_size)
+				return {};
+
+			return { m_data + pos, std::min(count, m_size - pos) };
+		}
+
+		using ConstIt = Iterator<VectorView, const T>;
+		[[nodiscard]] constexpr ConstIt begin() const noexcept
+		{
+			return ConstIt(m_data);
+		}
+
+		[[nodiscard]] constexpr ConstIt end() const noexcept
+		{
+			return ConstIt(m_data + m_size);
+		}
+
+	private:
+		const T* m_data = nullptr;
+		size_t m_size = 0;
+	};
+}// namespace cpp
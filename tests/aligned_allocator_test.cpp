@@ -0,0 +1,93 @@
+#include "../src/AlignedAllocator.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+
+namespace AlignedAllocatorTests
+{
+	using namespace cpp;
+
+	bool is_aligned(const void* p, const size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+	}
+
+	TEST(aligned_allocator_test, blocks_are_aligned_and_padded)
+	{
+		AlignedAllocator<float> alloc;
+
+		for (const size_t n : { 1, 3, 16, 17, 1000 })
+		{
+			auto p = alloc.allocate(n);
+			EXPECT_TRUE(is_aligned(p, 64));
+
+			// Whole 64-byte chunks, i.e. whole AVX-512 vectors of 16 floats.
+			const auto usable = alloc.usable_size(p, n);
+			EXPECT_GE(usable, n);
+			EXPECT_EQ(usable % 16, 0);
+			EXPECT_LT(usable - n, 16);
+
+			alloc.deallocate(p, usable);
+		}
+	}
+
+	TEST(aligned_allocator_test, aligned_vector)
+	{
+		AlignedVector<double> vec;
+		for (int i = 0; i < 1000; ++i)
+		{
+			vec.push_back(i);
+			ASSERT_TRUE(is_aligned(vec.data(), 64));
+			ASSERT_EQ(vec.capacity() % 8, 0);
+		}
+
+		EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0.0), 999.0 * 1000 / 2);
+
+		vec.shrink_to_fit();
+		EXPECT_EQ(vec.capacity(), 1000);
+		EXPECT_TRUE(is_aligned(vec.data(), 64));
+
+		AlignedVector<float, 32> avx;
+		avx.push_back(1.0f);
+		EXPECT_TRUE(is_aligned(avx.data(), 32));
+		EXPECT_EQ(avx.capacity(), 8);
+	}
+
+	TEST(aligned_allocator_test, huge_pages_for_large_blocks)
+	{
+		AlignedAllocator<char, 64, true> alloc;
+
+		auto small = alloc.allocate(1000);
+		EXPECT_EQ(alloc.usable_size(small, 1000), 1024);
+		alloc.deallocate(small, 1000);
+
+		// Large blocks span whole huge pages and start on a huge page boundary.
+		const auto n = huge_page_size + 1;
+		auto large = alloc.allocate(n);
+		EXPECT_TRUE(is_aligned(large, huge_page_size));
+		EXPECT_EQ(alloc.usable_size(large, n), 2 * huge_page_size);
+
+		large[0] = 1;
+		large[2 * huge_page_size - 1] = 2;
+		alloc.deallocate(large, alloc.usable_size(large, n));
+
+		// Just below the threshold, padding must not switch the block to huge pages between
+		// allocation and deallocation.
+		auto edge = alloc.allocate(huge_page_size - 10);
+		EXPECT_EQ(alloc.usable_size(edge, huge_page_size - 10), huge_page_size);
+		alloc.deallocate(edge, huge_page_size);
+
+		HugePageVector<double> vec;
+		vec.resize(1 << 20, 1.0);
+		EXPECT_TRUE(is_aligned(vec.data(), huge_page_size));
+		EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0.0), 1 << 20);
+	}
+
+	TEST(aligned_allocator_test, rebind)
+	{
+		using Rebound = std::allocator_traits<AlignedAllocator<char, 16>>::rebind_alloc<long double>;
+		static_assert(Rebound::alignment >= alignof(long double));
+
+		EXPECT_EQ(AlignedAllocator<int>(), AlignedAllocator<double>());
+	}
+}// namespace AlignedAllocatorTests
@@ -0,0 +1,133 @@
+#define CPP_ALLOCATION_STATS 1
+
+#include "../src/AllocationStats.h"
+#include "../src/String.h"
+#include "../src/Vector.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <thread>
+
+namespace AllocationStatsTests
+{
+	using namespace cpp;
+
+	static_assert(stats::enabled);
+
+	TEST(allocation_stats_test, vector_growth)
+	{
+		stats::reset();
+		{
+			Vector<int> vec;
+			for (int i = 0; i < 100; ++i)
+				vec.push_back(i);
+		}
+
+		// The capacity grows through 1, 3, 7, ..., 127; every growth but the first moves the elements.
+		const auto counters = stats::snapshot_of<Vector<int>>();
+		EXPECT_EQ(counters.allocations, 7);
+		EXPECT_EQ(counters.deallocations, 7);
+		EXPECT_EQ(counters.bytes_allocated, (1 + 3 + 7 + 15 + 31 + 63 + 127) * sizeof(int));
+		EXPECT_EQ(counters.peak_capacity_bytes, 127 * sizeof(int));
+		EXPECT_EQ(counters.reallocations, 6);
+		EXPECT_EQ(counters.elements_moved, 1 + 3 + 7 + 15 + 31 + 63);
+		EXPECT_EQ(counters.bytes_moved, counters.elements_moved * sizeof(int));
+		EXPECT_EQ(counters.slack_bytes, (1 + 3 + 7 + 15 + 31 + 63) * sizeof(int));
+		EXPECT_EQ(counters.elements_copied, 0);
+	}
+
+	TEST(allocation_stats_test, reserve_avoids_reallocations)
+	{
+		stats::reset();
+
+		Vector<int> vec;
+		vec.reserve(100);
+		for (int i = 0; i < 100; ++i)
+			vec.push_back(i);
+
+		const auto counters = stats::snapshot_of<Vector<int>>();
+		EXPECT_EQ(counters.allocations, 1);
+		EXPECT_EQ(counters.reallocations, 0);
+		EXPECT_EQ(counters.slack_bytes, 0);
+	}
+
+	TEST(allocation_stats_test, copies_and_types_are_counted_apart)
+	{
+		stats::reset();
+
+		const Vector<double> doubles{ 1.0, 2.0, 3.0 };
+		auto copy = doubles;
+		copy = doubles;
+
+		const String text = "a string long enough to live on the heap";
+		const auto text_copy = text;
+
+		const auto double_counters = stats::snapshot_of<Vector<double>>();
+		EXPECT_EQ(double_counters.elements_copied, 6);
+		EXPECT_EQ(double_counters.bytes_copied, 6 * sizeof(double));
+
+		const auto string_counters = stats::snapshot_of<String>();
+		EXPECT_EQ(string_counters.allocations, 2);
+		EXPECT_EQ(string_counters.elements_copied, text.size());
+
+		EXPECT_EQ(stats::snapshot_of<Vector<int>>(), stats::Counters());
+	}
+
+	TEST(allocation_stats_test, string_growth)
+	{
+		stats::reset();
+		{
+			String s;
+			for (int i = 0; i < 100; ++i)
+				s.push_back('x');
+		}
+
+		const auto counters = stats::snapshot_of<String>();
+		EXPECT_GT(counters.allocations, 0);
+		EXPECT_EQ(counters.allocations, counters.deallocations);
+		EXPECT_EQ(counters.reallocations, counters.allocations);
+		EXPECT_GT(counters.elements_moved, 0);
+		EXPECT_GE(counters.peak_capacity_bytes, 101);
+	}
+
+	TEST(allocation_stats_test, threads_are_aggregated)
+	{
+		stats::reset();
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([] {
+				for (int i = 0; i < 10; ++i)
+				{
+					Vector<int64_t> vec;
+					vec.reserve(8);
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		Vector<int64_t> vec;
+		vec.reserve(8);
+
+		const auto counters = stats::snapshot_of<Vector<int64_t>>();
+		EXPECT_EQ(counters.allocations, 41);
+		EXPECT_EQ(counters.deallocations, 40);
+		EXPECT_EQ(counters.peak_capacity_bytes, 64);
+	}
+
+	TEST(allocation_stats_test, dump)
+	{
+		stats::reset();
+		Vector<int> vec;
+		vec.push_back(1);
+
+		std::ostringstream os;
+		stats::dump(os);
+
+		EXPECT_NE(os.str().find("cpp::Vector<int"), std::string::npos);
+		EXPECT_NE(os.str().find("allocations 1,"), std::string::npos);
+	}
+}// namespace AllocationStatsTests
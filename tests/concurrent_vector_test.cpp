@@ -0,0 +1,175 @@
+#include "../src/ConcurrentVector.h"
+#include "../src/String.h"
+#include "../src/Vector.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+
+namespace ConcurrentVectorTests
+{
+	using namespace cpp;
+
+	// Throws from its copy constructor when asked to, to leave an appended index unconstructed.
+	struct ThrowingCopy {
+		static inline int live = 0;
+
+		explicit ThrowingCopy(bool throws)
+			: throws(throws)
+		{
+			++live;
+		}
+
+		ThrowingCopy(const ThrowingCopy& other)
+			: throws(other.throws)
+		{
+			if (throws)
+				throw std::runtime_error("copy failed");
+			++live;
+		}
+
+		~ThrowingCopy()
+		{
+			--live;
+		}
+
+		bool throws;
+	};
+
+	TEST(concurrent_vector_test, push_back)
+	{
+		ConcurrentVector<int> vec;
+
+		EXPECT_TRUE(vec.empty());
+		EXPECT_EQ(vec.push_back(7), 0);
+		EXPECT_EQ(vec.emplace_back(8), 1);
+		EXPECT_EQ(vec.size(), 2);
+		EXPECT_EQ(vec[0], 7);
+		EXPECT_EQ(vec.at(1), 8);
+		EXPECT_FALSE(vec.ready(2));
+		EXPECT_THROW(vec.at(2), std::out_of_range);
+	}
+
+	TEST(concurrent_vector_test, grow_by)
+	{
+		ConcurrentVector<String> vec;
+		vec.push_back("first");
+
+		EXPECT_EQ(vec.grow_by(100, "a string long enough to live on the heap"), 1);
+		EXPECT_EQ(vec.grow_by(3), 101);
+
+		EXPECT_EQ(vec.size(), 104);
+		EXPECT_EQ(vec[100], "a string long enough to live on the heap");
+		EXPECT_TRUE(vec[103].empty());
+	}
+
+	TEST(concurrent_vector_test, addresses_are_stable)
+	{
+		ConcurrentVector<size_t> vec;
+		vec.push_back(0);
+		const auto first = &vec[0];
+
+		for (size_t i = 1; i < 100000; ++i)
+			vec.push_back(i);
+
+		EXPECT_EQ(&vec[0], first);
+		for (size_t i = 0; i < 100000; ++i)
+			ASSERT_EQ(vec[i], i);
+	}
+
+	TEST(concurrent_vector_test, reserve)
+	{
+		ConcurrentVector<int> vec;
+		vec.reserve(1000);
+
+		for (int i = 0; i < 1000; ++i)
+			vec.push_back(i);
+
+		EXPECT_EQ(vec[999], 999);
+	}
+
+	TEST(concurrent_vector_test, throwing_constructor_leaves_index_unready)
+	{
+		{
+			ConcurrentVector<ThrowingCopy> vec;
+			vec.emplace_back(false);
+
+			const ThrowingCopy bad(true);
+			EXPECT_THROW(vec.push_back(bad), std::runtime_error);
+			vec.emplace_back(false);
+
+			EXPECT_EQ(vec.size(), 3);
+			EXPECT_TRUE(vec.ready(0));
+			EXPECT_FALSE(vec.ready(1));
+			EXPECT_TRUE(vec.ready(2));
+		}
+
+		EXPECT_EQ(ThrowingCopy::live, 0);
+	}
+
+	TEST(concurrent_vector_test, clear)
+	{
+		ConcurrentVector<String> vec;
+		vec.grow_by(50, "a string long enough to live on the heap");
+		vec.clear();
+
+		EXPECT_TRUE(vec.empty());
+		EXPECT_FALSE(vec.ready(0));
+
+		vec.push_back("again");
+		EXPECT_EQ(vec.at(0), "again");
+	}
+
+	TEST(concurrent_vector_test, concurrent_appends_and_reads)
+	{
+		constexpr size_t threads = 4;
+		constexpr size_t per_thread = 50000;
+		ConcurrentVector<size_t> vec;
+
+		std::atomic<bool> done = false;
+		std::thread reader([&] {
+			// Reads every element that reports ready while the writers are still appending.
+			while (!done.load())
+			{
+				const auto sz = vec.size();
+				for (size_t i = sz > 64 ? sz - 64 : 0; i < sz; ++i)
+				{
+					if (vec.ready(i))
+					{
+						EXPECT_LT(vec[i], threads * per_thread);
+					}
+				}
+			}
+		});
+
+		Vector<std::thread> writers;
+		for (size_t t = 0; t < threads; ++t)
+		{
+			writers.emplace_back([&vec, t] {
+				for (size_t i = 0; i < per_thread; ++i)
+				{
+					if (i % 100 == 0)
+						vec.grow_by(1, t * per_thread + i);
+					else
+						vec.push_back(t * per_thread + i);
+				}
+			});
+		}
+
+		for (auto& writer : writers)
+			writer.join();
+
+		done = true;
+		reader.join();
+
+		ASSERT_EQ(vec.size(), threads * per_thread);
+
+		Vector<bool> seen;
+		seen.resize(threads * per_thread, false);
+		for (size_t i = 0; i < vec.size(); ++i)
+		{
+			ASSERT_TRUE(vec.ready(i));
+			ASSERT_FALSE(seen[vec[i]]);
+			seen[vec[i]] = true;
+		}
+	}
+}// namespace ConcurrentVectorTests
@@ -0,0 +1,58 @@
+#include "../src/FixedString.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+
+namespace FixedStringTests
+{
+	using namespace cpp;
+
+	// A type named by a string at compile time, as a reflection-free field descriptor would be.
+	template<FixedString Name>
+	struct Field {
+		static constexpr StringView name = Name;
+	};
+
+	// A sorted keyword table built during compilation, searched with a binary search at run time.
+	constexpr auto keywords = [] {
+		std::array<StringView, 6> table{ "while", "if", "return", "else", "for", "do" };
+		std::ranges::sort(table);
+		return table;
+	}();
+
+	constexpr bool is_keyword(const StringView word)
+	{
+		return std::ranges::binary_search(keywords, word);
+	}
+
+	static_assert(FixedString("abc").size() == 3);
+	static_assert(std::is_same_v<decltype(FixedString("abc")), FixedString<3>>);
+	static_assert(FixedString("abc") == StringView("abc"));
+	static_assert(FixedString("abc") != FixedString("abd"));
+	static_assert(FixedString("abc") != FixedString("ab"));
+	static_assert(FixedString("abc") < StringView("abd"));
+	static_assert(FixedString("foo") + FixedString("bar") == FixedString("foobar"));
+	static_assert(FixedString<2>(StringView("xyz").substr(1)) == StringView("yz"));
+	static_assert(FixedString("").empty());
+
+	static_assert(Field<"id">::name == "id");
+	static_assert(std::is_same_v<Field<"id">, Field<FixedString("id")>>);
+	static_assert(!std::is_same_v<Field<"id">, Field<"ids">>);
+
+	static_assert(keywords.front() == "do");
+	static_assert(is_keyword("return") && !is_keyword("goto"));
+
+	TEST(fixed_string_test, runtime_use)
+	{
+		FixedString name("hello");
+		name[0] = 'j';
+
+		EXPECT_STREQ(name.c_str(), "jello");
+		EXPECT_EQ(std::count(name.begin(), name.end(), 'l'), 2);
+		EXPECT_THROW(FixedString<3>(StringView("four")), std::length_error);
+
+		EXPECT_TRUE(is_keyword(StringView("while")));
+		EXPECT_EQ(Field<"name">::name, "name");
+	}
+}// namespace FixedStringTests
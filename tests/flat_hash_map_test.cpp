@@ -0,0 +1,328 @@
+#include "../src/FlatHashMap.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace FlatHashMapTests
+{
+	using namespace cpp;
+
+	// Counts live instances, to check that every entry is destroyed exactly once.
+	// Throws on copy once copies_left reaches zero.
+	struct Tracked {
+		static inline int live = 0;
+		static inline int copies_left = -1;
+
+		Tracked(int v = 0)
+			: value(v)
+		{
+			++live;
+		}
+
+		Tracked(const Tracked& other)
+			: value(other.value)
+		{
+			if (copies_left == 0)
+				throw std::runtime_error("copy failed");
+			--copies_left;
+			++live;
+		}
+
+		~Tracked()
+		{
+			--live;
+		}
+
+		Tracked& operator=(const Tracked&) = default;
+
+		int value;
+	};
+
+	// A hash that sends every key to the same group, so that lookups have to probe past full groups.
+	struct CollidingHash {
+		size_t operator()(const int) const noexcept
+		{
+			return 0;
+		}
+	};
+
+	TEST(FlatHashMapTest, InsertAndFind)
+	{
+		FlatHashMap<int, int> map;
+		EXPECT_TRUE(map.empty());
+		EXPECT_EQ(map.capacity(), 0);
+		EXPECT_EQ(map.find(1), map.end());
+
+		for (int i = 0; i < 1000; ++i)
+			EXPECT_TRUE(map.insert({ i, i * i }).second);
+
+		EXPECT_EQ(map.size(), 1000);
+		EXPECT_FALSE(map.insert({ 7, 0 }).second);
+		EXPECT_EQ(map.at(7), 49);
+		EXPECT_LE(map.load_factor(), (FlatHashMap<int, int>::max_load_factor));
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			const auto it = map.find(i);
+			ASSERT_NE(it, map.end());
+			EXPECT_EQ(it->first, i);
+			EXPECT_EQ(it->second, i * i);
+		}
+
+		EXPECT_FALSE(map.contains(1000));
+		EXPECT_EQ(map.count(-1), 0);
+		EXPECT_THROW((void) map.at(1000), std::out_of_range);
+	}
+
+	TEST(FlatHashMapTest, StringKeysAreFoundWithoutBuildingAString)
+	{
+		FlatHashMap<String, int> map{ { "apple", 1 }, { "banana", 2 }, { String("a fairly long key that is stored on the heap"), 3 } };
+
+		EXPECT_EQ(map.at("apple"), 1);
+		EXPECT_EQ(map.find(StringView("banana"))->second, 2);
+		EXPECT_TRUE(map.contains("a fairly long key that is stored on the heap"));
+		EXPECT_FALSE(map.contains(StringView("apple pie").substr(0, 6)));
+		EXPECT_TRUE(map.contains(StringView("apple pie").substr(0, 5)));
+
+		map["cherry"] += 4;
+		map[StringView("cherry")] += 1;
+		EXPECT_EQ(map.at(String("cherry")), 5);
+
+		EXPECT_EQ(map.erase("banana"), 1);
+		EXPECT_EQ(map.erase(StringView("banana")), 0);
+		EXPECT_EQ(map.size(), 3);
+	}
+
+	TEST(FlatHashMapTest, TryEmplaceAndInsertOrAssign)
+	{
+		FlatHashMap<String, String> map;
+
+		auto [it, inserted] = map.try_emplace("key", "first");
+		EXPECT_TRUE(inserted);
+		EXPECT_EQ(it->second, "first");
+
+		std::tie(it, inserted) = map.try_emplace("key", "second");
+		EXPECT_FALSE(inserted);
+		EXPECT_EQ(it->second, "first");
+
+		std::tie(it, inserted) = map.insert_or_assign("key", String("third"));
+		EXPECT_FALSE(inserted);
+		EXPECT_EQ(map.at("key"), "third");
+
+		std::tie(it, inserted) = map.emplace("other", "value");
+		EXPECT_TRUE(inserted);
+		EXPECT_EQ(map.size(), 2);
+	}
+
+	TEST(FlatHashMapTest, EraseKeepsOtherEntriesReachable)
+	{
+		// All keys collide, so most of them sit past full groups and erasing leaves deleted slots on their way.
+		FlatHashMap<int, int, CollidingHash> map;
+		for (int i = 0; i < 200; ++i)
+			map[i] = i;
+
+		for (int i = 0; i < 200; i += 2)
+			EXPECT_EQ(map.erase(i), 1);
+
+		EXPECT_EQ(map.size(), 100);
+		for (int i = 0; i < 200; ++i)
+			EXPECT_EQ(map.contains(i), i % 2 == 1) << i;
+
+		// Deleted slots are reused.
+		const auto capacity = map.capacity();
+		for (int i = 0; i < 200; i += 2)
+			map[i] = i;
+
+		EXPECT_EQ(map.capacity(), capacity);
+		EXPECT_EQ(map.size(), 200);
+	}
+
+	TEST(FlatHashMapTest, InsertEraseChurnDoesNotGrow)
+	{
+		// Deleted slots used up by churn are taken back by rebuilding the table in place, not by doubling it.
+		FlatHashMap<int, int> map;
+		map.reserve(100);
+		const auto capacity = map.capacity();
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			map[i] = i;
+			if (i >= 50)
+			{
+				EXPECT_EQ(map.erase(i - 50), 1);
+			}
+		}
+
+		EXPECT_EQ(map.size(), 50);
+		EXPECT_EQ(map.capacity(), capacity);
+		for (int i = 100000 - 50; i < 100000; ++i)
+			EXPECT_EQ(map.at(i), i);
+	}
+
+	TEST(FlatHashMapTest, EraseWhileIterating)
+	{
+		FlatHashMap<int, int> map;
+		for (int i = 0; i < 100; ++i)
+			map[i] = i;
+
+		for (auto it = map.begin(); it != map.end();)
+		{
+			if (it->first % 3 == 0)
+				it = map.erase(it);
+			else
+				++it;
+		}
+
+		EXPECT_EQ(map.size(), 66);
+
+		int visited = 0;
+		for (const auto& [key, value] : map)
+		{
+			EXPECT_NE(key % 3, 0);
+			EXPECT_EQ(key, value);
+			++visited;
+		}
+		EXPECT_EQ(visited, 66);
+	}
+
+	TEST(FlatHashMapTest, ReserveAndRehash)
+	{
+		FlatHashMap<int, int> map;
+		map.reserve(1000);
+		const auto capacity = map.capacity();
+		EXPECT_GE(capacity * 7 / 8, 1000);
+
+		// Entries do not move while the reserved room lasts.
+		map[0] = 0;
+		const auto* first = &map.at(0);
+		for (int i = 1; i < 1000; ++i)
+			map[i] = i;
+
+		EXPECT_EQ(map.capacity(), capacity);
+		EXPECT_EQ(&map.at(0), first);
+
+		for (int i = 10; i < 1000; ++i)
+			map.erase(i);
+
+		map.rehash(0);
+		EXPECT_EQ(map.capacity(), 16);
+		for (int i = 0; i < 10; ++i)
+			EXPECT_EQ(map.at(i), i);
+
+		map.rehash(4096);
+		EXPECT_EQ(map.capacity(), 4096);
+		EXPECT_EQ(map.size(), 10);
+
+		map.clear();
+		EXPECT_TRUE(map.empty());
+		EXPECT_EQ(map.capacity(), 4096);
+		EXPECT_FALSE(map.contains(0));
+
+		map.rehash(0);
+		EXPECT_EQ(map.capacity(), 0);
+	}
+
+	TEST(FlatHashMapTest, CopyAndMove)
+	{
+		FlatHashMap<String, int> map;
+		for (int i = 0; i < 100; ++i)
+			map[String(std::to_string(i).c_str())] = i;
+
+		auto copy = map;
+		EXPECT_EQ(copy.size(), 100);
+		EXPECT_EQ(copy.at("42"), 42);
+
+		copy["42"] = 0;
+		EXPECT_EQ(map.at("42"), 42);
+
+		auto moved = std::move(map);
+		EXPECT_EQ(moved.size(), 100);
+		EXPECT_TRUE(map.empty());
+		EXPECT_FALSE(map.contains("42"));
+
+		map = moved;
+		EXPECT_EQ(map.at("99"), 99);
+	}
+
+	TEST(FlatHashMapTest, EntriesAreDestroyedOnce)
+	{
+		{
+			FlatHashMap<int, Tracked> map;
+			for (int i = 0; i < 1000; ++i)
+				map.try_emplace(i, i);
+
+			for (int i = 0; i < 1000; i += 3)
+				map.erase(i);
+
+			auto copy = map;
+			copy.clear();
+			copy[1] = Tracked(1);
+
+			// The value refers to an entry of the map itself, while the insertion grows the table.
+			FlatHashMap<int, Tracked> small{ { 0, Tracked(7) } };
+			for (int i = 1; i < 100; ++i)
+				small.try_emplace(i, small.at(0));
+
+			EXPECT_EQ(small.at(99).value, 7);
+		}
+
+		EXPECT_EQ(Tracked::live, 0);
+	}
+
+	TEST(FlatHashMapTest, FailedCopyLeavesMapUnchanged)
+	{
+		using Map = FlatHashMap<int, Tracked>;
+
+		{
+			Map map;
+			for (int i = 0; i < 100; ++i)
+				map.try_emplace(i, i);
+
+			const auto capacity = map.capacity();
+
+			// Tracked cannot be moved, so both copying the map and rebuilding its table copy the entries.
+			Tracked::copies_left = 50;
+			EXPECT_THROW(Map{ map }, std::runtime_error);
+			Tracked::copies_left = 50;
+			EXPECT_THROW(map.rehash(4 * capacity), std::runtime_error);
+			Tracked::copies_left = -1;
+
+			EXPECT_EQ(Tracked::live, 100);
+			EXPECT_EQ(map.capacity(), capacity);
+			ASSERT_EQ(map.size(), 100);
+			for (int i = 0; i < 100; ++i)
+				EXPECT_EQ(map.at(i).value, i);
+		}
+
+		EXPECT_EQ(Tracked::live, 0);
+	}
+
+	TEST(FlatHashMapTest, MatchesUnorderedMap)
+	{
+		FlatHashMap<int, int> map;
+		std::unordered_map<int, int> expected;
+
+		uint32_t state = 12345;
+		for (int i = 0; i < 100000; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			const auto key = static_cast<int>(state >> 20);
+
+			if ((state >> 12) & 1)
+			{
+				map[key] = i;
+				expected[key] = i;
+			}
+			else
+			{
+				EXPECT_EQ(map.erase(key), expected.erase(key));
+			}
+		}
+
+		EXPECT_EQ(map.size(), expected.size());
+		for (const auto& [key, value] : expected)
+			EXPECT_EQ(map.at(key), value);
+	}
+}// namespace FlatHashMapTests
@@ -0,0 +1,98 @@
+#include "../src/GrowthPolicy.h"
+#include "../src/MallocAllocator.h"
+#include "../src/String.h"
+#include "../src/Vector.h"
+#include "gtest/gtest.h"
+
+namespace GrowthPolicyTests
+{
+	using namespace cpp;
+
+	// Returns the capacities a vector goes through while n elements are appended one by one.
+	template<typename Vec>
+	std::vector<size_t> capacities(const size_t n)
+	{
+		Vec vec;
+		std::vector<size_t> result;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			vec.push_back(static_cast<typename Vec::value_type>(i));
+			if (result.empty() || result.back() != vec.capacity())
+				result.push_back(vec.capacity());
+		}
+
+		return result;
+	}
+
+	static_assert(growth::GrowthPolicy<growth::Doubling>);
+	static_assert(growth::GrowthPolicy<growth::OneAndHalf>);
+	static_assert(growth::GrowthPolicy<growth::SizeClass<growth::OneAndHalf>>);
+
+	TEST(growth_policy_test, next_capacity)
+	{
+		EXPECT_EQ(growth::Doubling::next_capacity(0, 1), 1);
+		EXPECT_EQ(growth::Doubling::next_capacity(7, 8), 15);
+		EXPECT_EQ(growth::Doubling::next_capacity(7, 100), 100);
+
+		EXPECT_EQ(growth::OneAndHalf::next_capacity(0, 1), 1);
+		EXPECT_EQ(growth::OneAndHalf::next_capacity(10, 11), 16);
+		EXPECT_EQ(growth::OneAndHalf::next_capacity(10, 100), 100);
+
+		EXPECT_EQ(growth::SizeClass<growth::OneAndHalf>::next_capacity(10, 11), 16);
+	}
+
+	TEST(growth_policy_test, vector_default_doubles)
+	{
+		const std::vector<size_t> expected{ 1, 3, 7, 15, 31, 63 };
+		EXPECT_EQ(capacities<Vector<int>>(40), expected);
+	}
+
+	TEST(growth_policy_test, vector_one_and_half)
+	{
+		const std::vector<size_t> expected{ 1, 2, 4, 7, 11, 17, 26, 40 };
+		EXPECT_EQ((capacities<Vector<int, std::allocator<int>, growth::OneAndHalf>>(40)), expected);
+	}
+
+	TEST(growth_policy_test, vector_size_class_uses_the_whole_block)
+	{
+		using SizeClassVector = Vector<char, MallocAllocator<char>, growth::SizeClass<>>;
+
+		// glibc malloc never hands out fewer than a few words, so there the first growth already gets room for
+		// several chars; allocators without size classes hand out exactly what was asked for.
+		SizeClassVector vec;
+		vec.push_back('a');
+		EXPECT_GE(vec.capacity(), 1);
+		EXPECT_EQ(vec.capacity(), MallocAllocator<char>().usable_size(vec.data(), 1));
+
+		for (char c = 'b'; c <= 'z'; ++c)
+			vec.push_back(c);
+
+		EXPECT_EQ(vec.size(), 26);
+		EXPECT_EQ(vec[25], 'z');
+		EXPECT_EQ(vec.capacity(), MallocAllocator<char>().usable_size(vec.data(), vec.capacity()));
+	}
+
+	TEST(growth_policy_test, string_policies)
+	{
+		BasicString<std::allocator<char>, growth::OneAndHalf> tight;
+		BasicString<> doubling;
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			tight.push_back('x');
+			doubling.push_back('x');
+		}
+
+		EXPECT_EQ(tight, doubling.c_str());
+		EXPECT_LE(tight.capacity(), doubling.capacity());
+		EXPECT_LT(tight.capacity() - tight.size(), tight.size() / 2 + 1);
+
+		BasicString<MallocAllocator<char>, growth::SizeClass<>> rounded;
+		for (int i = 0; i < 100; ++i)
+			rounded.push_back('y');
+
+		EXPECT_EQ(rounded.size(), 100);
+		EXPECT_EQ(rounded.capacity() + 1, MallocAllocator<char>().usable_size(rounded.data(), rounded.capacity() + 1));
+	}
+}// namespace GrowthPolicyTests
@@ -0,0 +1,110 @@
+#include "../src/Hash.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+namespace HashTests
+{
+	using namespace cpp;
+
+	// length pseudo-random bytes.
+	std::vector<unsigned char> make_bytes(const size_t length, uint32_t state = 12345)
+	{
+		std::vector<unsigned char> bytes(length);
+		for (auto& byte : bytes)
+		{
+			state = state * 1103515245 + 12345;
+			byte = static_cast<unsigned char>(state >> 16);
+		}
+
+		return bytes;
+	}
+
+	TEST(HashTest, KernelsAgree)
+	{
+		const auto bytes = make_bytes(64 * 40);
+
+		for (const size_t stripes : { 1, 15, 16, 17, 33, 40 })
+		{
+			uint64_t expected[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+			hashing::scalar::accumulate(expected, bytes.data(), stripes);
+
+			uint64_t acc[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+			hashing::sse2::accumulate(acc, bytes.data(), stripes);
+			EXPECT_TRUE(std::equal(acc, acc + 8, expected)) << stripes;
+
+			if (search::detail::cpu_features().avx2)
+			{
+				uint64_t acc2[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+				hashing::avx2::accumulate(acc2, bytes.data(), stripes);
+				EXPECT_TRUE(std::equal(acc2, acc2 + 8, expected)) << stripes;
+			}
+		}
+	}
+
+	TEST(HashTest, EveryLengthAndPrefixHashesDifferently)
+	{
+		// Every prefix of the same bytes, so that all the length classes and their boundaries are covered.
+		const auto bytes = make_bytes(2000);
+		std::unordered_set<uint64_t> seen;
+
+		for (size_t length = 0; length <= bytes.size(); ++length)
+			EXPECT_TRUE(seen.insert(hashing::hash_bytes(bytes.data(), length)).second) << length;
+
+		// Zero bytes of different lengths differ as well, from each other and from the prefixes.
+		const std::vector<unsigned char> zeros(600);
+		for (size_t length = 1; length <= zeros.size(); ++length)
+			EXPECT_TRUE(seen.insert(hashing::hash_bytes(zeros.data(), length)).second) << length;
+	}
+
+	TEST(HashTest, EveryBitMatters)
+	{
+		for (const size_t length : { 1, 3, 4, 8, 16, 17, 48, 49, 100, 256, 257, 1000, 1025, 4096 })
+		{
+			auto bytes = make_bytes(length, static_cast<uint32_t>(length));
+			const auto original = hashing::hash_bytes(bytes.data(), length);
+
+			for (size_t i = 0; i < length; i += 1 + length / 64)
+			{
+				for (int bit = 0; bit < 8; ++bit)
+				{
+					bytes[i] ^= static_cast<unsigned char>(1 << bit);
+					const auto flipped = hashing::hash_bytes(bytes.data(), length);
+					bytes[i] ^= static_cast<unsigned char>(1 << bit);
+
+					EXPECT_NE(flipped, original) << length << " " << i << " " << bit;
+
+					// About half of the output bits change.
+					const auto changed = std::popcount(flipped ^ original);
+					EXPECT_GT(changed, 10) << length << " " << i << " " << bit;
+					EXPECT_LT(changed, 54) << length << " " << i << " " << bit;
+				}
+			}
+		}
+	}
+
+	TEST(HashTest, SeedsGiveDifferentHashes)
+	{
+		const auto bytes = make_bytes(300);
+		for (const size_t length : { 0, 5, 20, 60, 300 })
+			EXPECT_NE(hashing::hash_bytes(bytes.data(), length, 1), hashing::hash_bytes(bytes.data(), length, 2));
+	}
+
+	TEST(HashTest, StringTypesHashAlike)
+	{
+		const hash<String> string_hash;
+		const char* text = "the same characters, long enough to be stored on the heap";
+
+		EXPECT_EQ(string_hash(String(text)), string_hash(text));
+		EXPECT_EQ(string_hash(String(text)), string_hash(StringView(text)));
+		EXPECT_EQ(hash<StringView>()(text), hashing::hash_bytes(text, std::strlen(text)));
+		EXPECT_NE(string_hash("abc"), string_hash("abd"));
+
+		// Other types still use std::hash.
+		EXPECT_EQ(hash<int>()(42), std::hash<int>()(42));
+	}
+}// namespace HashTests
@@ -0,0 +1,90 @@
+#include "../src/FlatHashMap.h"
+#include "../src/HashedString.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace HashedStringTests
+{
+	using namespace cpp;
+
+	TEST(HashedStringTest, HashIsCachedUntilMutation)
+	{
+		HashedString s("telemetry.tag");
+		EXPECT_FALSE(s.is_hashed());
+
+		const auto h = s.hash();
+		EXPECT_TRUE(s.is_hashed());
+		EXPECT_EQ(h, hash<StringView>()("telemetry.tag"));
+		EXPECT_EQ(s.hash(), h);
+
+		s.reserve(100);
+		EXPECT_TRUE(s.is_hashed());
+
+		s.append(".name");
+		EXPECT_FALSE(s.is_hashed());
+		EXPECT_EQ(s.hash(), hash<StringView>()("telemetry.tag.name"));
+
+		s.push_back('!');
+		EXPECT_FALSE(s.is_hashed());
+		(void) s.hash();
+
+		s.replace(0, 9, "metric");
+		EXPECT_FALSE(s.is_hashed());
+		EXPECT_EQ(s, "metric.tag.name!");
+		EXPECT_EQ(s.hash(), hash<StringView>()("metric.tag.name!"));
+
+		s.resize(6);
+		EXPECT_FALSE(s.is_hashed());
+		EXPECT_EQ(s.hash(), hash<StringView>()("metric"));
+
+		s = "other";
+		EXPECT_FALSE(s.is_hashed());
+		EXPECT_EQ(s.hash(), hash<StringView>()("other"));
+
+		s.clear();
+		EXPECT_TRUE(s.empty());
+		EXPECT_EQ(s.hash(), hash<StringView>()(""));
+	}
+
+	TEST(HashedStringTest, Comparisons)
+	{
+		const HashedString a("alpha"), b("beta");
+		EXPECT_EQ(a, HashedString("alpha"));
+		EXPECT_NE(a, b);
+		EXPECT_EQ(a, StringView("alpha"));
+		EXPECT_EQ(a, "alpha");
+		EXPECT_EQ(a, String("alpha"));
+		EXPECT_LT(a, StringView("beta"));
+
+		// Hashed strings with different hashes are told apart by their hashes alone.
+		(void) a.hash();
+		(void) b.hash();
+		EXPECT_NE(a, b);
+		EXPECT_EQ(a, HashedString("alpha"));
+
+		// Copies keep the hash.
+		const auto copy = a;
+		EXPECT_TRUE(copy.is_hashed());
+		EXPECT_EQ(copy.str(), "alpha");
+	}
+
+	TEST(HashedStringTest, FlatHashMapKeys)
+	{
+		FlatHashMap<HashedString, int> map;
+		for (int i = 0; i < 1000; ++i)
+			map[HashedString(String(("tag_" + std::to_string(i)).c_str()))] = i;
+
+		// Keys keep their hashes in the table, so growing it did not hash them again.
+		for (const auto& [key, value] : map)
+			EXPECT_TRUE(key.is_hashed());
+
+		EXPECT_EQ(map.at("tag_7"), 7);
+		EXPECT_EQ(map.at(StringView("tag_42")), 42);
+		EXPECT_FALSE(map.contains("tag_1000"));
+
+		const HashedString probe("tag_999");
+		EXPECT_EQ(map.at(probe), 999);
+		EXPECT_TRUE(probe.is_hashed());
+	}
+}// namespace HashedStringTests
@@ -0,0 +1,160 @@
+#include "../src/InternPool.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace InternPoolTests
+{
+	using namespace cpp;
+
+	static_assert(sizeof(Symbol) == 4);
+
+	// Returns count distinct tag names like "service.7.requests".
+	std::vector<String> make_tags(const size_t count)
+	{
+		std::vector<String> tags;
+		for (size_t i = 0; i < count; ++i)
+			tags.emplace_back(("service." + std::to_string(i) + ".requests").c_str());
+
+		return tags;
+	}
+
+	TEST(InternPoolTest, EqualStringsShareASymbol)
+	{
+		InternPool pool;
+		EXPECT_EQ(pool.size(), 1);
+		EXPECT_EQ(pool.intern(""), Symbol());
+		EXPECT_EQ(pool.view(Symbol()), "");
+
+		const auto a = pool.intern("http.status");
+		const auto b = pool.intern("http.method");
+		EXPECT_NE(a, b);
+		EXPECT_EQ(pool.intern(String("http.status")), a);
+		EXPECT_EQ(pool.intern(StringView("http.status.code").substr(0, 11)), a);
+		EXPECT_EQ(pool.size(), 3);
+
+		EXPECT_EQ(pool.view(a), "http.status");
+		EXPECT_STREQ(pool.c_str(b), "http.method");
+		EXPECT_TRUE(pool.contains(b));
+		EXPECT_FALSE(pool.contains(Symbol(3)));
+
+		EXPECT_EQ(pool.find("http.method"), b);
+		EXPECT_EQ(pool.find("http.path"), std::nullopt);
+		EXPECT_EQ(pool.size(), 3);
+	}
+
+	TEST(InternPoolTest, StringsNeverMove)
+	{
+		InternPool pool;
+		const auto tags = make_tags(100000);
+
+		const auto first = pool.intern(tags[0]);
+		const auto first_view = pool.view(first);
+
+		std::vector<Symbol> symbols;
+		for (const auto& tag : tags)
+			symbols.push_back(pool.intern(tag));
+
+		// A string longer than any block gets a block of its own.
+		String huge;
+		huge.append(3 << 20, 'x');
+		const auto huge_symbol = pool.intern(huge);
+
+		EXPECT_EQ(pool.size(), tags.size() + 2);
+		EXPECT_EQ(pool.view(first).data(), first_view.data());
+		EXPECT_EQ(pool.view(huge_symbol).size(), huge.size());
+
+		for (size_t i = 0; i < tags.size(); ++i)
+		{
+			EXPECT_EQ(symbols[i].id(), i + 1);
+			EXPECT_EQ(pool.view(symbols[i]), tags[i].view());
+		}
+	}
+
+	TEST(InternPoolTest, MemoryUsage)
+	{
+		InternPool pool;
+		const auto tags = make_tags(1000);
+
+		size_t string_bytes = 1;
+		for (int repeat = 0; repeat < 10; ++repeat)
+		{
+			for (const auto& tag : tags)
+				(void) pool.intern(tag);
+		}
+
+		for (const auto& tag : tags)
+			string_bytes += tag.size() + 1;
+
+		const auto memory = pool.memory_usage();
+		EXPECT_EQ(memory.symbols, 1001);
+		EXPECT_EQ(memory.string_bytes, string_bytes);
+		EXPECT_GE(memory.arena_bytes, memory.string_bytes);
+		EXPECT_LT(memory.arena_bytes, 2 * memory.string_bytes + detail::StringArena::first_block_size);
+		EXPECT_GE(memory.table_bytes, 1001 * sizeof(StringView));
+		EXPECT_EQ(memory.total_bytes(), memory.arena_bytes + memory.table_bytes);
+	}
+
+	TEST(InternPoolTest, SymbolsAsKeys)
+	{
+		InternPool pool;
+		FlatHashMap<Symbol, int> counts;
+
+		for (int i = 0; i < 1000; ++i)
+			++counts[pool.intern(i % 3 == 0 ? "fizz" : "other")];
+
+		EXPECT_EQ(counts.size(), 2);
+		EXPECT_EQ(counts.at(pool.intern("fizz")), 334);
+	}
+
+	TEST(ConcurrentInternPoolTest, ThreadsAgreeOnSymbols)
+	{
+		ConcurrentInternPool pool;
+		const auto tags = make_tags(20000);
+
+		constexpr size_t threads = 4;
+		std::vector<std::vector<Symbol>> symbols(threads, std::vector<Symbol>(tags.size()));
+		std::vector<std::thread> workers;
+
+		// Every thread interns every tag, each in its own order, so most tags are raced for.
+		for (size_t t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&, t] {
+				for (size_t k = 0; k < tags.size(); ++k)
+				{
+					const auto i = t % 2 == 0 ? k : tags.size() - 1 - k;
+					symbols[t][i] = pool.intern(tags[i].view());
+					EXPECT_EQ(pool.view(symbols[t][i]), tags[i].view());
+				}
+			});
+		}
+
+		for (auto& worker : workers)
+			worker.join();
+
+		EXPECT_EQ(pool.size(), tags.size() + 1);
+
+		std::vector<uint32_t> ids;
+		for (size_t i = 0; i < tags.size(); ++i)
+		{
+			for (size_t t = 1; t < threads; ++t)
+				EXPECT_EQ(symbols[t][i], symbols[0][i]);
+
+			EXPECT_EQ(pool.find(tags[i].view()), symbols[0][i]);
+			ids.push_back(symbols[0][i].id());
+		}
+
+		// The ids are dense: 1 to tags.size().
+		std::ranges::sort(ids);
+		EXPECT_EQ(ids.front(), 1);
+		EXPECT_EQ(ids.back(), tags.size());
+		EXPECT_EQ(std::ranges::adjacent_find(ids), ids.end());
+
+		const auto memory = pool.memory_usage();
+		EXPECT_EQ(memory.symbols, tags.size() + 1);
+		EXPECT_GE(memory.arena_bytes, memory.string_bytes);
+	}
+}// namespace InternPoolTests
@@ -0,0 +1,84 @@
+#include "../src/Array.h"
+#include "../src/String.h"
+#include "../src/Vector.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+#include <ranges>
+
+namespace IteratorTests
+{
+	using namespace cpp;
+
+	static_assert(std::contiguous_iterator<Vector<int>::It>);
+	static_assert(std::contiguous_iterator<Vector<int>::ConstIterator>);
+	static_assert(std::contiguous_iterator<Array<int, 4>::it>);
+	static_assert(std::contiguous_iterator<String::It>);
+	static_assert(std::contiguous_iterator<String::ConstIt>);
+	static_assert(std::ranges::contiguous_range<Vector<int>>);
+	static_assert(std::ranges::contiguous_range<const Vector<int>>);
+	static_assert(std::ranges::contiguous_range<Array<int, 4>>);
+	static_assert(std::ranges::contiguous_range<String>);
+	static_assert(std::is_convertible_v<Vector<int>::It, Vector<int>::ConstIterator>);
+	static_assert(!std::is_convertible_v<Vector<int>::ConstIterator, Vector<int>::It>);
+
+	TEST(iterator_test, increment_and_decrement)
+	{
+		Vector<int> vec{ 1, 2, 3 };
+		auto it = vec.begin();
+
+		EXPECT_EQ(*it++, 1);
+		EXPECT_EQ(*it, 2);
+		EXPECT_EQ(*++it, 3);
+		EXPECT_EQ(*it--, 3);
+		EXPECT_EQ(*it, 2);
+		EXPECT_EQ(*--it, 1);
+	}
+
+	TEST(iterator_test, arithmetic)
+	{
+		Vector<int> vec{ 1, 2, 3, 4 };
+		const auto first = vec.begin();
+		const auto last = vec.end();
+
+		EXPECT_EQ(last - first, 4);
+		EXPECT_EQ(*(first + 2), 3);
+		EXPECT_EQ(*(2 + first), 3);
+		EXPECT_EQ(*(last - 1), 4);
+		EXPECT_EQ(first[3], 4);
+		EXPECT_TRUE(first < last);
+		EXPECT_EQ(std::to_address(first), vec.data());
+	}
+
+	TEST(iterator_test, const_conversion)
+	{
+		Vector<int> vec{ 1, 2 };
+		Vector<int>::ConstIterator it = vec.begin();
+
+		EXPECT_TRUE(it == vec.begin());
+		EXPECT_EQ(*it, 1);
+	}
+
+	TEST(iterator_test, standard_algorithms)
+	{
+		Vector<int> vec{ 5, 3, 1, 4, 2 };
+		std::sort(vec.begin(), vec.end());
+		EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+
+		Array<int, 5> arr{};
+		std::copy(vec.begin(), vec.end(), arr.begin());
+		EXPECT_EQ(arr[4], 5);
+
+		std::ranges::reverse(arr);
+		EXPECT_EQ(arr[0], 5);
+		EXPECT_EQ(std::accumulate(arr.begin(), arr.end(), 0), 15);
+	}
+
+	TEST(iterator_test, mutable_string_iterator)
+	{
+		String str = "hello";
+		std::ranges::transform(str, str.begin(), [](const char c) { return static_cast<char>(c - 'a' + 'A'); });
+
+		EXPECT_STREQ(str.c_str(), "HELLO");
+	}
+}// namespace IteratorTests
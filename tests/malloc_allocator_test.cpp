@@ -0,0 +1,62 @@
+#include "../src/MallocAllocator.h"
+#include "../src/String.h"
+#include "../src/Vector.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+
+namespace MallocAllocatorTests
+{
+	using namespace cpp;
+
+	static_assert(ReallocatingAllocator<MallocAllocator<int>, int>);
+	static_assert(SizeReportingAllocator<MallocAllocator<int>, int>);
+	static_assert(!ReallocatingAllocator<std::allocator<int>, int>);
+
+	TEST(malloc_allocator_test, allocate_and_reallocate)
+	{
+		MallocAllocator<int> alloc;
+		auto p = alloc.allocate(4);
+		std::iota(p, p + 4, 0);
+
+		EXPECT_GE(alloc.usable_size(p, 4), 4);
+
+		p = alloc.reallocate(p, 4, 1000);
+		EXPECT_EQ(p[3], 3);
+
+		alloc.deallocate(p, 1000);
+		EXPECT_EQ(MallocAllocator<int>(), MallocAllocator<long>());
+	}
+
+	TEST(malloc_allocator_test, vector_grows_with_realloc)
+	{
+		Vector<int, MallocAllocator<int>> vec;
+		for (int i = 0; i < 100000; ++i)
+			vec.push_back(i);
+
+		EXPECT_EQ(vec.size(), 100000);
+		EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0ll), 99999ll * 100000 / 2);
+
+		vec.resize(10);
+		vec.shrink_to_fit();
+		EXPECT_EQ(vec.capacity(), 10);
+		EXPECT_EQ(vec.back(), 9);
+
+		vec.reserve(50);
+		EXPECT_EQ(vec.capacity(), 50);
+		EXPECT_EQ(vec[5], 5);
+	}
+
+	TEST(malloc_allocator_test, push_back_of_own_element_while_reallocating)
+	{
+		Vector<String, MallocAllocator<String>> vec;
+		vec.push_back("a string long enough to live on the heap");
+
+		for (int i = 0; i < 100; ++i)
+			vec.push_back(vec[0]);
+
+		EXPECT_EQ(vec.size(), 101);
+		for (const auto& s : vec)
+			EXPECT_EQ(s, "a string long enough to live on the heap");
+	}
+}// namespace MallocAllocatorTests
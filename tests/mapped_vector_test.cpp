@@ -0,0 +1,183 @@
+#include "../src/MappedVector.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+
+namespace MappedVectorTests
+{
+	using namespace cpp;
+
+	struct Record {
+		uint64_t id;
+		double weight;
+		char tag[8];
+	};
+
+	// A file in the temporary directory that is removed when the test ends.
+	class TempFile
+	{
+	public:
+		explicit TempFile(const char* name)
+			: m_path(std::filesystem::temp_directory_path() / name)
+		{
+			std::filesystem::remove(m_path);
+		}
+
+		~TempFile()
+		{
+			std::filesystem::remove(m_path);
+		}
+
+		[[nodiscard]] const std::filesystem::path& path() const noexcept
+		{
+			return m_path;
+		}
+
+	private:
+		std::filesystem::path m_path;
+	};
+
+	TEST(mapped_vector_test, create_and_push_back)
+	{
+		const TempFile file("mapped_vector_create.bin");
+		auto vec = MappedVector<uint64_t>::create(file.path());
+
+		EXPECT_TRUE(vec.is_open());
+		EXPECT_TRUE(vec.empty());
+
+		for (uint64_t i = 0; i < 1000; ++i)
+			vec.push_back(i * i);
+
+		EXPECT_EQ(vec.size(), 1000);
+		EXPECT_GE(vec.capacity(), 1000);
+		EXPECT_EQ(vec.front(), 0);
+		EXPECT_EQ(vec.back(), 999 * 999);
+		EXPECT_EQ(vec[10], 100);
+		EXPECT_THROW((void) vec.at(1000), std::out_of_range);
+	}
+
+	TEST(mapped_vector_test, reopen_keeps_elements)
+	{
+		const TempFile file("mapped_vector_reopen.bin");
+		{
+			auto vec = MappedVector<Record>::create(file.path(), 4);
+			vec.push_back({ 1, 0.5, "one" });
+			vec.push_back({ 2, 1.5, "two" });
+			vec.push_back({ 3, 2.5, "three" });
+			vec.sync();
+		}
+
+		auto vec = MappedVector<Record>::open(file.path());
+		ASSERT_EQ(vec.size(), 3);
+		EXPECT_EQ(vec.capacity(), 4);
+		EXPECT_EQ(vec[1].id, 2);
+		EXPECT_EQ(vec[1].weight, 1.5);
+		EXPECT_STREQ(vec[2].tag, "three");
+
+		vec.push_back({ 4, 3.5, "four" });
+		vec.push_back({ 5, 4.5, "five" });
+		EXPECT_EQ(MappedVector<Record>::open(file.path()).size(), 5);
+	}
+
+	TEST(mapped_vector_test, mappings_of_one_file_share_changes)
+	{
+		const TempFile file("mapped_vector_shared.bin");
+		auto writer = MappedVector<int>::create(file.path(), 8);
+		writer.resize(8, 0);
+
+		const auto reader = MappedVector<int>::open(file.path());
+		writer[3] = 42;
+
+		EXPECT_EQ(reader[3], 42);
+
+		// The reader's mapping covers 8 elements, so it does not see the ones appended past them.
+		writer.resize(1000, 1);
+		EXPECT_EQ(reader.size(), 8);
+		EXPECT_EQ(reader.end() - reader.begin(), 8);
+		EXPECT_EQ(MappedVector<int>::open(file.path()).size(), 1000);
+	}
+
+	TEST(mapped_vector_test, grow_keeps_elements)
+	{
+		const TempFile file("mapped_vector_grow.bin");
+		auto vec = MappedVector<int>::create(file.path());
+		vec.resize(100, 7);
+
+		vec.grow(1 << 20);
+		EXPECT_EQ(vec.capacity(), 1 << 20);
+		EXPECT_EQ(std::filesystem::file_size(file.path()), 64 + (1 << 20) * sizeof(int));
+		EXPECT_EQ(std::count(vec.begin(), vec.end(), 7), 100);
+
+		vec.grow(10);
+		EXPECT_EQ(vec.capacity(), 1 << 20);
+
+		vec.shrink_to_fit();
+		EXPECT_EQ(vec.capacity(), 100);
+		EXPECT_EQ(std::filesystem::file_size(file.path()), 64 + 100 * sizeof(int));
+		EXPECT_EQ(std::count(vec.begin(), vec.end(), 7), 100);
+	}
+
+	TEST(mapped_vector_test, push_back_of_own_element_while_growing)
+	{
+		const TempFile file("mapped_vector_alias.bin");
+		auto vec = MappedVector<uint64_t>::create(file.path());
+		vec.push_back(5);
+
+		for (int i = 0; i < 20; ++i)
+			vec.push_back(vec[0]);
+
+		EXPECT_EQ(std::count(vec.begin(), vec.end(), 5), 21);
+	}
+
+	TEST(mapped_vector_test, works_with_standard_algorithms)
+	{
+		const TempFile file("mapped_vector_algorithms.bin");
+		auto vec = MappedVector<int>::create(file.path());
+		vec.resize(50);
+		std::iota(vec.begin(), vec.end(), 0);
+		std::reverse(vec.begin(), vec.end());
+
+		EXPECT_EQ(vec.front(), 49);
+		EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0), 49 * 50 / 2);
+		EXPECT_EQ(vec.end() - vec.begin(), 50);
+
+		vec.pop_back();
+		EXPECT_EQ(vec.back(), 1);
+
+		vec.clear();
+		EXPECT_TRUE(vec.empty());
+		EXPECT_EQ(vec.capacity(), 50);
+	}
+
+	TEST(mapped_vector_test, move)
+	{
+		const TempFile file("mapped_vector_move.bin");
+		auto vec = MappedVector<int>::create(file.path());
+		vec.push_back(1);
+
+		auto moved = std::move(vec);
+		EXPECT_FALSE(vec.is_open());
+		EXPECT_EQ(vec.size(), 0);
+		EXPECT_EQ(moved.size(), 1);
+
+		MappedVector<int> other;
+		other = std::move(moved);
+		EXPECT_EQ(other[0], 1);
+
+		MappedVector<int> empty;
+		other.swap(empty);
+		EXPECT_FALSE(other.is_open());
+		EXPECT_EQ(empty[0], 1);
+	}
+
+	TEST(mapped_vector_test, open_rejects_other_files)
+	{
+		const TempFile missing("mapped_vector_missing.bin");
+		EXPECT_THROW((void) MappedVector<int>::open(missing.path()), std::system_error);
+
+		const TempFile file("mapped_vector_mismatch.bin");
+		MappedVector<uint64_t>::create(file.path(), 4).push_back(1);
+		EXPECT_THROW((void) MappedVector<uint32_t>::open(file.path()), std::runtime_error);
+		EXPECT_NO_THROW((void) MappedVector<uint64_t>::open(file.path()));
+	}
+}// namespace MappedVectorTests
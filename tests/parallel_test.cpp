@@ -0,0 +1,167 @@
+#include "../src/Array.h"
+#include "../src/Parallel.h"
+#include "../src/String.h"
+#include "../src/Vector.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+#include <random>
+
+namespace ParallelTests
+{
+	using namespace cpp;
+
+	Vector<int> make_random(const size_t n)
+	{
+		std::mt19937 random(42);
+		Vector<int> vec(n);
+		for (size_t i = 0; i < n; ++i)
+			vec.push_back(static_cast<int>(random() % 1000));
+
+		return vec;
+	}
+
+	TEST(parallel_test, thread_pool_runs_submitted_tasks)
+	{
+		parallel::ThreadPool pool(3);
+		std::atomic<int> count = 0;
+
+		{
+			parallel::TaskGroup group(pool);
+			for (int i = 0; i < 100; ++i)
+				group.run([&count] { ++count; });
+			group.wait();
+		}
+
+		EXPECT_EQ(pool.size(), 3);
+		EXPECT_EQ(count, 100);
+	}
+
+	TEST(parallel_test, task_group_rethrows)
+	{
+		parallel::TaskGroup group;
+		group.run([] { throw std::runtime_error("task failed"); });
+
+		EXPECT_THROW(group.wait(), std::runtime_error);
+	}
+
+	TEST(parallel_test, parallel_for_visits_every_index_once)
+	{
+		const auto visits = std::make_unique<std::atomic<int>[]>(10000);
+
+		parallel::parallel_for(0, 10000, [&](const size_t i) { ++visits[i]; }, 7);
+
+		for (size_t i = 0; i < 10000; ++i)
+			EXPECT_EQ(visits[i], 1);
+	}
+
+	TEST(parallel_test, for_each_array)
+	{
+		Array<int, 5> arr = { 1, 2, 3, 4, 5 };
+
+		parallel::for_each(arr, [](int& value) { value *= 2; }, 2);
+
+		EXPECT_EQ(arr[0], 2);
+		EXPECT_EQ(arr[4], 10);
+	}
+
+	TEST(parallel_test, transform)
+	{
+		const auto in = make_random(100000);
+		Vector<long> out;
+		out.resize(in.size());
+
+		parallel::transform(in, out, [](const int value) { return value * 3L; });
+
+		for (size_t i = 0; i < in.size(); ++i)
+			ASSERT_EQ(out[i], in[i] * 3L);
+	}
+
+	TEST(parallel_test, transform_short_output)
+	{
+		const Vector<int> in{ 1, 2, 3 };
+		Vector<int> out{ 1 };
+
+		EXPECT_THROW(parallel::transform(in, out, [](const int value) { return value; }), std::invalid_argument);
+	}
+
+	TEST(parallel_test, reduce)
+	{
+		const auto in = make_random(1000000);
+
+		EXPECT_EQ(parallel::reduce(in, 0L), std::accumulate(in.begin(), in.end(), 0L));
+		EXPECT_EQ(parallel::reduce(Vector<int>{}, 5), 5);
+	}
+
+	TEST(parallel_test, reduce_is_deterministic)
+	{
+		Vector<double> in(1000000);
+		for (size_t i = 0; i < 1000000; ++i)
+			in.push_back(1.0 / static_cast<double>(i + 1));
+
+		const auto first = parallel::reduce(in, 0.0);
+		for (int run = 0; run < 5; ++run)
+			EXPECT_EQ(parallel::reduce(in, 0.0), first);
+	}
+
+	TEST(parallel_test, inclusive_scan)
+	{
+		const auto in = make_random(100000);
+		Vector<long> out;
+		out.resize(in.size());
+		Vector<long> expected;
+		expected.resize(in.size());
+
+		parallel::inclusive_scan(in, out, std::plus<>{}, 1000);
+		std::inclusive_scan(in.begin(), in.end(), expected.begin(), std::plus<>{}, 0L);
+
+		for (size_t i = 0; i < in.size(); ++i)
+			ASSERT_EQ(out[i], expected[i]);
+	}
+
+	TEST(parallel_test, inclusive_scan_in_place)
+	{
+		Vector<int> vec;
+		vec.resize(10000, 1);
+
+		parallel::inclusive_scan(vec, vec, std::plus<>{}, 64);
+
+		EXPECT_EQ(vec[0], 1);
+		EXPECT_EQ(vec[9999], 10000);
+	}
+
+	TEST(parallel_test, sort)
+	{
+		auto vec = make_random(1000000);
+		auto expected = vec;
+
+		parallel::sort(vec);
+		std::sort(expected.begin(), expected.end());
+
+		for (size_t i = 0; i < vec.size(); ++i)
+			ASSERT_EQ(vec[i], expected[i]);
+	}
+
+	TEST(parallel_test, sort_strings_descending)
+	{
+		auto numbers = make_random(10000);
+		Vector<String> vec;
+		for (const auto number : numbers)
+			vec.emplace_back(std::to_string(number).append(30, '.').c_str());
+
+		const auto descending = [](const String& a, const String& b) { return std::strcmp(a.c_str(), b.c_str()) > 0; };
+		auto expected = vec;
+		std::sort(expected.begin(), expected.end(), descending);
+
+		// 100 chunks take 7 merge passes, which end in the range, and 50 take 6, which end in the buffer.
+		for (const size_t grain : { 100, 200 })
+		{
+			auto sorted = vec;
+			parallel::sort(sorted, descending, grain);
+
+			ASSERT_EQ(sorted.size(), expected.size());
+			for (size_t i = 0; i < sorted.size(); ++i)
+				ASSERT_EQ(sorted[i], expected[i]) << grain;
+		}
+	}
+}// namespace ParallelTests
@@ -0,0 +1,125 @@
+#include "../src/Rope.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+namespace RopeTests
+{
+	using namespace cpp;
+
+	String filled(const size_t n, const char c)
+	{
+		String str;
+		str.append(n, c);
+		return str;
+	}
+
+	// A rope of count pieces "0,1,2,...," appended one by one, together with the same text built flat.
+	std::pair<Rope, String> build(const int count)
+	{
+		Rope rope;
+		String flat;
+
+		for (int i = 0; i < count; ++i)
+		{
+			const auto piece = std::to_string(i) + ",";
+			rope.append(piece.c_str());
+			flat.append(piece.c_str());
+		}
+
+		return { rope, flat };
+	}
+
+	TEST(rope_test, construct)
+	{
+		const Rope empty;
+		const Rope hello("Hello World!");
+
+		EXPECT_TRUE(empty.empty());
+		EXPECT_EQ(hello.size(), 12);
+		EXPECT_EQ(hello, "Hello World!");
+	}
+
+	TEST(rope_test, concatenate_shares_chunks)
+	{
+		const Rope left(filled(300, 'a'));
+		const Rope right(filled(300, 'b'));
+		const auto both = left + right;
+
+		EXPECT_EQ(both.size(), 600);
+		EXPECT_EQ(both[299], 'a');
+		EXPECT_EQ(both[300], 'b');
+
+		auto chunk = both.chunks().begin();
+		EXPECT_EQ((*chunk).data(), (*left.chunks().begin()).data());
+	}
+
+	TEST(rope_test, small_pieces_are_merged)
+	{
+		const auto [rope, flat] = build(1000);
+
+		EXPECT_EQ(rope.size(), flat.size());
+		EXPECT_LT(std::distance(rope.chunks().begin(), rope.chunks().end()), 30);
+		EXPECT_EQ(rope.to_string(), flat);
+	}
+
+	TEST(rope_test, stays_balanced)
+	{
+		Rope rope;
+		for (int i = 0; i < 4096; ++i)
+			rope.append(Rope(filled(Rope::small_chunk, static_cast<char>('a' + i % 26))));
+
+		EXPECT_EQ(rope.size(), 4096 * Rope::small_chunk);
+		EXPECT_LE(rope.depth(), 2 * 12);
+	}
+
+	TEST(rope_test, index)
+	{
+		const auto [rope, flat] = build(5000);
+
+		for (size_t i = 0; i < flat.size(); i += 7)
+			ASSERT_EQ(rope[i], flat[i]);
+
+		EXPECT_THROW((void) rope.at(flat.size()), std::out_of_range);
+	}
+
+	TEST(rope_test, substr)
+	{
+		const auto [rope, flat] = build(5000);
+
+		for (const auto& [pos, len] : { std::pair<size_t, size_t>{ 0, 10 }, { 5, 3000 }, { 1234, 20000 }, { flat.size() - 1, 5 } })
+			EXPECT_EQ(rope.substr(pos, len), flat.view(pos, len));
+
+		EXPECT_TRUE(rope.substr(flat.size()).empty());
+	}
+
+	TEST(rope_test, prepend)
+	{
+		Rope rope("tail");
+		for (int i = 0; i < 100; ++i)
+			rope = Rope(filled(300, 'x')) + rope;
+
+		EXPECT_EQ(rope.size(), 30004);
+		EXPECT_EQ(rope.substr(30000), "tail");
+		EXPECT_LE(rope.depth(), 14);
+	}
+
+	TEST(rope_test, equality)
+	{
+		const auto [rope, flat] = build(200);
+		const Rope other(flat);
+
+		EXPECT_EQ(rope, other);
+		EXPECT_FALSE(rope == Rope("0,1,"));
+		EXPECT_FALSE(rope + "x" == other + "y");
+	}
+
+	TEST(rope_test, stream)
+	{
+		const auto rope = Rope("Hello ") + Rope(filled(300, '!'));
+		std::ostringstream os;
+		os << rope;
+
+		EXPECT_EQ(os.str(), "Hello " + std::string(300, '!'));
+	}
+}// namespace RopeTests
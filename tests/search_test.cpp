@@ -0,0 +1,98 @@
+#include "../src/Search.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <string>
+
+namespace SearchTests
+{
+	using namespace cpp;
+
+	// Reference results come from std::string, which the kernels have to agree with.
+	std::string random_text(const size_t n, const unsigned seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<int> letter('a', 'd');
+
+		std::string text(n, ' ');
+		for (auto& c : text)
+			c = static_cast<char>(letter(rng));
+
+		return text;
+	}
+
+	TEST(search_test, find_matches_reference)
+	{
+		for (const size_t n : { 0, 1, 15, 16, 17, 31, 32, 33, 100, 1000 })
+		{
+			const auto text = random_text(n, static_cast<unsigned>(n));
+			for (const std::string needle : { "a", "ab", "abc", "dcba", "abcdabcd", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" })
+			{
+				const auto expected = text.find(needle);
+				EXPECT_EQ(search::find(text.data(), n, needle.data(), needle.size()), expected);
+				EXPECT_EQ(search::scalar::find(text.data(), n, needle.data(), needle.size()), expected);
+#if CPP_SEARCH_X86
+				if (needle.size() >= 2)
+				{
+					EXPECT_EQ(search::sse2::find(text.data(), n, needle.data(), needle.size()), expected);
+					if (search::detail::cpu_features().avx2)
+					{
+						EXPECT_EQ(search::avx2::find(text.data(), n, needle.data(), needle.size()), expected);
+					}
+				}
+#endif
+				EXPECT_EQ(search::rfind(text.data(), n, needle.data(), needle.size()), text.rfind(needle));
+			}
+		}
+	}
+
+	TEST(search_test, find_at_end_of_range)
+	{
+		std::string text(64, 'a');
+		text[62] = 'x';
+		text[63] = 'y';
+
+		EXPECT_EQ(search::find(text.data(), text.size(), "xy", 2), 62);
+		EXPECT_EQ(search::find(text.data(), text.size() - 1, "xy", 2), search::npos);
+		EXPECT_EQ(search::rfind_char(text.data(), text.size(), 'x'), 62);
+		EXPECT_EQ(search::find(text.data(), text.size(), "", 0), 0);
+		EXPECT_EQ(search::rfind(text.data(), text.size(), "", 0), 64);
+	}
+
+	TEST(search_test, characters_match_reference)
+	{
+		for (const size_t n : { 0, 1, 15, 16, 17, 31, 32, 33, 100, 1000 })
+		{
+			const auto text = random_text(n, static_cast<unsigned>(n) + 1);
+			for (const char c : { 'a', 'd', 'z' })
+			{
+				EXPECT_EQ(search::find_char(text.data(), n, c), text.find(c));
+				EXPECT_EQ(search::rfind_char(text.data(), n, c), text.rfind(c));
+				EXPECT_EQ(search::count_char(text.data(), n, c), static_cast<size_t>(std::count(text.begin(), text.end(), c)));
+				EXPECT_EQ(search::scalar::rfind_char(text.data(), n, c), text.rfind(c));
+			}
+		}
+	}
+
+	TEST(search_test, sets_match_reference)
+	{
+		for (const size_t n : { 0, 1, 15, 16, 17, 100, 1000 })
+		{
+			const auto text = random_text(n, static_cast<unsigned>(n) + 2);
+			for (const std::string set : { "", "d", "cd", "xyzd", "0123456789abcdefghijklmnopqrstuvwxyz" })
+			{
+				EXPECT_EQ(search::find_first_of(text.data(), n, set.data(), set.size()), text.find_first_of(set));
+				EXPECT_EQ(search::find_last_of(text.data(), n, set.data(), set.size()), text.find_last_of(set));
+			}
+		}
+	}
+
+	TEST(search_test, count_non_overlapping)
+	{
+		const std::string text = "aaaaa abab ab";
+		EXPECT_EQ(search::count(text.data(), text.size(), "aa", 2), 2);
+		EXPECT_EQ(search::count(text.data(), text.size(), "ab", 2), 3);
+		EXPECT_EQ(search::count(text.data(), text.size(), "a", 1), 8);
+		EXPECT_EQ(search::count(text.data(), text.size(), "abc", 3), 0);
+	}
+}// namespace SearchTests
@@ -0,0 +1,141 @@
+#include "../src/SegmentedVector.h"
+#include "../src/String.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+
+namespace SegmentedVectorTests
+{
+	using namespace cpp;
+
+	// Enough elements to span several blocks.
+	constexpr size_t many = 3 * SegmentedVector<int>::block_size + 17;
+
+	SegmentedVector<int> make_sequence(const size_t n)
+	{
+		SegmentedVector<int> vec;
+		for (size_t i = 0; i < n; ++i)
+			vec.push_back(static_cast<int>(i));
+
+		return vec;
+	}
+
+	TEST(segmented_vector_test, initializer_list)
+	{
+		const SegmentedVector<int> vec{ 1, 2, 3 };
+
+		EXPECT_EQ(vec.size(), 3);
+		EXPECT_EQ(vec.front(), 1);
+		EXPECT_EQ(vec.back(), 3);
+		EXPECT_THROW((void) vec.at(3), std::out_of_range);
+	}
+
+	TEST(segmented_vector_test, growth_never_moves_elements)
+	{
+		SegmentedVector<String> vec;
+		vec.push_back("a string long enough to live on the heap");
+		const auto first = &vec[0];
+
+		for (size_t i = 0; i < 5 * SegmentedVector<String>::block_size; ++i)
+			vec.emplace_back("x");
+
+		EXPECT_EQ(&vec[0], first);
+		EXPECT_EQ(vec[0], "a string long enough to live on the heap");
+		EXPECT_EQ(vec.block_count(), 6);
+	}
+
+	TEST(segmented_vector_test, index_across_blocks)
+	{
+		const auto vec = make_sequence(many);
+
+		for (size_t i = 0; i < many; ++i)
+			ASSERT_EQ(vec[i], static_cast<int>(i));
+	}
+
+	TEST(segmented_vector_test, iterators)
+	{
+		static_assert(std::random_access_iterator<SegmentedVector<int>::It>);
+		static_assert(std::random_access_iterator<SegmentedVector<int>::ConstIterator>);
+
+		auto vec = make_sequence(many);
+
+		EXPECT_EQ(static_cast<size_t>(vec.end() - vec.begin()), many);
+		EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), int64_t{ 0 }), static_cast<int64_t>(many) * (many - 1) / 2);
+
+		int expected = static_cast<int>(many);
+		for (auto it = vec.end(); it != vec.begin();)
+			ASSERT_EQ(*--it, --expected);
+
+		const auto middle = vec.begin() + static_cast<std::ptrdiff_t>(SegmentedVector<int>::block_size + 3);
+		EXPECT_EQ(*middle, static_cast<int>(SegmentedVector<int>::block_size + 3));
+		EXPECT_EQ(middle[-4], static_cast<int>(SegmentedVector<int>::block_size - 1));
+
+		SegmentedVector<int>::ConstIterator const_begin = vec.begin();
+		EXPECT_EQ(*const_begin, 0);
+	}
+
+	TEST(segmented_vector_test, sort)
+	{
+		SegmentedVector<int> vec;
+		for (size_t i = 0; i < many; ++i)
+			vec.push_back(static_cast<int>((i * 7919) % many));
+
+		std::sort(vec.begin(), vec.end());
+
+		EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+		EXPECT_EQ(vec.front(), 0);
+		EXPECT_EQ(vec.back(), static_cast<int>(many - 1));
+	}
+
+	TEST(segmented_vector_test, resize_and_shrink_to_fit)
+	{
+		auto vec = make_sequence(many);
+
+		vec.resize(10);
+		EXPECT_EQ(vec.size(), 10);
+		EXPECT_EQ(vec.block_count(), 4);
+
+		vec.shrink_to_fit();
+		EXPECT_EQ(vec.block_count(), 1);
+		EXPECT_EQ(vec.back(), 9);
+
+		vec.resize(20, 5);
+		EXPECT_EQ(vec[19], 5);
+	}
+
+	TEST(segmented_vector_test, copy_and_move)
+	{
+		auto vec = make_sequence(many);
+
+		SegmentedVector<int> copied(vec);
+		EXPECT_EQ(copied.size(), many);
+		EXPECT_EQ(copied[many - 1], static_cast<int>(many - 1));
+
+		SegmentedVector<int> moved(std::move(vec));
+		EXPECT_TRUE(vec.empty());
+		EXPECT_EQ(moved[many - 1], static_cast<int>(many - 1));
+
+		SegmentedVector<int> assigned{ 1 };
+		assigned = copied;
+		EXPECT_EQ(assigned.size(), many);
+
+		assigned = std::move(moved);
+		EXPECT_EQ(assigned[5], 5);
+
+		assigned.swap(vec);
+		EXPECT_TRUE(assigned.empty());
+		EXPECT_EQ(vec.size(), many);
+	}
+
+	TEST(segmented_vector_test, pmr_allocates_from_resource)
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		pmr::SegmentedVector<int> vec(&arena);
+
+		for (int i = 0; i < 100; ++i)
+			vec.push_back(i);
+
+		EXPECT_EQ(vec.get_allocator().resource(), &arena);
+		EXPECT_EQ(vec.at(99), 99);
+	}
+}// namespace SegmentedVectorTests
@@ -0,0 +1,211 @@
+#include "../src/Array.h"
+#include "../src/Serialization.h"
+#include "../src/String.h"
+#include "gtest/gtest.h"
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace SerializationTests
+{
+	using namespace cpp;
+
+	struct Point {
+		int32_t x, y;
+		double weight;
+	};
+
+	// Writes records to a temporary file through write() and loads them back into an aligned buffer.
+	// The file is named after the test and the process, since ctest may run the tests in parallel.
+	class Stream
+	{
+	public:
+		Stream()
+			: m_path(std::filesystem::temp_directory_path() / file_name())
+		{
+			m_fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if (m_fd < 0)
+				throw std::system_error(errno, std::generic_category(), "cannot open " + m_path.string());
+		}
+
+		~Stream()
+		{
+			::close(m_fd);
+			std::filesystem::remove(m_path);
+		}
+
+		template<typename Container>
+		void write(const Container& container)
+		{
+			binary::write(m_fd, container);
+		}
+
+		Vector<std::byte> load() const
+		{
+			Vector<std::byte> bytes;
+			bytes.resize(std::filesystem::file_size(m_path));
+
+			std::ifstream in(m_path, std::ios::binary);
+			in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			return bytes;
+		}
+
+	private:
+		static std::string file_name()
+		{
+			const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+			return std::string("serialization_test.") + test->name() + "." + std::to_string(::getpid()) + ".bin";
+		}
+
+		std::filesystem::path m_path;
+		int m_fd;
+	};
+
+	TEST(serialization_test, array_records)
+	{
+		const Vector<uint64_t> ids{ 1, 2, 3, 1ull << 40 };
+		Array<Point, 2> points;
+		points[0] = { 1, 2, 0.5 };
+		points[1] = { 3, 4, 1.5 };
+
+		Stream stream;
+		stream.write(ids);
+		stream.write(points);
+
+		const auto bytes = stream.load();
+		EXPECT_EQ(bytes.size() % binary::record_alignment, 0);
+
+		binary::Reader reader(bytes);
+		EXPECT_EQ(reader.peek_kind(), binary::RecordKind::array);
+
+		const auto ids_view = reader.read_array<uint64_t>();
+		ASSERT_EQ(ids_view.size(), 4);
+		EXPECT_EQ(ids_view.back(), 1ull << 40);
+		EXPECT_TRUE(std::equal(ids_view.begin(), ids_view.end(), ids.begin()));
+
+		// The views point into the buffer; nothing was copied out of it.
+		EXPECT_EQ(static_cast<const void*>(ids_view.data()), bytes.data() + sizeof(binary::RecordHeader));
+
+		const auto points_view = reader.read_array<Point>();
+		ASSERT_EQ(points_view.size(), 2);
+		EXPECT_EQ(points_view[1].y, 4);
+		EXPECT_EQ(points_view[1].weight, 1.5);
+		EXPECT_TRUE(reader.done());
+	}
+
+	TEST(serialization_test, strings)
+	{
+		const String greeting = "hello, serialized world";
+		const Vector<String> words{ "zero", "", "copy", "a string long enough to live on the heap" };
+
+		Stream stream;
+		stream.write(greeting);
+		stream.write(words);
+		stream.write(Vector<String>());
+
+		const auto bytes = stream.load();
+		binary::Reader reader(bytes);
+
+		EXPECT_EQ(reader.read_string(), "hello, serialized world");
+
+		EXPECT_EQ(reader.peek_kind(), binary::RecordKind::string_list);
+		const auto list = reader.read_strings();
+		ASSERT_EQ(list.size(), 4);
+		EXPECT_EQ(list[0], "zero");
+		EXPECT_TRUE(list[1].empty());
+		EXPECT_EQ(list.at(3), words[3].view());
+		EXPECT_THROW((void) list.at(4), std::out_of_range);
+
+		size_t i = 0;
+		for (const auto word : list)
+			EXPECT_EQ(word, words[i++].view());
+		EXPECT_EQ(i, 4);
+
+		EXPECT_TRUE(reader.read_strings().empty());
+		EXPECT_TRUE(reader.done());
+	}
+
+	TEST(serialization_test, many_strings)
+	{
+		Vector<String> numbers;
+		for (int i = 0; i < 5000; ++i)
+			numbers.push_back(String(std::to_string(i).c_str()));
+
+		Stream stream;
+		stream.write(numbers);
+
+		const auto bytes = stream.load();
+		binary::Reader reader(bytes);
+		const auto list = reader.read_strings();
+
+		ASSERT_EQ(list.size(), 5000);
+		EXPECT_EQ(list[4321], "4321");
+	}
+
+	TEST(serialization_test, writes_to_a_pipe)
+	{
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+
+		const Vector<int16_t> values{ -1, 2, -3 };
+		binary::write(fds[1], values);
+		::close(fds[1]);
+
+		alignas(binary::record_alignment) std::byte buffer[256];
+		const auto n = ::read(fds[0], buffer, sizeof(buffer));
+		::close(fds[0]);
+
+		ASSERT_EQ(n, sizeof(binary::RecordHeader) + binary::record_alignment);
+
+		binary::Reader reader(buffer, static_cast<size_t>(n));
+		const auto view = reader.read_array<int16_t>();
+		ASSERT_EQ(view.size(), 3);
+		EXPECT_EQ(view[2], -3);
+	}
+
+	TEST(serialization_test, rejects_mismatched_records)
+	{
+		Stream stream;
+		stream.write(Vector<uint32_t>{ 1, 2, 3 });
+
+		const auto bytes = stream.load();
+
+		binary::Reader wrong_type(bytes);
+		EXPECT_THROW((void) wrong_type.read_array<uint64_t>(), std::runtime_error);
+		EXPECT_THROW((void) wrong_type.read_strings(), std::runtime_error);
+
+		binary::Reader truncated(bytes.data(), sizeof(binary::RecordHeader) + 4);
+		EXPECT_THROW((void) truncated.read_array<uint32_t>(), std::runtime_error);
+
+		binary::Reader reader(bytes);
+		EXPECT_EQ(reader.read_array<uint32_t>().size(), 3);
+		EXPECT_THROW((void) reader.read_array<uint32_t>(), std::runtime_error);
+
+		auto newer = bytes;
+		reinterpret_cast<binary::RecordHeader*>(newer.data())->version = binary::format_version + 1;
+		EXPECT_THROW((void) binary::Reader(newer).read_array<uint32_t>(), std::runtime_error);
+
+		auto garbage = bytes;
+		garbage[0] = std::byte{ 0 };
+		EXPECT_THROW((void) binary::Reader(garbage).read_array<uint32_t>(), std::runtime_error);
+	}
+
+	TEST(serialization_test, rejects_corrupt_string_offsets)
+	{
+		Stream stream;
+		stream.write(Vector<String>{ "ab", "cd" });
+
+		auto bytes = stream.load();
+		auto offsets = reinterpret_cast<uint64_t*>(bytes.data() + sizeof(binary::RecordHeader));
+		offsets[1] = 100;
+
+		binary::Reader reader(bytes);
+		EXPECT_THROW((void) reader.read_strings(), std::runtime_error);
+	}
+}// namespace SerializationTests
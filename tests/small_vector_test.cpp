@@ -0,0 +1,321 @@
+#include "../src/SmallVector.h"
+#include "../src/String.h"
+#include "gtest/gtest.h"
+
+namespace SmallVectorTests
+{
+	using namespace cpp;
+
+	// Counts the constructor and destructor calls made on it, to check what the container runs.
+	struct Tracked {
+		static inline int constructed = 0;
+		static inline int destroyed = 0;
+
+		static void reset()
+		{
+			constructed = destroyed = 0;
+		}
+
+		explicit Tracked(int v)
+			: value(v)
+		{
+			++constructed;
+		}
+
+		Tracked(const Tracked& other)
+			: value(other.value)
+		{
+			++constructed;
+		}
+
+		Tracked(Tracked&& other) noexcept
+			: value(other.value)
+		{
+			++constructed;
+		}
+
+		~Tracked()
+		{
+			++destroyed;
+		}
+
+		int value;
+	};
+
+	// Throws on copy once copies_left reaches zero. It has no move constructor, so growing copies it.
+	struct Fragile {
+		static inline int copies_left = -1;
+
+		Fragile(const int v)
+			: value(v)
+		{
+		}
+
+		Fragile(const Fragile& other)
+			: value(other.value)
+		{
+			if (copies_left == 0)
+				throw std::runtime_error("copy failed");
+			--copies_left;
+		}
+
+		int value;
+	};
+
+	TEST(small_vector_test, initializer_list)
+	{
+		SmallVector<int, 4> vec{ 1, 2 };
+
+		EXPECT_EQ(vec[0], 1);
+		EXPECT_EQ(vec.size(), 2);
+		EXPECT_TRUE(vec.is_inline());
+	}
+
+	TEST(small_vector_test, capacity_starts_inline)
+	{
+		const SmallVector<int, 8> vec;
+
+		EXPECT_TRUE(vec.empty());
+		EXPECT_EQ(vec.capacity(), 8);
+		EXPECT_TRUE(vec.is_inline());
+	}
+
+	TEST(small_vector_test, push_back_spills_past_n)
+	{
+		SmallVector<int, 4> vec;
+		for (int i = 0; i < 4; ++i)
+			vec.push_back(i);
+
+		EXPECT_TRUE(vec.is_inline());
+
+		vec.push_back(4);
+		EXPECT_FALSE(vec.is_inline());
+		EXPECT_GE(vec.capacity(), 5);
+
+		for (int i = 0; i < 5; ++i)
+			EXPECT_EQ(vec[i], i);
+	}
+
+	TEST(small_vector_test, reserve)
+	{
+		SmallVector<int, 4> vec{ 1, 2 };
+
+		vec.reserve(3);
+		EXPECT_TRUE(vec.is_inline());
+
+		vec.reserve(10);
+		EXPECT_FALSE(vec.is_inline());
+		EXPECT_EQ(vec.capacity(), 10);
+		EXPECT_EQ(vec.at(1), 2);
+	}
+
+	TEST(small_vector_test, shrink_to_fit_moves_back_inline)
+	{
+		SmallVector<int, 4> vec{ 1, 2, 3, 4, 5, 6 };
+		EXPECT_FALSE(vec.is_inline());
+
+		vec.pop_back();
+		vec.pop_back();
+		vec.pop_back();
+		vec.shrink_to_fit();
+
+		EXPECT_TRUE(vec.is_inline());
+		EXPECT_EQ(vec.capacity(), 4);
+		EXPECT_EQ(vec.size(), 3);
+		EXPECT_EQ(vec.back(), 3);
+	}
+
+	TEST(small_vector_test, at)
+	{
+		SmallVector<int, 2> vec{ 1, 2 };
+
+		EXPECT_EQ(vec.at(1), 2);
+		EXPECT_THROW(vec.at(2), std::out_of_range);
+	}
+
+	TEST(small_vector_test, front_back)
+	{
+		const SmallVector<int, 2> vec{ 1, 2, 3 };
+
+		EXPECT_EQ(vec.front(), 1);
+		EXPECT_EQ(vec.back(), 3);
+	}
+
+	TEST(small_vector_test, iterators)
+	{
+		SmallVector<int, 4> vec{ 1, 2, 3 };
+
+		int sum = 0;
+		for (const auto value : vec)
+			sum += value;
+
+		EXPECT_EQ(sum, 6);
+		EXPECT_EQ(vec.end() - vec.begin(), 3);
+	}
+
+	TEST(small_vector_test, resize)
+	{
+		SmallVector<int, 2> vec{ 1 };
+
+		vec.resize(4, 7);
+		EXPECT_EQ(vec.size(), 4);
+		EXPECT_EQ(vec[3], 7);
+
+		vec.resize(1);
+		EXPECT_EQ(vec.size(), 1);
+		EXPECT_EQ(vec[0], 1);
+	}
+
+	TEST(small_vector_test, copy_constructor)
+	{
+		const SmallVector<int, 2> small{ 1, 2 };
+		const SmallVector<int, 2> large{ 1, 2, 3 };
+
+		SmallVector<int, 2> small_copy(small);
+		SmallVector<int, 2> large_copy(large);
+
+		EXPECT_TRUE(small_copy.is_inline());
+		EXPECT_EQ(small_copy.at(1), 2);
+		EXPECT_FALSE(large_copy.is_inline());
+		EXPECT_NE(large_copy.data(), large.data());
+		EXPECT_EQ(large_copy.at(2), 3);
+	}
+
+	TEST(small_vector_test, move_constructor_inline)
+	{
+		SmallVector<String, 2> vec{ "short", "a string long enough to live on the heap" };
+		SmallVector<String, 2> moved(std::move(vec));
+
+		EXPECT_TRUE(moved.is_inline());
+		EXPECT_EQ(moved.size(), 2);
+		EXPECT_EQ(moved[1], "a string long enough to live on the heap");
+		EXPECT_TRUE(vec.empty());
+	}
+
+	TEST(small_vector_test, move_constructor_steals_heap)
+	{
+		SmallVector<int, 2> vec{ 1, 2, 3 };
+		const auto data = vec.data();
+
+		SmallVector<int, 2> moved(std::move(vec));
+
+		EXPECT_EQ(moved.data(), data);
+		EXPECT_EQ(moved.at(2), 3);
+		EXPECT_TRUE(vec.empty());
+		EXPECT_TRUE(vec.is_inline());
+	}
+
+	TEST(small_vector_test, move_assignment)
+	{
+		SmallVector<int, 2> vec1{ 1, 2, 3 };
+		SmallVector<int, 2> vec2{ 4 };
+
+		vec2 = std::move(vec1);
+		EXPECT_EQ(vec2.size(), 3);
+		EXPECT_EQ(vec2.at(2), 3);
+
+		SmallVector<int, 2> vec3{ 5 };
+		vec2 = std::move(vec3);
+		EXPECT_TRUE(vec2.is_inline());
+		EXPECT_EQ(vec2.size(), 1);
+		EXPECT_EQ(vec2.at(0), 5);
+	}
+
+	TEST(small_vector_test, copy_assignment)
+	{
+		const SmallVector<int, 2> vec1{ 1, 2, 3 };
+		SmallVector<int, 2> vec2{ 4 };
+
+		vec2 = vec1;
+		EXPECT_EQ(vec2.size(), 3);
+		EXPECT_EQ(vec2.at(2), 3);
+	}
+
+	TEST(small_vector_test, swap_inline_and_heap)
+	{
+		SmallVector<int, 2> small{ 1 };
+		SmallVector<int, 2> large{ 2, 3, 4 };
+		const auto data = large.data();
+
+		small.swap(large);
+
+		EXPECT_EQ(small.data(), data);
+		EXPECT_EQ(small.size(), 3);
+		EXPECT_TRUE(large.is_inline());
+		EXPECT_EQ(large.size(), 1);
+		EXPECT_EQ(large[0], 1);
+	}
+
+	TEST(small_vector_test, elements_are_destroyed_once)
+	{
+		Tracked::reset();
+		{
+			SmallVector<Tracked, 2> vec;
+			for (int i = 0; i < 5; ++i)
+				vec.emplace_back(i);
+
+			SmallVector<Tracked, 2> moved(std::move(vec));
+			moved.pop_back();
+			moved.shrink_to_fit();
+		}
+
+		EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+	}
+
+	TEST(small_vector_test, push_back_own_element)
+	{
+		SmallVector<String, 2> vec{ "a string long enough to live on the heap", "b" };
+
+		vec.push_back(vec[0]);
+
+		EXPECT_EQ(vec.size(), 3);
+		EXPECT_EQ(vec[2], "a string long enough to live on the heap");
+	}
+
+	TEST(small_vector_test, resize_with_own_element)
+	{
+		SmallVector<String, 2> vec{ "a string long enough to live on the heap", "b", "c" };
+
+		vec.resize(10, vec[0]);
+
+		EXPECT_EQ(vec.size(), 10);
+		EXPECT_EQ(vec[9], "a string long enough to live on the heap");
+	}
+
+	TEST(small_vector_test, failed_growth_leaves_vector_unchanged)
+	{
+		SmallVector<Fragile, 2> vec;
+		for (int i = 0; i < 5; ++i)
+			vec.emplace_back(i);
+		vec.shrink_to_fit();
+
+		// The third copy throws.
+		Fragile::copies_left = 2;
+		EXPECT_THROW(vec.emplace_back(5), std::runtime_error);
+		Fragile::copies_left = 2;
+		EXPECT_THROW(vec.reserve(20), std::runtime_error);
+		Fragile::copies_left = -1;
+
+		ASSERT_EQ(vec.size(), 5);
+		EXPECT_EQ(vec.capacity(), 5);
+		for (int i = 0; i < 5; ++i)
+			EXPECT_EQ(vec[i].value, i);
+	}
+
+	TEST(small_vector_test, pmr_allocates_only_past_n)
+	{
+		std::byte buffer[1024];
+		std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+		pmr::SmallVector<int, 4> vec(&arena);
+		for (int i = 0; i < 4; ++i)
+			vec.push_back(i);
+
+		EXPECT_TRUE(vec.is_inline());
+
+		vec.push_back(4);
+		EXPECT_GE(reinterpret_cast<std::byte*>(vec.data()), buffer);
+		EXPECT_LT(reinterpret_cast<std::byte*>(vec.data()), buffer + sizeof(buffer));
+		EXPECT_EQ(vec.at(4), 4);
+	}
+}// namespace SmallVectorTests
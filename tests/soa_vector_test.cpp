@@ -0,0 +1,215 @@
+#include "../src/SoaVector.h"
+#include "../src/String.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace SoaVectorTests
+{
+	using namespace cpp;
+
+	using Particles = SoaVector<int, double, char>;
+
+	// Counts live instances, and can be told to throw on the n-th copy.
+	struct Tracked {
+		static inline int live = 0;
+		static inline int copies_until_throw = -1;
+
+		int value = 0;
+
+		Tracked(const int v = 0) : value(v)
+		{
+			++live;
+		}
+
+		Tracked(const Tracked& other) : value(other.value)
+		{
+			if (copies_until_throw == 0)
+				throw std::runtime_error("copy failed");
+			if (copies_until_throw > 0)
+				--copies_until_throw;
+			++live;
+		}
+
+		~Tracked()
+		{
+			--live;
+		}
+	};
+
+	TEST(soa_vector_test, push_back_and_access)
+	{
+		Particles particles;
+		EXPECT_TRUE(particles.empty());
+
+		for (int i = 0; i < 100; ++i)
+			particles.push_back(i, i * 0.5, static_cast<char>('a' + i % 26));
+
+		EXPECT_EQ(particles.size(), 100);
+		EXPECT_GE(particles.capacity(), 100);
+
+		const auto [id, x, tag] = particles[42];
+		EXPECT_EQ(id, 42);
+		EXPECT_EQ(x, 21.0);
+		EXPECT_EQ(tag, 'q');
+
+		EXPECT_EQ(std::get<0>(particles.front()), 0);
+		EXPECT_EQ(std::get<0>(particles.back()), 99);
+		EXPECT_THROW(particles.at(100), std::out_of_range);
+	}
+
+	TEST(soa_vector_test, columns_are_contiguous_and_aligned)
+	{
+		Particles particles;
+		for (int i = 0; i < 1000; ++i)
+			particles.emplace_back(i, 1.0, 'x');
+
+		auto ids = particles.column<0>();
+		auto xs = particles.column<1>();
+		EXPECT_EQ(ids.size(), 1000);
+		EXPECT_EQ(xs.size(), 1000);
+		EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), 0), 999 * 1000 / 2);
+
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(particles.data<0>()) % cache_line_size, 0);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(particles.data<1>()) % cache_line_size, 0);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(particles.data<2>()) % cache_line_size, 0);
+
+		for (auto& x : xs)
+			x *= 3;
+
+		EXPECT_EQ(std::get<1>(particles[500]), 3.0);
+	}
+
+	TEST(soa_vector_test, over_aligned_columns)
+	{
+		struct alignas(128) Wide {
+			int value;
+		};
+
+		// A column of one char still takes a whole block alignment, so the next column stays aligned.
+		SoaVector<char, Wide> rows;
+		rows.reserve(1);
+		rows.emplace_back('a', Wide{ 1 });
+
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(rows.data<1>()) % alignof(Wide), 0);
+		EXPECT_EQ(rows.data<1>()->value, 1);
+	}
+
+	TEST(soa_vector_test, rows_are_proxy_references)
+	{
+		Particles particles{ { 1, 1.0, 'a' }, { 2, 2.0, 'b' }, { 3, 3.0, 'c' } };
+
+		for (auto [id, x, tag] : particles)
+		{
+			id *= 10;
+			x += 0.5;
+		}
+
+		particles[2] = std::tuple{ 7, 7.5, 'z' };
+
+		const std::vector<int> expected{ 10, 20, 7 };
+		EXPECT_TRUE(std::ranges::equal(particles.column<0>(), expected));
+		EXPECT_EQ(particles[0], (std::tuple{ 10, 1.5, 'a' }));
+		EXPECT_EQ(particles[2], (std::tuple{ 7, 7.5, 'z' }));
+
+		const auto& view = particles;
+		const auto found = std::find_if(view.begin(), view.end(), [](const auto& row) { return std::get<2>(row) == 'b'; });
+		EXPECT_EQ(found - view.begin(), 1);
+		EXPECT_EQ(std::count_if(particles.begin(), particles.end(), [](const auto& row) { return std::get<1>(row) > 2.0; }), 2);
+	}
+
+	TEST(soa_vector_test, non_trivial_columns)
+	{
+		SoaVector<String, int> names;
+		for (int i = 0; i < 50; ++i)
+			names.emplace_back("a name long enough to live on the heap", i);
+
+		// Appending fields of the container itself must survive the columns moving.
+		for (int i = 0; i < 50; ++i)
+			names.push_back(std::get<0>(names[0]), std::get<1>(names[i]));
+
+		EXPECT_EQ(names.size(), 100);
+		for (const auto& [name, id] : names)
+			EXPECT_EQ(name, "a name long enough to live on the heap");
+
+		auto copy = names;
+		names.clear();
+		EXPECT_TRUE(names.empty());
+		EXPECT_EQ(copy.size(), 100);
+		EXPECT_EQ(std::get<1>(copy[99]), 49);
+
+		names = std::move(copy);
+		EXPECT_EQ(names.size(), 100);
+		EXPECT_TRUE(copy.empty());
+	}
+
+	TEST(soa_vector_test, resize_reserve_and_pop_back)
+	{
+		SoaVector<int, float> values;
+		values.resize(10);
+		EXPECT_EQ(values.size(), 10);
+		EXPECT_TRUE(std::ranges::all_of(values.column<0>(), [](int v) { return v == 0; }));
+
+		values.reserve(100);
+		EXPECT_EQ(values.capacity(), 100);
+		EXPECT_EQ(values.size(), 10);
+
+		values.pop_back();
+		values.resize(3);
+		EXPECT_EQ(values.size(), 3);
+
+		values.shrink_to_fit();
+		EXPECT_EQ(values.capacity(), 3);
+	}
+
+	TEST(soa_vector_test, failed_row_leaves_no_partial_row)
+	{
+		Tracked::live = 0;
+		{
+			SoaVector<Tracked, Tracked> rows;
+			rows.reserve(4);
+			rows.emplace_back(1, 2);
+
+			const Tracked first(3), second(4);
+			Tracked::copies_until_throw = 1;
+			EXPECT_THROW(rows.push_back(first, second), std::runtime_error);
+			Tracked::copies_until_throw = -1;
+
+			EXPECT_EQ(rows.size(), 1);
+			EXPECT_EQ(Tracked::live, 4);
+
+			Tracked::copies_until_throw = 1;
+			EXPECT_THROW(auto copy = rows, std::runtime_error);
+			Tracked::copies_until_throw = -1;
+			EXPECT_EQ(Tracked::live, 4);
+		}
+		EXPECT_EQ(Tracked::live, 0);
+	}
+
+	TEST(soa_vector_test, failed_growth_leaves_vector_unchanged)
+	{
+		Tracked::live = 0;
+		{
+			SoaVector<Tracked, Tracked> rows;
+			rows.reserve(3);
+			for (int i = 0; i < 3; ++i)
+				rows.emplace_back(i, -i);
+
+			// Tracked cannot be moved, so growing copies the first column, then throws in the second.
+			Tracked::copies_until_throw = 4;
+			EXPECT_THROW(rows.reserve(10), std::runtime_error);
+			Tracked::copies_until_throw = -1;
+
+			EXPECT_EQ(Tracked::live, 6);
+			EXPECT_EQ(rows.capacity(), 3);
+			ASSERT_EQ(rows.size(), 3);
+			for (int i = 0; i < 3; ++i)
+			{
+				EXPECT_EQ(std::get<0>(rows[i]).value, i);
+				EXPECT_EQ(std::get<1>(rows[i]).value, -i);
+			}
+		}
+		EXPECT_EQ(Tracked::live, 0);
+	}
+}// namespace SoaVectorTests
@@ -0,0 +1,116 @@
+#include "../src/SpscRing.h"
+#include "../src/String.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+
+namespace SpscRingTests
+{
+	using namespace cpp;
+
+	TEST(spsc_ring_test, push_pop)
+	{
+		SpscRing<int, 4> ring;
+		int value = 0;
+
+		EXPECT_FALSE(ring.try_pop(value));
+		EXPECT_TRUE(ring.try_push(1));
+		EXPECT_TRUE(ring.try_emplace(2));
+		EXPECT_EQ(ring.size_approx(), 2);
+
+		EXPECT_TRUE(ring.try_pop(value));
+		EXPECT_EQ(value, 1);
+		EXPECT_TRUE(ring.try_pop(value));
+		EXPECT_EQ(value, 2);
+		EXPECT_TRUE(ring.empty_approx());
+	}
+
+	TEST(spsc_ring_test, full)
+	{
+		SpscRing<int, 4> ring;
+		for (int i = 0; i < 4; ++i)
+			EXPECT_TRUE(ring.try_push(i));
+
+		EXPECT_FALSE(ring.try_push(4));
+
+		int value = 0;
+		EXPECT_TRUE(ring.try_pop(value));
+		EXPECT_TRUE(ring.try_push(4));
+	}
+
+	TEST(spsc_ring_test, batch_wraps_around)
+	{
+		SpscRing<int, 8> ring;
+		const int items[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		int out[10] = {};
+
+		EXPECT_EQ(ring.try_push_n(items, 6), 6);
+		EXPECT_EQ(ring.try_pop_n(out, 5), 5);
+
+		// The ring now holds one element at slot 5; seven more wrap around to slots 6, 7 and 0 to 3.
+		EXPECT_EQ(ring.try_push_n(items + 6, 4), 4);
+		EXPECT_EQ(ring.try_push_n(items, 10), 3);
+		EXPECT_EQ(ring.size_approx(), 8);
+
+		EXPECT_EQ(ring.try_pop_n(out, 10), 8);
+		const int expected[] = { 5, 6, 7, 8, 9, 0, 1, 2 };
+		for (int i = 0; i < 8; ++i)
+			EXPECT_EQ(out[i], expected[i]);
+
+		EXPECT_EQ(ring.try_pop_n(out, 10), 0);
+	}
+
+	TEST(spsc_ring_test, moves_elements)
+	{
+		SpscRing<String, 2> ring;
+		String str = "a string long enough to live on the heap";
+		const auto data = str.data();
+
+		EXPECT_TRUE(ring.try_push(std::move(str)));
+
+		String out;
+		EXPECT_TRUE(ring.try_pop(out));
+		EXPECT_EQ(out.data(), data);
+	}
+
+	TEST(spsc_ring_test, two_threads_keep_order)
+	{
+		constexpr size_t count = 1000000;
+		SpscRing<size_t, 1024> ring;
+
+		std::thread producer([&ring] {
+			size_t next = 0;
+			size_t batch[16];
+
+			while (next < count)
+			{
+				if (next % 3 == 0)
+				{
+					if (ring.try_push(next))
+						++next;
+					continue;
+				}
+
+				const auto n = std::min<size_t>(16, count - next);
+				for (size_t i = 0; i < n; ++i)
+					batch[i] = next + i;
+				next += ring.try_push_n(batch, n);
+			}
+		});
+
+		size_t expected = 0;
+		size_t batch[32];
+		bool in_order = true;
+
+		while (expected < count)
+		{
+			const auto n = ring.try_pop_n(batch, 32);
+			for (size_t i = 0; i < n; ++i)
+				in_order &= batch[i] == expected++;
+		}
+
+		producer.join();
+		EXPECT_TRUE(in_order);
+		EXPECT_TRUE(ring.empty_approx());
+	}
+}// namespace SpscRingTests
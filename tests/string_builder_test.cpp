@@ -0,0 +1,68 @@
+#include "../src/StringBuilder.h"
+#include "gtest/gtest.h"
+
+namespace StringBuilderTests
+{
+	using namespace cpp;
+	TEST(string_builder_test, append_pieces)
+	{
+		StringBuilder builder;
+		builder.append("key").append('=').append(String("value")).append(2, '!');
+
+		EXPECT_STREQ(builder.c_str(), "key=value!!");
+		EXPECT_EQ(builder.size(), 11);
+	}
+
+	TEST(string_builder_test, stream_numbers)
+	{
+		StringBuilder builder;
+		builder << "id=" << 42 << " delta=" << -7L << " max=" << std::numeric_limits<uint64_t>::max();
+
+		EXPECT_STREQ(builder.c_str(), "id=42 delta=-7 max=18446744073709551615");
+	}
+
+	TEST(string_builder_test, stream_bools_and_floating_point)
+	{
+		StringBuilder builder;
+		builder << 3.9 << ' ' << true << ' ' << false << ' ' << -0.5f << ' ' << 1e300 << ' ' << 'c';
+
+		EXPECT_STREQ(builder.c_str(), "3.9 true false -0.5 1e+300 c");
+	}
+
+	TEST(string_builder_test, release_keeps_buffer)
+	{
+		StringBuilder builder(64);
+		builder << "a string that does not fit into the object";
+		const auto buffer = builder.c_str();
+
+		const String str = builder.release();
+		EXPECT_EQ(str.c_str(), buffer);
+		EXPECT_STREQ(str.c_str(), "a string that does not fit into the object");
+		EXPECT_EQ(builder.size(), 0);
+	}
+
+	TEST(string_builder_test, reserve)
+	{
+		StringBuilder builder;
+		builder.reserve(1000);
+		const auto capacity = builder.capacity();
+
+		for (int i = 0; i < 100; ++i)
+			builder << "0123456789";
+
+		EXPECT_EQ(builder.capacity(), capacity);
+		EXPECT_EQ(builder.size(), 1000);
+	}
+
+	TEST(string_builder_test, clear)
+	{
+		StringBuilder builder;
+		builder << "a string that does not fit into the object";
+		const auto capacity = builder.capacity();
+
+		builder.clear();
+		EXPECT_EQ(builder.size(), 0);
+		EXPECT_EQ(builder.capacity(), capacity);
+		EXPECT_STREQ(builder.c_str(), "");
+	}
+}// namespace StringBuilderTests
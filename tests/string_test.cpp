@@ -4,6 +4,43 @@
 namespace StringTests
 {
 	using namespace cpp;
+	// Runs a string through the inline and the heap representation during constant evaluation.
+	constexpr bool constexpr_string_round_trip()
+	{
+		String s("hello");
+		s.append(", world");
+		const bool inline_before = !s.is_heap();
+
+		s.append(" and a tail long enough to move to the heap");
+		s.push_back('!');
+		const bool heap_after = s.is_heap();
+
+		String copy = s.substr(0, 5);
+		s.resize(5);
+		s.shrink_to_fit();
+
+		return inline_before && heap_after && !s.is_heap() && s == copy && s == "hello" && (s + copy).size() == 10;
+	}
+
+	// Builds a keyword list into one space-separated string at compile time and returns its length.
+	constexpr size_t constexpr_joined_length()
+	{
+		constexpr const char* words[]{ "alignas", "constexpr", "consteval", "constinit", "decltype", "noexcept" };
+
+		String joined;
+		for (const auto word : words)
+		{
+			if (!joined.empty())
+				joined.push_back(' ');
+			joined.append(word);
+		}
+
+		return joined.size();
+	}
+
+	static_assert(constexpr_string_round_trip());
+	static_assert(constexpr_joined_length() == 55);
+
 	TEST(StringTest, CstrConstructor)
 	{
 		constexpr auto test = "Hello World!";
@@ -79,6 +116,44 @@ namespace StringTests
 		str.append(3, 'c');
 		EXPECT_STREQ(str.c_str(), "Heccc");
 	}
+	TEST(StringTest, pushBack)
+	{
+		String str = "He";
+		str.push_back('y');
+		EXPECT_STREQ(str.c_str(), "Hey");
+	}
+	TEST(StringTest, pushBackGrowsGeometrically)
+	{
+		String str;
+		size_t reallocations = 0;
+		auto capacity = str.capacity();
+
+		for (size_t i = 0; i < (1 << 20); ++i)
+		{
+			str.push_back(static_cast<char>('a' + i % 26));
+			if (str.capacity() != capacity)
+			{
+				++reallocations;
+				capacity = str.capacity();
+			}
+		}
+
+		EXPECT_EQ(str.size(), 1 << 20);
+		EXPECT_EQ(str[(1 << 20) - 1], 'a' + ((1 << 20) - 1) % 26);
+		EXPECT_LE(reallocations, 20);
+	}
+	TEST(StringTest, appendUsesSpareCapacity)
+	{
+		String str;
+		str.reserve(100);
+		const auto buffer = str.c_str();
+
+		for (int i = 0; i < 10; ++i)
+			str.append("0123456789");
+
+		EXPECT_EQ(str.c_str(), buffer);
+		EXPECT_EQ(str.size(), 100);
+	}
 	TEST(StringTest, empty)
 	{
 		String str;
@@ -97,7 +172,10 @@ namespace StringTests
 	{
 		String str;
 		str.reserve(2);
-		EXPECT_EQ(2, str.capacity());
+		EXPECT_EQ(String::sso_capacity, str.capacity());
+
+		str.reserve(100);
+		EXPECT_EQ(100, str.capacity());
 	}
 	TEST(StringTest, size)
 	{
@@ -118,6 +196,150 @@ namespace StringTests
 		str = "100";
 		EXPECT_EQ(str.capacity(), 100);
 		str.shrink_to_fit();
-		EXPECT_EQ(str.capacity(), 4);
+		EXPECT_EQ(str.capacity(), String::sso_capacity);
+		EXPECT_FALSE(str.is_heap());
+		EXPECT_STREQ(str.c_str(), "100");
+	}
+	TEST(StringTest, shortStringIsInline)
+	{
+		const String empty;
+		const String str = "ok";
+
+		EXPECT_FALSE(empty.is_heap());
+		EXPECT_STREQ(empty.c_str(), "");
+		EXPECT_FALSE(str.is_heap());
+		EXPECT_EQ(sizeof(String), 4 * sizeof(void*));
+	}
+	TEST(StringTest, longStringIsOnHeap)
+	{
+		const String str = "a string that does not fit into the object";
+		EXPECT_TRUE(str.is_heap());
+		EXPECT_EQ(str.size(), 42);
+	}
+	TEST(StringTest, appendSwitchesToHeap)
+	{
+		String str = "0123456789";
+		str.append("0123456789");
+		EXPECT_FALSE(str.is_heap());
+
+		str.append("0123456789");
+		EXPECT_TRUE(str.is_heap());
+		EXPECT_STREQ(str.c_str(), "012345678901234567890123456789");
+
+		str.append(str);
+		EXPECT_EQ(str.size(), 60);
+		EXPECT_STREQ(str.c_str() + 30, "012345678901234567890123456789");
+	}
+	TEST(StringTest, copyAndMoveKeepLayout)
+	{
+		String shortStr = "short";
+		String longStr = "a string that does not fit into the object";
+
+		const String shortCopy = shortStr;
+		const String longCopy = longStr;
+		EXPECT_FALSE(shortCopy.is_heap());
+		EXPECT_TRUE(longCopy.is_heap());
+		EXPECT_NE(longCopy.c_str(), longStr.c_str());
+
+		const String shortMoved = std::move(shortStr);
+		const String longMoved = std::move(longStr);
+		EXPECT_STREQ(shortMoved.c_str(), "short");
+		EXPECT_STREQ(longMoved.c_str(), longCopy.c_str());
+		EXPECT_TRUE(shortStr.empty());
+		EXPECT_TRUE(longStr.empty());
+	}
+	TEST(StringTest, substrAndPlusSwitchLayout)
+	{
+		const String str = "a string that does not fit into the object";
+		const auto word = str.substr(2, 6);
+		EXPECT_FALSE(word.is_heap());
+		EXPECT_STREQ(word.c_str(), "string");
+
+		const auto sum = word + " " + word + " " + word + " " + word;
+		EXPECT_TRUE(sum.is_heap());
+		EXPECT_STREQ(sum.c_str(), "string string string string");
+	}
+	TEST(StringTest, pmrAllocatesFromResource)
+	{
+		char buffer[256];
+		std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+		pmr::String str("Hello World!", &arena);
+		str.append(" This no longer fits into the object.");
+
+		EXPECT_STREQ(str.c_str(), "Hello World! This no longer fits into the object.");
+		EXPECT_GE(str.c_str(), buffer);
+		EXPECT_LT(str.c_str(), buffer + sizeof(buffer));
+	}
+	TEST(StringTest, pmrSubstrKeepsResource)
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		const pmr::String str("Hello World!", &arena);
+		const auto sub = str.substr(6);
+
+		EXPECT_STREQ(sub.c_str(), "World!");
+		EXPECT_EQ(sub.get_allocator().resource(), &arena);
+	}
+	TEST(StringTest, find)
+	{
+		const String str = "GET /index.html HTTP/1.1 GET /favicon.ico HTTP/1.1";
+
+		EXPECT_EQ(str.find("GET"), 0);
+		EXPECT_EQ(str.find("GET", 1), 25);
+		EXPECT_EQ(str.find(String("HTTP")), 16);
+		EXPECT_EQ(str.find("HTTP/2"), String::npos);
+		EXPECT_EQ(str.find("HTTP/2", 0, 4), 16);
+		EXPECT_EQ(str.find('/', 5), 20);
+		EXPECT_EQ(str.find("GET", 100), String::npos);
+	}
+	TEST(StringTest, rfind)
+	{
+		const String str = "GET /index.html HTTP/1.1 GET /favicon.ico HTTP/1.1";
+
+		EXPECT_EQ(str.rfind("GET"), 25);
+		EXPECT_EQ(str.rfind("GET", 24), 0);
+		EXPECT_EQ(str.rfind('/'), 46);
+		EXPECT_EQ(str.rfind('/', 45), 29);
+		EXPECT_EQ(str.rfind("POST"), String::npos);
+	}
+	TEST(StringTest, findFirstAndLastOf)
+	{
+		const String str = "key=value; other=thing";
+
+		EXPECT_EQ(str.find_first_of("=;"), 3);
+		EXPECT_EQ(str.find_first_of("=;", 4), 9);
+		EXPECT_EQ(str.find_last_of("=;"), 16);
+		EXPECT_EQ(str.find_last_of("=;", 15), 9);
+		EXPECT_EQ(str.find_first_of("!?"), String::npos);
+	}
+	TEST(StringTest, count)
+	{
+		const String str = "a,b,,c,d";
+
+		EXPECT_EQ(str.count(','), 4);
+		EXPECT_EQ(str.count(",,"), 1);
+		EXPECT_EQ(str.count(String("x")), 0);
+	}
+	TEST(StringTest, viewDoesNotCopy)
+	{
+		const String str = "GET /index.html HTTP/1.1 with a long enough tail";
+		const auto path = str.view(4, 11);
+
+		EXPECT_EQ(path.data(), str.data() + 4);
+		EXPECT_EQ(path, "/index.html");
+		EXPECT_TRUE(str.view(100).empty());
+	}
+	TEST(StringTest, viewOverloads)
+	{
+		const String line = "key=value";
+		const auto key = line.view(0, 3);
+
+		String str(key);
+		str.append(line.view(3));
+
+		EXPECT_EQ(str, line.view());
+		EXPECT_EQ(line.view(), str);
+		EXPECT_EQ(line.find(StringView("val")), 4);
+		EXPECT_EQ(str + StringView("!"), "key=value!");
 	}
 }// namespace StringTests
@@ -0,0 +1,74 @@
+#include "../src/StringView.h"
+#include "gtest/gtest.h"
+
+namespace StringViewTests
+{
+	using namespace cpp;
+	TEST(StringViewTest, construct)
+	{
+		constexpr StringView empty;
+		constexpr StringView hello = "Hello World!";
+
+		static_assert(empty.empty());
+		static_assert(hello.size() == 12);
+		EXPECT_EQ(hello.front(), 'H');
+		EXPECT_EQ(hello.back(), '!');
+		EXPECT_EQ(StringView(std::string_view("abc")), "abc");
+	}
+	TEST(StringViewTest, at)
+	{
+		const StringView sv = "abc";
+
+		EXPECT_EQ(sv.at(2), 'c');
+		EXPECT_THROW((void) sv.at(3), std::out_of_range);
+	}
+	TEST(StringViewTest, substr)
+	{
+		const StringView sv = "Hello World!";
+
+		EXPECT_EQ(sv.substr(6, 5), "World");
+		EXPECT_EQ(sv.substr(6).data(), sv.data() + 6);
+		EXPECT_EQ(sv.substr(6, 100), "World!");
+		EXPECT_TRUE(sv.substr(13).empty());
+	}
+	TEST(StringViewTest, removePrefixAndSuffix)
+	{
+		StringView sv = "  trimmed  ";
+		sv.remove_prefix(2);
+		sv.remove_suffix(2);
+
+		EXPECT_EQ(sv, "trimmed");
+	}
+	TEST(StringViewTest, compare)
+	{
+		static_assert(StringView("abc") == StringView("abc"));
+		static_assert(StringView("abc") < StringView("abd"));
+		static_assert(StringView("ab") < StringView("abc"));
+
+		EXPECT_EQ(StringView("b").compare("a"), 1);
+		EXPECT_EQ(StringView("a").compare("a"), 0);
+		EXPECT_TRUE(StringView("key=value").starts_with("key"));
+		EXPECT_TRUE(StringView("key=value").ends_with("value"));
+		EXPECT_FALSE(StringView("key").ends_with("a key"));
+	}
+	TEST(StringViewTest, find)
+	{
+		const StringView sv = "GET /index.html HTTP/1.1 GET /favicon.ico HTTP/1.1";
+
+		EXPECT_EQ(sv.find("GET", 1), 25);
+		EXPECT_EQ(sv.find('/', 5), 20);
+		EXPECT_EQ(sv.rfind("HTTP"), 42);
+		EXPECT_EQ(sv.rfind('G', 24), 0);
+		EXPECT_EQ(sv.find_first_of(". "), 3);
+		EXPECT_EQ(sv.find_last_of(". "), 48);
+		EXPECT_EQ(sv.count("HTTP"), 2);
+		EXPECT_EQ(sv.count('/'), 4);
+		EXPECT_EQ(sv.find("POST"), StringView::npos);
+	}
+	TEST(StringViewTest, iterators)
+	{
+		const StringView sv = "abc";
+
+		EXPECT_EQ(std::string(sv.begin(), sv.end()), "abc");
+	}
+}// namespace StringViewTests
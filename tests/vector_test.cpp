@@ -1,9 +1,113 @@
 #include "../src/Vector.h"
 #include "gtest/gtest.h"
 
+#include <array>
+#include <list>
+#include <numeric>
+#include <sstream>
+
 namespace VectorTests
 {
 	using namespace cpp;
+
+	// Counts the constructor and destructor calls made on it, to check what the container runs.
+	struct Tracked {
+		static inline int constructed = 0;
+		static inline int destroyed = 0;
+
+		static void reset()
+		{
+			constructed = destroyed = 0;
+		}
+
+		explicit Tracked(int v)
+			: value(v)
+		{
+			++constructed;
+		}
+
+		Tracked(const Tracked& other)
+			: value(other.value)
+		{
+			++constructed;
+		}
+
+		Tracked(Tracked&& other) noexcept
+			: value(other.value)
+		{
+			++constructed;
+		}
+
+		~Tracked()
+		{
+			++destroyed;
+		}
+
+		int value;
+	};
+
+	// Throws on copy once copies_left reaches zero. Moves never throw.
+	struct Fragile {
+		static inline int copies_left = -1;
+
+		Fragile(const int v)
+			: value(v)
+		{
+		}
+
+		Fragile(const Fragile& other)
+			: value(other.value)
+		{
+			if (copies_left == 0)
+				throw std::runtime_error("copy failed");
+			--copies_left;
+		}
+
+		Fragile(Fragile&& other) noexcept
+			: value(other.value)
+		{
+		}
+
+		int value;
+	};
+
+	// A Fragile without a move constructor, so that the vector has to copy it when it grows.
+	struct CopyOnlyFragile : Fragile {
+		using Fragile::Fragile;
+
+		CopyOnlyFragile(const CopyOnlyFragile&) = default;
+	};
+
+	// Exercises growth, insertion, erasure and copies during constant evaluation, where every
+	// allocation must be released before the evaluation ends.
+	constexpr int constexpr_sum_of_squares(const int n)
+	{
+		Vector<int> vec;
+		for (int i = 0; i < n; ++i)
+			vec.push_back(i * i);
+
+		vec.insert(vec.begin(), { -1, -2 });
+		vec.erase(vec.begin(), vec.begin() + 2);
+
+		const Vector<int> copy = vec;
+		return std::accumulate(copy.begin(), copy.end(), 0);
+	}
+
+	// A lookup table computed with a Vector at compile time and stored in an array.
+	constexpr auto primes = [] {
+		Vector<int> found;
+		for (int candidate = 2; found.size() < 10; ++candidate)
+			if (std::none_of(found.begin(), found.end(), [&](int p) { return candidate % p == 0; }))
+				found.push_back(candidate);
+
+		std::array<int, 10> table{};
+		std::copy(found.begin(), found.end(), table.begin());
+		return table;
+	}();
+
+	static_assert(constexpr_sum_of_squares(10) == 285);
+	static_assert(primes.back() == 29);
+
 	TEST(vector_test, initializer_list)
 	{
 		Vector<int> vec{ 1, 2 };
@@ -179,10 +283,279 @@ namespace VectorTests
 		EXPECT_EQ(vec.at(0), 1);
 	}
 
+	TEST(vector_test, reserve_constructs_nothing)
+	{
+		Tracked::reset();
+		{
+			Vector<Tracked> vec(16);
+			vec.reserve(64);
+			EXPECT_EQ(Tracked::constructed, 0);
+
+			vec.emplace_back(7);
+			EXPECT_EQ(Tracked::constructed, 1);
+			EXPECT_EQ(vec[0].value, 7);
+		}
+		EXPECT_EQ(Tracked::destroyed, 1);
+	}
+
+	TEST(vector_test, growth_destroys_only_live_elements)
+	{
+		Tracked::reset();
+		{
+			Vector<Tracked> vec;
+			for (int i = 0; i < 10; ++i)
+				vec.emplace_back(i);
+
+			vec.pop_back();
+			EXPECT_EQ(vec.size(), 9);
+			EXPECT_EQ(vec.back().value, 8);
+		}
+		EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+	}
+
+	TEST(vector_test, push_back_own_element)
+	{
+		Vector<Vector<int>> vec{ Vector<int>{ 1, 2, 3 } };
+		EXPECT_EQ(vec.capacity(), 1);
+
+		vec.push_back(vec[0]);
+		EXPECT_EQ(vec.size(), 2);
+		EXPECT_EQ(vec[1].size(), 3);
+		EXPECT_EQ(vec[0].at(2), 3);
+		EXPECT_EQ(vec[1].at(2), 3);
+	}
+
 	TEST(vector_test, copy_assignment)
 	{
 		Vector<int> vec1{ 1, 2, 3 };
 		Vector<int> vec2 = vec1;
 		EXPECT_EQ(vec2.at(0), vec1.at(0));
 	}
+
+	TEST(vector_test, copy_assignment_existing)
+	{
+		const Vector<int> vec1{ 1, 2, 3 };
+		Vector<int> vec2{ 4 };
+		vec2 = vec1;
+		EXPECT_EQ(vec2.size(), 3);
+		EXPECT_EQ(vec2.at(2), 3);
+	}
+
+	TEST(vector_test, pmr_allocates_from_resource)
+	{
+		std::byte buffer[1024];
+		std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+		pmr::Vector<int> vec(&arena);
+		for (int i = 0; i < 100; ++i)
+			vec.push_back(i);
+
+		EXPECT_EQ(vec.get_allocator().resource(), &arena);
+		EXPECT_GE(reinterpret_cast<std::byte*>(vec.data()), buffer);
+		EXPECT_LT(reinterpret_cast<std::byte*>(vec.data()), buffer + sizeof(buffer));
+		EXPECT_EQ(vec.at(99), 99);
+	}
+
+	TEST(vector_test, pmr_propagates_resource_to_elements)
+	{
+		std::pmr::monotonic_buffer_resource arena;
+
+		pmr::Vector<pmr::Vector<int>> vec(&arena);
+		vec.emplace_back(std::initializer_list<int>{ 1, 2, 3 });
+
+		EXPECT_EQ(vec[0].get_allocator().resource(), &arena);
+		EXPECT_EQ(vec[0].at(2), 3);
+	}
+
+	TEST(vector_test, pmr_move_assignment_between_resources)
+	{
+		std::pmr::monotonic_buffer_resource arena1;
+		std::pmr::monotonic_buffer_resource arena2;
+
+		pmr::Vector<int> vec1({ 1, 2, 3 }, &arena1);
+		pmr::Vector<int> vec2(&arena2);
+		vec2 = std::move(vec1);
+
+		EXPECT_EQ(vec2.get_allocator().resource(), &arena2);
+		EXPECT_EQ(vec2.size(), 3);
+		EXPECT_EQ(vec2.at(2), 3);
+	}
+	TEST(vector_test, insert_and_emplace)
+	{
+		Vector<int> vec{ 1, 5 };
+		auto it = vec.insert(vec.begin() + 1, 4);
+		EXPECT_EQ(*it, 4);
+
+		vec.insert(vec.begin() + 1, 2, 3);
+		vec.emplace(vec.begin(), 0);
+		vec.emplace(vec.end(), 6);
+		vec.insert(vec.begin() + 2, vec[0]);
+
+		const Vector<int> expected{ 0, 1, 0, 3, 3, 4, 5, 6 };
+		EXPECT_TRUE(std::ranges::equal(vec, expected));
+	}
+
+	TEST(vector_test, insert_own_element_while_growing)
+	{
+		Vector<Vector<int>> vec{ Vector<int>{ 1, 2, 3 }, Vector<int>{ 4 } };
+		vec.insert(vec.begin(), vec[1]);
+		vec.insert(vec.begin(), 3, vec[2]);
+
+		EXPECT_EQ(vec.size(), 6);
+		EXPECT_EQ(vec[0].size(), 1);
+		EXPECT_EQ(vec[3].at(0), 4);
+		EXPECT_EQ(vec[4].at(2), 3);
+		EXPECT_EQ(vec[5].at(0), 4);
+	}
+
+	TEST(vector_test, insert_ranges)
+	{
+		Vector<int> vec{ 1, 6 };
+		const std::list<int> middle{ 3, 4, 5 };
+		const int front[]{ -1, 0 };
+
+		vec.insert(vec.begin() + 1, middle.begin(), middle.end());
+		vec.insert_range(vec.begin(), front);
+		vec.insert(vec.begin() + 3, { 2 });
+
+		// An input range is consumed once, without knowing its size in advance.
+		std::istringstream words("7 8 9");
+		vec.insert_range(vec.end(), std::ranges::subrange(std::istream_iterator<int>(words), std::istream_iterator<int>()));
+
+		Vector<int> expected(0);
+		for (int i = -1; i < 10; ++i)
+			expected.push_back(i);
+
+		EXPECT_TRUE(std::ranges::equal(vec, expected));
+	}
+
+	TEST(vector_test, erase)
+	{
+		Vector<int> vec{ 0, 1, 2, 3, 4, 5, 6 };
+
+		auto it = vec.erase(vec.begin() + 1);
+		EXPECT_EQ(*it, 2);
+
+		it = vec.erase(vec.begin() + 2, vec.begin() + 5);
+		EXPECT_EQ(*it, 6);
+		it = vec.erase(vec.end() - 1);
+		EXPECT_EQ(it, vec.end());
+
+		const Vector<int> expected{ 0, 2 };
+		EXPECT_TRUE(std::ranges::equal(vec, expected));
+	}
+
+	TEST(vector_test, shifts_of_non_trivial_elements_balance)
+	{
+		Tracked::reset();
+		{
+			Vector<Tracked> vec;
+			for (int i = 0; i < 10; ++i)
+				vec.emplace_back(i);
+
+			vec.emplace(vec.begin() + 3, 100);
+			vec.insert(vec.begin(), 5, Tracked(-1));
+			vec.erase(vec.begin() + 1, vec.begin() + 6);
+
+			std::vector<int> values;
+			for (const auto& e : vec)
+				values.push_back(e.value);
+
+			const std::vector<int> expected{ -1, 1, 2, 100, 3, 4, 5, 6, 7, 8, 9 };
+			EXPECT_EQ(values, expected);
+		}
+		EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+	}
+
+	TEST(vector_test, failed_insert_leaves_vector_unchanged)
+	{
+		Vector<Fragile> vec;
+		vec.reserve(10);
+		for (int i = 0; i < 4; ++i)
+			vec.emplace_back(i);
+
+		const Fragile source[]{ 10, 11, 12 };
+		Fragile::copies_left = 2;
+		EXPECT_THROW(vec.insert_range(vec.begin() + 1, source), std::runtime_error);
+		Fragile::copies_left = -1;
+
+		ASSERT_EQ(vec.size(), 4);
+		for (int i = 0; i < 4; ++i)
+			EXPECT_EQ(vec[i].value, i);
+	}
+
+	TEST(vector_test, failed_growth_leaves_vector_unchanged)
+	{
+		Vector<CopyOnlyFragile> vec;
+		for (int i = 0; i < 7; ++i)
+			vec.emplace_back(i);
+		vec.shrink_to_fit();
+
+		// Growing copies the elements, and the third copy throws.
+		Fragile::copies_left = 2;
+		EXPECT_THROW(vec.emplace_back(7), std::runtime_error);
+		Fragile::copies_left = 2;
+		EXPECT_THROW(vec.insert(vec.begin() + 3, 2, CopyOnlyFragile(-1)), std::runtime_error);
+		Fragile::copies_left = 2;
+		EXPECT_THROW(vec.reserve(20), std::runtime_error);
+		Fragile::copies_left = -1;
+
+		ASSERT_EQ(vec.size(), 7);
+		EXPECT_EQ(vec.capacity(), 7);
+		for (int i = 0; i < 7; ++i)
+			EXPECT_EQ(vec[i].value, i);
+	}
+
+	TEST(vector_test, resize_with_own_element)
+	{
+		Tracked::reset();
+		{
+			Vector<Tracked> vec;
+			vec.emplace_back(42);
+
+			vec.resize(20, vec[0]);
+			ASSERT_EQ(vec.size(), 20);
+			for (const auto& e : vec)
+				EXPECT_EQ(e.value, 42);
+		}
+		EXPECT_EQ(Tracked::constructed, Tracked::destroyed);
+	}
+
+	TEST(vector_test, assign)
+	{
+		Vector<int> vec{ 1, 2, 3 };
+
+		vec.assign(5, 7);
+		EXPECT_EQ(vec.size(), 5);
+		EXPECT_EQ(vec[4], 7);
+
+		vec.assign({ 4, 5 });
+		EXPECT_EQ(vec.size(), 2);
+		EXPECT_EQ(vec[1], 5);
+
+		const std::list<int> values{ 8, 9, 10 };
+		vec.assign(values.begin(), values.end());
+		const Vector<int> expected{ 8, 9, 10 };
+		EXPECT_TRUE(std::ranges::equal(vec, expected));
+
+		vec.assign(2, vec[0]);
+		EXPECT_EQ(vec.size(), 2);
+		EXPECT_EQ(vec[1], 8);
+	}
+
+	TEST(vector_test, append_range_grows_once)
+	{
+		std::vector<int> values(1'000'000);
+		std::iota(values.begin(), values.end(), 0);
+
+		Vector<int> vec;
+		vec.append_range(values);
+		EXPECT_EQ(vec.size(), values.size());
+		EXPECT_EQ(vec.capacity(), values.size());
+
+		vec.append_range(std::views::iota(0, 10));
+		EXPECT_EQ(vec.size(), values.size() + 10);
+		EXPECT_EQ(vec[999'999], 999'999);
+		EXPECT_EQ(vec.back(), 9);
+	}
 }// namespace VectorTests
@@ -0,0 +1,49 @@
+#include "../src/Array.h"
+#include "../src/Vector.h"
+#include "../src/VectorView.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+
+namespace VectorViewTests
+{
+	using namespace cpp;
+
+	static_assert(std::contiguous_iterator<VectorView<int>::ConstIt>);
+
+	TEST(vector_view_test, views_containers)
+	{
+		const Vector<int> vec{ 1, 2, 3, 4 };
+		const VectorView<int> view = vec;
+
+		EXPECT_EQ(view.data(), vec.data());
+		EXPECT_EQ(view.size(), 4);
+		EXPECT_EQ(view.front(), 1);
+		EXPECT_EQ(view.back(), 4);
+		EXPECT_EQ(view[2], 3);
+		EXPECT_THROW((void) view.at(4), std::out_of_range);
+		EXPECT_EQ(std::accumulate(view.begin(), view.end(), 0), 10);
+
+		Array<double, 3> arr;
+		arr[0] = 0.5;
+		const VectorView<double> array_view(arr);
+		EXPECT_EQ(array_view.size(), 3);
+		EXPECT_EQ(array_view[0], 0.5);
+	}
+
+	TEST(vector_view_test, subview)
+	{
+		const int values[] = { 0, 1, 2, 3, 4, 5 };
+		const VectorView<int> view(values, 6);
+
+		const auto middle = view.subview(2, 3);
+		EXPECT_EQ(middle.size(), 3);
+		EXPECT_EQ(middle.front(), 2);
+		EXPECT_EQ(middle.back(), 4);
+
+		EXPECT_EQ(view.subview(4).size(), 2);
+		EXPECT_TRUE(view.subview(6).empty());
+		EXPECT_TRUE(view.subview(7).empty());
+		EXPECT_TRUE(VectorView<int>().empty());
+	}
+}// namespace VectorViewTests